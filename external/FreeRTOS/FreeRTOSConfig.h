@@ -58,7 +58,7 @@
 #define configTICK_TYPE_WIDTH_IN_BITS             TICK_TYPE_WIDTH_16_BITS
 #define configUSE_TASK_NOTIFICATIONS              1
 #define configTASK_NOTIFICATION_ARRAY_ENTRIES     3
-#define configUSE_MUTEXES                         0
+#define configUSE_MUTEXES                         1
 #define configUSE_RECURSIVE_MUTEXES               0
 #define configUSE_ALTERNATIVE_API                 0 /* Deprecated! */
 #define configUSE_QUEUE_SETS                      0
@@ -81,16 +81,22 @@
 /* Hook function related definitions. */
 #define configUSE_IDLE_HOOK                       0
 #define configUSE_TICK_HOOK                       1
-#define configCHECK_FOR_STACK_OVERFLOW            0
+#define configCHECK_FOR_STACK_OVERFLOW            2
 #define configUSE_MALLOC_FAILED_HOOK              0
 #define configUSE_DAEMON_TASK_STARTUP_HOOK        0
 #define configUSE_SB_COMPLETED_CALLBACK           0
 
 /* Run time and task stats gathering related definitions. */
-#define configGENERATE_RUN_TIME_STATS             0
+#define configGENERATE_RUN_TIME_STATS             1
 #define configUSE_TRACE_FACILITY                  1
 #define configUSE_STATS_FORMATTING_FUNCTIONS      0
 
+/* Run time stats clock (free-running 80 [MHz] hardware timer); defined in main_rtos.c. */
+void vConfigureTimerForRunTimeStats( void );
+uint32_t ulGetRunTimeCounterValue( void );
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()  vConfigureTimerForRunTimeStats()
+#define portGET_RUN_TIME_COUNTER_VALUE()          ulGetRunTimeCounterValue()
+
 /* Co-routine related definitions. */
 #define configUSE_CO_ROUTINES                     0
 #define configMAX_CO_ROUTINE_PRIORITIES           1
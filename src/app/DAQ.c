@@ -25,18 +25,21 @@ Preprocessor Directives
 #include "ADC.h"
 #include "Timer.h"
 
+#include "Filter_q31.h"
 #include "NewAssert.h"
 
 #include "arm_math_types.h"
 #include "dsp/filtering_functions.h"
-#include "tm4c123gh6pm.h"
 
 #include <math.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 
 #define SAMPLING_PERIOD_MS 5               ///< sampling period in ms (\f$ T_s = \frac{1}{f_s} \f$)
 
+#define ADC_MAX            0xFFF           ///< ADC output corresponding to \f$ 5.5 [mV] \f$
+
 /******************************************************************************
 Digital Filter Variables
 *******************************************************************************/
@@ -138,6 +141,44 @@ static const float32_t COEFFS_BANDPASS[NUM_COEFFS_DAQ_BANDPASS] = {
     // Section 4
     1.0f, -1.9997893571853638f, 1.0f, 
     1.994096040725708f, -0.9943605065345764f, 
+};
+
+/// @brief  `q31_t` version of @ref COEFFS_NOTCH for use in DAQ_NotchFilter_q15().
+static const q31_t COEFFS_NOTCH_Q31[NUM_COEFFS_NOTCH] = {
+    // Section 1
+    COEFF_Q31(0.8856732845306396), COEFF_Q31(0.5476464033126831), COEFF_Q31(0.8856732845306396),
+    COEFF_Q31(-0.5850160717964172), COEFF_Q31(-0.9409302473068237),
+    // Section 2
+    COEFF_Q31(1.0), COEFF_Q31(0.6183391213417053), COEFF_Q31(1.0),
+    COEFF_Q31(-0.615153431892395), COEFF_Q31(-0.9412328004837036),
+    // Section 3
+    COEFF_Q31(1.0), COEFF_Q31(0.6183391213417053), COEFF_Q31(1.0),
+    COEFF_Q31(-0.5631667971611023), COEFF_Q31(-0.9562366008758545),
+    // Section 4
+    COEFF_Q31(1.0), COEFF_Q31(0.6183391213417053), COEFF_Q31(1.0),
+    COEFF_Q31(-0.6460562348365784), COEFF_Q31(-0.9568508863449097),
+    // Section 5
+    COEFF_Q31(1.0), COEFF_Q31(0.6183391213417053), COEFF_Q31(1.0),
+    COEFF_Q31(-0.5554963946342468), COEFF_Q31(-0.9837208390235901),
+    // Section 6
+    COEFF_Q31(1.0), COEFF_Q31(0.6183391213417053), COEFF_Q31(1.0),
+    COEFF_Q31(-0.6700929999351501), COEFF_Q31(-0.9840363264083862),
+};
+
+/// @brief  `q31_t` version of @ref COEFFS_BANDPASS for use in DAQ_BandpassFilter_q15().
+static const q31_t COEFFS_BANDPASS_Q31[NUM_COEFFS_DAQ_BANDPASS] = {
+    // Section 1
+    COEFF_Q31(0.3240305185317993), COEFF_Q31(0.3665695786476135), COEFF_Q31(0.3240305185317993),
+    COEFF_Q31(-0.20968256890773773), COEFF_Q31(-0.1729172021150589),
+    // Section 2
+    COEFF_Q31(1.0), COEFF_Q31(-0.4715292155742645), COEFF_Q31(1.0),
+    COEFF_Q31(0.5868059992790222), COEFF_Q31(-0.7193671464920044),
+    // Section 3
+    COEFF_Q31(1.0), COEFF_Q31(-1.9999638795852661), COEFF_Q31(1.0),
+    COEFF_Q31(1.9863483905792236), COEFF_Q31(-0.986438512802124),
+    // Section 4
+    COEFF_Q31(1.0), COEFF_Q31(-1.9997893571853638), COEFF_Q31(1.0),
+    COEFF_Q31(1.994096040725708), COEFF_Q31(-0.9943605065345764),
 };                                         /* clang-format on */
 
 typedef arm_biquad_casd_df1_inst_f32 Filter_t;
@@ -151,6 +192,18 @@ static const Filter_t bandpassFiltStruct = { NUM_STAGES_BANDPASS, stateBuffer_Ba
                                              COEFFS_BANDPASS };
 static const Filter_t * const bandpassFilter = &bandpassFiltStruct;
 
+typedef arm_biquad_casd_df1_inst_q31 Filter_q31_t;
+
+static q31_t stateBuffer_Notch_q31[STATE_BUFF_SIZE_NOTCH];
+static const Filter_q31_t notchFiltStruct_q31 = { NUM_STAGES_NOTCH, stateBuffer_Notch_q31,
+                                                  COEFFS_NOTCH_Q31, COEFF_POST_SHIFT };
+static const Filter_q31_t * const notchFilter_q31 = &notchFiltStruct_q31;
+
+static q31_t stateBuffer_Bandpass_q31[STATE_BUFF_SIZE_BANDPASS];
+static const Filter_q31_t bandpassFiltStruct_q31 = { NUM_STAGES_BANDPASS, stateBuffer_Bandpass_q31,
+                                                     COEFFS_BANDPASS_Q31, COEFF_POST_SHIFT };
+static const Filter_q31_t * const bandpassFilter_q31 = &bandpassFiltStruct_q31;
+
 /** @} */                                  // Digital Filters
 
 /*******************************************************************************
@@ -174,11 +227,25 @@ Reading Input Data
 ********************************************************************************/
 
 uint16_t DAQ_readSample(void) {
-    return (uint16_t) (ADC0_SSFIFO3_R & 0xFFF);
+    return ADC_readSample();
+}
+
+q15_t DAQ_convertToQ15(uint16_t sample) {
+    /**
+     * The lookup table maps `[0, 4095]` onto \f$ [-5.5, 5.5] [mV] \f$, so the `q15_t` value is
+     * \f$ \frac{2 \cdot sample - 4095}{4095} \cdot 2^{15} \f$. Since \f$ \frac{2^{15}}{4095} =
+     * 8 + \frac{8}{4095} \f$, this only needs a shift and a small correction term.
+     */
+    assert(sample <= ADC_MAX);
+
+    int32_t offsetSample = (2 * (int32_t) sample) - ADC_MAX;               // [-4095, 4095]
+    int32_t xn = (offsetSample << 3) + ((offsetSample << 3) / ADC_MAX);
+
+    return (q15_t) __SSAT(xn, 16);
 }
 
 void DAQ_acknowledgeInterrupt(void) {
-    ADC0_ISC_R |= 0x08;
+    ADC_acknowledgeInterrupt();
     return;
 }
 
@@ -204,4 +271,37 @@ float32_t DAQ_BandpassFilter(volatile float32_t inputSample) {
     return outputSample;
 }
 
+/**
+ * @brief               Apply a `q31_t` biquad filter to a single `q15_t` sample.
+ *
+ * @param[in] filter    Filter to apply.
+ * @param[in] xn        Input sample
+ * @param[out] yn       Filtered output sample, saturated to the `q15_t` range.
+ */
+static q15_t applyFilter_q15(const Filter_q31_t * filter, q15_t xn) {
+    q31_t inputSample = ((q31_t) xn) << Q15_TO_Q31_SHIFT;
+    q31_t outputSample = 0;
+
+    arm_biquad_cascade_df1_q31(filter, &inputSample, &outputSample, 1);
+
+    return (q15_t) __SSAT(outputSample >> Q15_TO_Q31_SHIFT, 16);
+}
+
+q15_t DAQ_NotchFilter_q15(q15_t inputSample) {
+    return applyFilter_q15(notchFilter_q31, inputSample);
+}
+
+q15_t DAQ_BandpassFilter_q15(q15_t inputSample) {
+    return applyFilter_q15(bandpassFilter_q31, inputSample);
+}
+
+void DAQ_resetFilters(void) {
+    memset(stateBuffer_Notch, 0, sizeof(stateBuffer_Notch));
+    memset(stateBuffer_Bandpass, 0, sizeof(stateBuffer_Bandpass));
+    memset(stateBuffer_Notch_q31, 0, sizeof(stateBuffer_Notch_q31));
+    memset(stateBuffer_Bandpass_q31, 0, sizeof(stateBuffer_Bandpass_q31));
+
+    return;
+}
+
 /** @} */
@@ -30,6 +30,9 @@ Preprocessor Directives
 #define DAQ_LOOKUP_MAX ((float32_t) 5.5f)                  ///< maximum lookup table value
 #define DAQ_LOOKUP_MIN ((float32_t) (-5.5f))               ///< minimum lookup table value
 
+/// voltage in [mV] represented by a `q15_t` value of 1.0 (i.e. the q15 full-scale value)
+#define DAQ_Q15_FULL_SCALE DAQ_LOOKUP_MAX
+
 /*******************************************************************************
 Initialization
 ********************************************************************************/
@@ -83,6 +86,24 @@ uint16_t DAQ_readSample(void);
  */
 float32_t DAQ_convertToMilliVolts(uint16_t sample);
 
+/**
+ * @brief               Convert a 12-bit ADC sample to a fixed-point voltage value.
+ *
+ * @pre                 Read a sample from the ADC.
+ *
+ * @param[in] sample    12-bit sample in range `[0x000, 0xFFF]`
+ * @param[out] xn       Voltage value in range \f$ [-5.5, 5.5) [mV] \f$, scaled by
+ *                      @ref DAQ_Q15_FULL_SCALE (i.e. `1.0` is equal to \f$ 5.5 [mV] \f$)
+ *
+ * @post                The sample \f$ x[n] \f$ is ready for fixed-point filtering.
+ *
+ * @note                No lookup table is needed, since the ADC's range maps linearly onto the
+ *                      `q15_t` range. The result matches DAQ_convertToMilliVolts() to within 1 LSB.
+ *
+ * @see                 DAQ_readSample(), DAQ_convertToMilliVolts()
+ */
+q15_t DAQ_convertToQ15(uint16_t sample);
+
 /**
  * @brief               Acknowledge the ADC interrupt.
  * @pre                 This should be used within an interrupt handler.
@@ -128,6 +149,48 @@ float32_t DAQ_NotchFilter(volatile float32_t xn);
  */
 float32_t DAQ_BandpassFilter(volatile float32_t xn);
 
+/**
+ * @brief               Fixed-point version of DAQ_NotchFilter().
+ *
+ * @pre                 Read a sample from the ADC and convert it to `q15_t`.
+ *
+ * @param[in] xn        Raw input sample
+ * @param[out] yn       Filtered output sample
+ *
+ * @post                \f$ y[n] \f$ is ready for analysis and/or further processing.
+ *
+ * @note                The filter runs in `q31_t` internally, since its poles are too close to the
+ *                      unit circle for `q15_t` coefficients.
+ *
+ * @see                 DAQ_convertToQ15(), DAQ_NotchFilter()
+ */
+q15_t DAQ_NotchFilter_q15(q15_t xn);
+
+/**
+ * @brief               Fixed-point version of DAQ_BandpassFilter().
+ *
+ * @pre                 Read a sample from the ADC and convert it to `q15_t`.
+ *
+ * @param[in] xn        Input sample
+ * @param[out] yn       Filtered output sample. Saturates at \f$ \pm 5.5 [mV] \f$.
+ *
+ * @post                \f$ y[n] \f$ is ready for analysis and/or further processing.
+ *
+ * @note                The filter runs in `q31_t` internally, since its poles are too close to the
+ *                      unit circle for `q15_t` coefficients.
+ *
+ * @see                 DAQ_convertToQ15(), DAQ_BandpassFilter()
+ */
+q15_t DAQ_BandpassFilter_q15(q15_t xn);
+
+/**
+ * @brief               Clear the state of every DAQ filter (both floating- and fixed-point).
+ *
+ * @post                The next sample is filtered as if it were the first one, e.g. when a new
+ *                      recording is started.
+ */
+void DAQ_resetFilters(void);
+
 /// @} Digital Filtering Functions
 
 #endif               // DAQ_H
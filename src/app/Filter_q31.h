@@ -0,0 +1,30 @@
+/**
+ * @addtogroup app
+ * @{
+ *
+ * @file
+ * @author  Bryan McElvy
+ * @brief   Fixed-point helpers shared by the DAQ and QRS modules' `q31_t` biquad filters.
+ */
+
+#ifndef FILTER_Q31_H
+#define FILTER_Q31_H
+
+#include "arm_math_types.h"
+
+/**
+ * @brief       Convert a biquad coefficient to `q31_t` format.
+ *
+ * @details     The coefficients are scaled down by 4 so that they all fit in the range
+ *              \f$ [-1, 1) \f$, which is undone by setting the filter's `postShift` to
+ *              @ref COEFF_POST_SHIFT. This matches `SCALE_FACTOR` in
+ *              `tools/filter_design/daq_filt_fixedpoint.ipynb`.
+ */
+#define COEFF_Q31(X)     ((q31_t) (((X) * 536870912.0) + (((X) < 0) ? -0.5 : 0.5)))
+#define COEFF_POST_SHIFT 2
+
+#define Q15_TO_Q31_SHIFT 14               ///< leaves 2 bits of headroom inside the filters
+
+#endif               // FILTER_Q31_H
+
+/** @} */
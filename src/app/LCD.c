@@ -15,6 +15,7 @@ SECTIONS
         Initialization
         Plotting Parameters
         Drawing
+        Scrolling
 *******************************************************************************/
 
 #include "ILI9341.h"
@@ -27,6 +28,7 @@ SECTIONS
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 
 #define CONVERT_INT_TO_ASCII(X) ((unsigned char) (X + 0x30))
 
@@ -50,6 +52,28 @@ static void LCD_drawLine(uint16_t center, uint16_t lineWidth, bool is_horizontal
 /// @brief               Update the cursor for after writing text on the display.
 static void LCD_updateCursor(void);
 
+/**
+ * @brief               Convert one of the @ref LCD_COLORS to the pixel value sent to the display.
+ *
+ * @param[in] color     Color to convert.
+ * @param[out] uint16_t Pixel value from ILI9341_encodePixel().
+ */
+static uint16_t LCD_getPixelValue(uint8_t color);
+
+/**
+ * @brief               Draw one column of a waveform (see LCD_plotWaveSample()).
+ *
+ * @param[in] x         x-coordinate of the column.
+ * @param[in] y         y-coordinate of the sample.
+ * @param[in] color     Color to use for the trace.
+ * @param[in] isConnected `true` to draw a segment from the previous sample's `y`,
+ *                      `false` to only draw the point `(x, y)`.
+ */
+static void LCD_drawWaveColumn(uint16_t x, uint16_t y, uint8_t color, bool isConnected);
+
+/// @brief               Mark every waveform column as empty, i.e. with nothing to erase.
+static void LCD_clearWaveColumns(void);
+
 /** @} */                           // Helper Functions
 
 static struct {
@@ -63,6 +87,18 @@ static struct {
 
     uint8_t color;
 
+    // NOTE: `uint8_t` is enough for y-values since `LCD_Y_MAX` < 255, so an empty column can be
+    //       marked with `waveLow > waveHigh` (see LCD_clearWaveColumns())
+    uint8_t waveLow[LCD_X_MAX + 1];               ///< lowest y-value drawn in each column
+    uint8_t waveHigh[LCD_X_MAX + 1];              ///< highest y-value drawn in each column
+    uint16_t waveX;                               ///< x-value of the previous waveform sample
+    uint16_t waveY;                               ///< y-value of the previous waveform sample
+    bool isWaveStarted;                           ///< if `true`, `waveX` and `waveY` are valid
+
+    uint16_t scrollStart;                         ///< left-most x-value of the scrolling area
+    uint16_t scrollIdx;                           ///< next column to draw, rel. to `scrollStart`
+    bool isScrolling;
+
     bool isInit;                    ///< if `true`, LCD has been initialized
 } lcd = { 0 };
 
@@ -134,25 +170,23 @@ void LCD_setColor(uint8_t color) {
 Drawing
 *******************************************************************************/
 
-void LCD_Draw(void) {
-    // determine RGB values
-    uint8_t R, G, B;
-    if(lcd.color == 0) {
-        R = 1;
-        G = 1;
-        B = 1;
-    }
-    else {
-        R = 0x1F * ((lcd.color & 0x04) >> 2);
-        G = 0x3F * ((lcd.color & 0x02) >> 1);
-        B = 0x1F * (lcd.color & 0x01);
+static uint16_t LCD_getPixelValue(uint8_t color) {
+    if(color == 0) {
+        return ILI9341_encodePixel(1, 1, 1);
     }
 
+    uint8_t R = 0x1F * ((color & 0x04) >> 2);
+    uint8_t G = 0x3F * ((color & 0x02) >> 1);
+    uint8_t B = 0x1F * (color & 0x01);
+    return ILI9341_encodePixel(R, G, B);
+}
+
+void LCD_Draw(void) {
     uint32_t numPixels = (uint32_t) ((lcd.x2 - lcd.x1) + 1) * ((lcd.y2 - lcd.y1) + 1);
-    ILI9341_writeMemCmd();
-    for(uint32_t count = 0; count < numPixels; count++) {
-        ILI9341_writePixel(R, G, B);
-    }
+
+    ILI9341_startPixelStream();
+    ILI9341_streamPixels(LCD_getPixelValue(lcd.color), numPixels);
+    ILI9341_endPixelStream();
 
     return;
 }
@@ -162,6 +196,7 @@ void LCD_Fill(void) {
     LCD_setY(0, LCD_Y_MAX);
 
     LCD_Draw();
+    LCD_clearWaveColumns();               // the old waveform was drawn over
 
     return;
 }
@@ -234,6 +269,108 @@ void LCD_plotSample(uint16_t x, uint16_t y, uint8_t color) {
     return;
 }
 
+void LCD_plotWaveSample(uint16_t x, uint16_t y, uint8_t color) {
+    assert(x <= LCD_X_MAX);
+    assert(y <= LCD_Y_MAX);
+
+    // new segment connects to the previous sample if it was in the column to the left
+    bool isConnected = lcd.isWaveStarted && (x == (lcd.waveX + 1));
+    LCD_drawWaveColumn(x, y, color, isConnected);
+
+    return;
+}
+
+static void LCD_drawWaveColumn(uint16_t x, uint16_t y, uint8_t color, bool isConnected) {
+    uint16_t newLow = y;
+    uint16_t newHigh = y;
+    if(isConnected) {
+        newLow = (lcd.waveY < y) ? lcd.waveY : y;
+        newHigh = (lcd.waveY > y) ? lcd.waveY : y;
+    }
+
+    // one window covers both the old segment (to erase) and the new one (to draw); for an empty
+    // column, this is just the new segment
+    uint16_t low = (lcd.waveLow[x] < newLow) ? lcd.waveLow[x] : newLow;
+    uint16_t high = (lcd.waveHigh[x] > newHigh) ? lcd.waveHigh[x] : newHigh;
+    LCD_setX(x, x);
+    LCD_setY(low, high);
+
+    // black below the new segment, the new segment, then black above it
+    uint16_t blackPixel = LCD_getPixelValue(LCD_BLACK);
+    ILI9341_startPixelStream();
+    ILI9341_streamPixels(blackPixel, newLow - low);
+    ILI9341_streamPixels(LCD_getPixelValue(color), (newHigh - newLow) + 1);
+    ILI9341_streamPixels(blackPixel, high - newHigh);
+    ILI9341_endPixelStream();
+
+    lcd.waveLow[x] = (uint8_t) newLow;
+    lcd.waveHigh[x] = (uint8_t) newHigh;
+    lcd.waveX = x;
+    lcd.waveY = y;
+    lcd.isWaveStarted = true;
+    return;
+}
+
+static void LCD_clearWaveColumns(void) {
+    memset(lcd.waveLow, UINT8_MAX, sizeof(lcd.waveLow));
+    memset(lcd.waveHigh, 0, sizeof(lcd.waveHigh));
+    lcd.isWaveStarted = false;
+    return;
+}
+
+/******************************************************************************
+Scrolling
+*******************************************************************************/
+
+void LCD_startScrolling(uint16_t xStart) {
+    /**
+     *  The display scrolls along its rows, which are the x-axis here. Since
+     *  LCD_Init() flips the row addresses, `x = 0` is the last row, so the fixed
+     *  area on the left is the driver's bottom fixed area.
+     */
+    assert(lcd.isInit);
+    assert(xStart < LCD_X_MAX);
+
+    ILI9341_setScrollArea(0, xStart);
+
+    lcd.scrollStart = xStart;
+    lcd.scrollIdx = 0;
+    lcd.isWaveStarted = false;
+    lcd.isScrolling = true;
+    return;
+}
+
+void LCD_stopScrolling(void) {
+    assert(lcd.isScrolling);
+
+    ILI9341_setDisplayArea(NORMAL_AREA);
+
+    lcd.isWaveStarted = false;
+    lcd.isScrolling = false;
+    return;
+}
+
+void LCD_scrollWaveSample(uint16_t y, uint8_t color) {
+    /**
+     *  The waveform is drawn into the scrolling area as a sweep, like with
+     *  LCD_plotWaveSample(). The row that was just drawn is then made the top
+     *  of the scrolling area, which is shown at the right edge (since the rows
+     *  are flipped). The next column to be drawn is then the one at the left
+     *  edge, which holds the oldest sample.
+     */
+    assert(lcd.isScrolling);
+    assert(y <= LCD_Y_MAX);
+
+    uint16_t numScrollCols = (LCD_X_MAX + 1) - lcd.scrollStart;
+    LCD_drawWaveColumn(lcd.scrollStart + lcd.scrollIdx, y, color, lcd.isWaveStarted);
+
+    // the column at `x` is in row `LCD_X_MAX - x`
+    ILI9341_setScrollStart((numScrollCols - 1) - lcd.scrollIdx);
+    lcd.scrollIdx = (lcd.scrollIdx + 1) % numScrollCols;
+
+    return;
+}
+
 /******************************************************************************
 Writing
 *******************************************************************************/
@@ -266,19 +403,26 @@ void LCD_writeChar(unsigned char inputChar) {
     const uint8_t * letter = FONT_ARRAY[inputChar];
     assert(((uint32_t) &letter[0]) != 0);
 
-    uint16_t lineNum = lcd.lineNum;
-    uint16_t colNum = lcd.colNum;
-
-    for(uint8_t lineIdx = 0; lineIdx < HEIGHT_CHAR; lineIdx++) {
-        uint8_t line = letter[HEIGHT_CHAR - 1 - lineIdx];
-        for(uint8_t colIdx = 0; colIdx < LEN_CHAR; colIdx++) {
-            uint8_t shiftVal = LEN_CHAR - 1 - colIdx;
+    // render the glyph in the order the display fills its window (i.e. bottom to top, then
+    // left to right), so it can be sent in one burst
+    uint16_t textPixel = LCD_getPixelValue(lcd.color);
+    uint16_t blackPixel = LCD_getPixelValue(LCD_BLACK);
+    uint16_t pixels[LEN_CHAR * HEIGHT_CHAR];
+    for(uint8_t colIdx = 0; colIdx < LEN_CHAR; colIdx++) {
+        uint8_t shiftVal = LEN_CHAR - 1 - colIdx;
+        for(uint8_t lineIdx = 0; lineIdx < HEIGHT_CHAR; lineIdx++) {
+            uint8_t line = letter[HEIGHT_CHAR - 1 - lineIdx];
             uint8_t pixel = line & (1 << shiftVal);
-
-            uint8_t color = (pixel > 0) ? lcd.color : LCD_BLACK;
-            LCD_plotSample(colNum + colIdx, lineNum + lineIdx, color);
+            pixels[(colIdx * HEIGHT_CHAR) + lineIdx] = (pixel > 0) ? textPixel : blackPixel;
         }
     }
+
+    LCD_setX(lcd.colNum, lcd.colNum + (LEN_CHAR - 1));
+    LCD_setY(lcd.lineNum, lcd.lineNum + (HEIGHT_CHAR - 1));
+    ILI9341_startPixelStream();
+    ILI9341_streamPixelBuffer(pixels, LEN_CHAR * HEIGHT_CHAR);
+    ILI9341_endPixelStream();
+
     LCD_updateCursor();
     return;
 }
@@ -17,6 +17,7 @@ SECTIONS
         Initialization
         Plotting Parameters
         Drawing
+        Scrolling
 *******************************************************************************/
 
 #include "ILI9341.h"
@@ -179,8 +180,74 @@ void LCD_drawRectangle(uint16_t x1, uint16_t dx, uint16_t y1, uint16_t dy);
  */
 void LCD_plotSample(uint16_t x, uint16_t y, uint8_t color);
 
+/**
+ * @brief               Plot the next sample of a waveform that sweeps across the display.
+ *
+ * @details             The column at `x` is updated with a single address window and `RAMWR`
+ *                      burst. The segment drawn there the last time the sweep passed is erased,
+ *                      and a vertical segment is drawn from the previous sample's `y` to this one,
+ *                      so consecutive samples form a continuous trace. If `x` doesn't follow the
+ *                      previous sample's x-coordinate (e.g. when the sweep wraps around), only the
+ *                      point `(x, y)` is drawn.
+ *
+ * @param[in] x         x-coordinate (i.e. sample number) in range `[0, X_MAX]`
+ * @param[in] y         y-coordinate (i.e. amplitude) in range `[0, Y_MAX]`
+ * @param[in] color     Color to use for the trace. Erased pixels are set to `LCD_BLACK`.
+ *
+ * @see                 LCD_plotSample()
+ */
+void LCD_plotWaveSample(uint16_t x, uint16_t y, uint8_t color);
+
 /** @} */               // Drawing Functions
 
+/******************************************************************************
+Scrolling
+*******************************************************************************/
+/** @name Scrolling Functions */               /// @{
+
+/**
+ * @brief               Start scrolling the waveform across the display (i.e. a strip chart).
+ *
+ * @details             The area at `x >= xStart` is scrolled by the display itself, so each new
+ *                      sample only needs its own column to be drawn. Everything to the left of
+ *                      `xStart` stays put, so it can be used for text.
+ *
+ * @param[in] xStart    Left-most x-coordinate of the scrolling area, in range `[0, X_MAX)`.
+ *
+ * @post                Plot samples with LCD_scrollWaveSample() instead of LCD_plotWaveSample().
+ *
+ * @see                 LCD_scrollWaveSample(), LCD_stopScrolling()
+ */
+void LCD_startScrolling(uint16_t xStart);
+
+/**
+ * @brief               Stop scrolling.
+ *
+ * @post                The scrolling area is shown unshifted again, so anything drawn there while
+ *                      scrolling is out of order until it's redrawn.
+ *
+ * @see                 LCD_startScrolling()
+ */
+void LCD_stopScrolling(void);
+
+/**
+ * @brief               Plot the next sample of a scrolling waveform at the right edge of the
+ *                      display, and shift the rest of the waveform to the left.
+ *
+ * @details             The oldest column is overwritten the same way as in LCD_plotWaveSample(),
+ *                      and then the display is scrolled by one column (`VSCRSADD`).
+ *
+ * @pre                 Start scrolling.
+ *
+ * @param[in] y         y-coordinate (i.e. amplitude) in range `[0, Y_MAX]`
+ * @param[in] color     Color to use for the trace. Erased pixels are set to `LCD_BLACK`.
+ *
+ * @see                 LCD_startScrolling(), LCD_plotWaveSample()
+ */
+void LCD_scrollWaveSample(uint16_t y, uint8_t color);
+
+/** @} */               // Scrolling Functions
+
 /******************************************************************************
 Writing
 *******************************************************************************/
@@ -33,13 +33,15 @@ Preprocessor Directives
 
 #include "arm_math_types.h"
 #include "dsp/filtering_functions.h"
-#include "dsp/statistics_functions.h"
-#include "dsp/support_functions.h"
+
+#include "Filter_q31.h"
+#include "NewAssert.h"
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 
-#define QRS_NUM_FID_MARKS       40
+#define QRS_CALIB_NUM_SAMP      (QRS_SAMP_FREQ * 2)    ///< 2 [s] of data used for calibration
 
 #define FLOAT_COMPARE_TOLERANCE ((float32_t) 1E-5f)
 #define IS_GREATER(X, Y)        (bool) ((X - Y) > FLOAT_COMPARE_TOLERANCE)
@@ -49,28 +51,26 @@ Static Declarations
 ********************************************************************************/
 
 /**
- * @brief                       Mark local peaks in the input signal `y` as potential
- *                              candidates for QRS complexes (AKA "fiducial marks").
- *
- * @param[in] yn                Array containing the preprocessed ECG signal \f$ y[n] \f$
- * @param[in] fidMarkArray      Array to place the fiducial mark's sample indices into.
- * @param[out] numMarks         Number of identified fiducial marks
+ * @brief                       Apply the decision rules to one sample of the preprocessed signal.
  *
- * @post                        `fidMarkArray` will hold the values of the fiducial marks.
+ * @param[in] state             Decision state to update.
+ * @param[in] yn                Newest sample of the preprocessed ECG signal \f$ y[n] \f$
+ * @param[in] rrIntervalPtr     Pointer to variable to store the RR interval in [samples].
+ * @param[out] true             A QRS complex was confirmed, and the RR interval was updated.
+ * @param[out] false            No new RR interval is available.
  */
-static uint8_t findFiducialMarks(const float32_t yn[], uint16_t fidMarkArray[]);
+static bool updateDecisionState(QrsDecisionState_t * state, float32_t yn, uint32_t * rrIntervalPtr);
 
 /**
- * @brief                       Initialize the signal and noise levels for the QRS detector
- *                              using the initial block of input signal data.
- *
- * @param[in] yn                Array containing the preprocessed ECG signal \f$ y[n] \f$
- * @param[in] sigLvlPtr         Pointer to variable holding the signal level value.
- * @param[in] noiseLvlPtr       Pointer to variable holding the noise level value.
+ * @brief                       Classify the pending fiducial mark as signal (a confirmed R peak)
+ *                              or noise.
  *
- * @post                        The signal and noise levels are initialized.
+ * @param[in] state             Decision state holding the pending mark.
+ * @param[in] rrIntervalPtr     Pointer to variable to store the RR interval in [samples].
+ * @param[out] true             The mark is a QRS complex, and the RR interval was updated.
+ * @param[out] false            The mark is noise, or it is the first confirmed QRS complex.
  */
-static void initLevels(const float32_t yn[], float32_t * sigLvlPtr, float32_t * noiseLvlPtr);
+static bool classifyMark(QrsDecisionState_t * state, uint32_t * rrIntervalPtr);
 
 /**
  * @brief                       Update the signal level (if a fiducial mark is a confirmed peak)
@@ -94,17 +94,60 @@ static float32_t updateLevel(const float32_t peakAmplitude, float32_t level);
  */
 static float32_t updateThreshold(const float32_t signalLevel, const float32_t noiseLevel);
 
-static struct {
-    bool isCalibrated;
+/**
+ * @brief                       Apply the bandpass filter, derivative filter, squaring, and
+ *                              moving-window integration to one sample.
+ *
+ * @param[in] filters           Filter state to update.
+ * @param[in] xn                Newest sample of the ECG signal \f$ x[n] \f$
+ * @param[out] yn               Newest sample of the preprocessed ECG signal \f$ y[n] \f$
+ */
+static inline float32_t preprocessSample(QrsFilterState_t * filters, float32_t xn);
+
+/**
+ * @brief                       Fixed-point version of preprocessSample(), starting after the
+ *                              bandpass filter.
+ *
+ * @param[in] filters           Filter state to update.
+ * @param[in] xn                Newest sample of the bandpass-filtered ECG signal
+ * @param[out] yn               Newest sample of the preprocessed ECG signal \f$ y[n] \f$
+ */
+static inline q15_t preprocessSample_q15(QrsFilterState_q15_t * filters, q15_t xn);
+
+/**
+ * @brief                       Apply the decision rules to one sample of a block.
+ *
+ * @param[in] block             Block-based decision state to update.
+ * @param[in] yn                Sample of the preprocessed ECG signal \f$ y[n] \f$
+ * @param[out] true             A QRS complex was confirmed. Its sample number is stored in
+ *                              `block->rules.prevBeatSampleNum`.
+ * @param[out] false            No new QRS complex was confirmed.
+ */
+static bool updateBlockState(QrsBlockState_t * block, float32_t yn);
+
+/**
+ * @brief                       Average the heart rates from the RR intervals completed during the
+ *                              current block, and start a new block.
+ *
+ * @param[in] block             Block-based decision state to update.
+ * @param[out] heartRate        Average heart rate in [bpm], or the previous value if no RR
+ *                              intervals were completed.
+ */
+static float32_t finishBlock(QrsBlockState_t * block);
+
+/**
+ * @brief                       Get the detector used by the original (non-reentrant) interface,
+ *                              initializing it on first use.
+ */
+static QrsDetector_t getDefaultDetector(void);
 
-    float32_t signalLevel;                                  ///< estimated signal level
-    float32_t noiseLevel;                                   ///< estimated noise level
-    float32_t threshold;                                    ///< amplitude threshold
+/// @brief                      Fixed-point version of getDefaultDetector().
+static QrsDetector_q15_t getDefaultDetector_q15(void);
 
-    uint16_t fidMarkArray[QRS_NUM_FID_MARKS];               /// array to hold fidMark indices
-    float32_t utilityBuffer1[QRS_NUM_FID_MARKS];
-    float32_t utilityBuffer2[QRS_NUM_FID_MARKS];
-} Detector = { false, 0.0f, 0.0f, 0.0f, { 0 }, { 0 }, { 0 } };
+static QrsDetectorStruct_t DefaultDetector;
+static QrsDetectorStruct_q15_t DefaultDetector_q15;
+static bool isDefaultInit = false;
+static bool isDefaultInit_q15 = false;
 
 /*******************************************************************************
 Digital Filters
@@ -113,19 +156,15 @@ Digital Filters
 
 enum DIGITAL_FILTER_PARAMS {
     // IIR Bandpass Filter
-    NUM_STAGES_BANDPASS = 4,
+    NUM_STAGES_BANDPASS = QRS_NUM_STAGES_BANDPASS,
     NUM_COEFF_BANDPASS = NUM_STAGES_BANDPASS * 5,
-    STATE_BUFF_SIZE_BANDPASS = NUM_STAGES_BANDPASS * 4,
 
-    // FIR Derivative Filter
-    NUM_COEFF_DERFILT = 5,
-    BLOCK_SIZE_DERFILT = (1 << 8),
-    STATE_BUFF_SIZE_DERFILT = NUM_COEFF_DERFILT + BLOCK_SIZE_DERFILT - 1,
+    // FIR Derivative and Moving Average Filters (state buffer sizes are in `QRS.h`)
+    NUM_COEFF_DERFILT = QRS_NUM_COEFF_DERFILT,
+    NUM_COEFF_MOVAVG = QRS_NUM_COEFF_MOVAVG,
 
-    // FIR Moving Average Filter
-    NUM_COEFF_MOVAVG = 10,
-    BLOCK_SIZE_MOVAVG = BLOCK_SIZE_DERFILT,
-    STATE_BUFF_SIZE_MOVAVG = NUM_COEFF_MOVAVG + BLOCK_SIZE_MOVAVG - 1,
+    // Fixed-Point Filters
+    BLOCK_SIZE_BANDPASS_Q31 = (1 << 5),                      // size of `q31_t` working buffer
 };
 
 // clang-format off
@@ -196,20 +235,32 @@ static const float32_t COEFF_MOVAVG[NUM_COEFF_MOVAVG] = {
     0.10000000149011612f, 0.10000000149011612f, 0.10000000149011612f, 0.10000000149011612f
 };
 
-typedef arm_biquad_casd_df1_inst_f32 IIR_Filt_t;
-typedef arm_fir_instance_f32 FIR_Filt_t;
-
-static float32_t stateBuffer_bandPass[STATE_BUFF_SIZE_BANDPASS] = { 0 };
-static const IIR_Filt_t bandpassFiltStruct = { NUM_STAGES_BANDPASS, stateBuffer_bandPass, COEFF_BANDPASS };
-static const IIR_Filt_t * const bandpassFilter = &bandpassFiltStruct;
+/// @brief  `q31_t` version of @ref COEFF_BANDPASS for use in QRS_Preprocess_q15().
+static const q31_t COEFF_BANDPASS_Q31[NUM_COEFF_BANDPASS] = {
+    // Section 1
+    COEFF_Q31(0.002937758108600974), COEFF_Q31(0.005875516217201948),
+    COEFF_Q31(0.002937758108600974),
+    COEFF_Q31(1.0485996007919312), COEFF_Q31(-0.2961403429508209),
+    // Section 2
+    COEFF_Q31(1.0), COEFF_Q31(2.0), COEFF_Q31(1.0),
+    COEFF_Q31(1.3876197338104248), COEFF_Q31(-0.492422878742218),
+    // Section 3
+    COEFF_Q31(1.0), COEFF_Q31(-2.0), COEFF_Q31(1.0),
+    COEFF_Q31(1.3209134340286255), COEFF_Q31(-0.6327387690544128),
+    // Section 4
+    COEFF_Q31(1.0), COEFF_Q31(-2.0), COEFF_Q31(1.0),
+    COEFF_Q31(1.6299355030059814), COEFF_Q31(-0.7530401945114136),
+};
 
-static float32_t stateBuffer_DerFilt[STATE_BUFF_SIZE_DERFILT] = { 0 };
-static const FIR_Filt_t derivativeFiltStruct = { NUM_COEFF_DERFILT, stateBuffer_DerFilt, COEFF_DERFILT };
-static const FIR_Filt_t * const derivativeFilter = &derivativeFiltStruct;
+/// @brief          `q15_t` version of @ref COEFF_DERFILT for use in QRS_Preprocess_q15().
+static const q15_t COEFF_DERFILT_Q15[NUM_COEFF_DERFILT] = {
+    -4096, -8192, 0, 8192, 4096
+};
 
-static float32_t stateBuffer_MovingAvg[STATE_BUFF_SIZE_MOVAVG] = { 0 };
-static const FIR_Filt_t movingAvgFiltStruct = { NUM_COEFF_MOVAVG, stateBuffer_MovingAvg, COEFF_MOVAVG };
-static const FIR_Filt_t * const movingAverageFilter = &movingAvgFiltStruct;
+/// @brief          `q15_t` version of @ref COEFF_MOVAVG for use in QRS_Preprocess_q15().
+static const q15_t COEFF_MOVAVG_Q15[NUM_COEFF_MOVAVG] = {
+    3277, 3277, 3277, 3277, 3277, 3277, 3277, 3277, 3277, 3277
+};
 
 // clang-format on
 
@@ -219,17 +270,72 @@ static const FIR_Filt_t * const movingAverageFilter = &movingAvgFiltStruct;
 Main Functions
 ********************************************************************************/
 
-/** @name Interface Functions */               /// @{
+/** @name Default Instance */               /// @{
 
 void QRS_Init(void) {
     /**
-     * This function originally initialized the filter `struct`s but now does nothing since those
-     * have been made `const` and their initialization functions have been removed entirely.
+     * This function originally initialized the filter `struct`s, but those are now stored in each
+     * detector. It now resets the default detector, which is otherwise initialized on first use.
      */
+    QRS_DetectorInit(&DefaultDetector);
+    isDefaultInit = true;
+
     return;
 }
 
 void QRS_Preprocess(const float32_t xn[], float32_t yn[]) {
+    QRS_DetectorPreprocess(getDefaultDetector(), xn, yn);
+    return;
+}
+
+float32_t QRS_applyDecisionRules(const float32_t yn[]) {
+    return QRS_DetectorApplyDecisionRules(getDefaultDetector(), yn);
+}
+
+void QRS_Preprocess_q15(const q15_t xn[], q15_t yn[]) {
+    QRS_DetectorPreprocess_q15(getDefaultDetector_q15(), xn, yn);
+    return;
+}
+
+float32_t QRS_applyDecisionRules_q15(const q15_t yn[]) {
+    return QRS_DetectorApplyDecisionRules_q15(getDefaultDetector_q15(), yn);
+}
+
+bool QRS_ProcessSample(float32_t xn, float32_t * heartRatePtr) {
+    return QRS_DetectorProcessSample(getDefaultDetector(), xn, heartRatePtr);
+}
+
+float32_t QRS_getIntegratedSample(void) {
+    return QRS_DetectorGetIntegratedSample(getDefaultDetector());
+}
+
+uint32_t QRS_getBeatSampleNum(void) {
+    return QRS_DetectorGetBeatSampleNum(getDefaultDetector());
+}
+
+/** @} */               // Default Instance
+
+/** @name Reentrant Interface */               /// @{
+
+QrsDetector_t QRS_DetectorInit(QrsDetectorStruct_t * detectorStruct) {
+    assert(detectorStruct != 0);
+    QrsDetector_t detector = detectorStruct;
+
+    // the floating-point filters use the coefficient tables directly, so there is nothing to set up
+    QRS_DetectorReset(detector);
+
+    return detector;
+}
+
+void QRS_DetectorReset(QrsDetector_t detector) {
+    assert(detector != 0);
+
+    memset(detector, 0, sizeof(*detector));
+
+    return;
+}
+
+void QRS_DetectorPreprocess(QrsDetector_t detector, const float32_t xn[], float32_t yn[]) {
     /**
      * This function uses the same overall preprocessing pipeline as the original Pan-Tompkins
      * algorithm, but the high-pass and low-pass filters have been replaced with ones generated
@@ -240,145 +346,280 @@ void QRS_Preprocess(const float32_t xn[], float32_t yn[]) {
      * <br>
      * @image latex software/qrs_preproc.png ""
      * @image latex software/qrs_preproc_output.png ""
+     *
+     * All four stages are applied to each sample before moving on to the next one, so the buffer
+     * is only read and written once, and each filter only keeps as much state as it has taps.
+     * `xn` and `yn` can be the same buffer.
      */
-
-    // copy samples from input buffer `xn` to output buffer `yn`
-    if(((uint32_t) &xn[0]) != ((uint32_t) &yn[0])) {               // skip if they're the same
-        arm_copy_f32(xn, yn, QRS_NUM_SAMP);
+    for(uint16_t n = 0; n < QRS_NUM_SAMP; n++) {
+        yn[n] = preprocessSample(&detector->filters, xn[n]);
     }
 
-    // apply filters
-    arm_biquad_cascade_df1_f32(bandpassFilter, yn, yn, QRS_NUM_SAMP);
-
-    for(uint16_t n = 0; n < QRS_NUM_SAMP; n += BLOCK_SIZE_DERFILT) {
-        /**
-         * @note    The FIR filters are applied in blocks to decrease the amount
-         *          of memory needed for their state buffers.
-         */
-        arm_fir_f32(derivativeFilter, &yn[n], &yn[n], BLOCK_SIZE_DERFILT);
-        arm_mult_f32(&yn[n], &yn[n], &yn[n], BLOCK_SIZE_DERFILT);               // square
-        arm_fir_f32(movingAverageFilter, &yn[n], &yn[n], BLOCK_SIZE_MOVAVG);
+    return;
+}
+
+float32_t QRS_DetectorApplyDecisionRules(QrsDetector_t detector, const float32_t yn[]) {
+    /**
+     * Each sample is passed through the same decision rules used by QRS_ProcessSample(). The
+     * decision state (including the last two samples, any unconfirmed fiducial mark, and the
+     * sample number of the last confirmed peak) is carried into the next call, so peaks and RR
+     * intervals that cross a block boundary are still counted exactly once.
+     *
+     * The output is the average of the heart rates given by each RR interval completed during
+     * this block. If no RR interval was completed, the previous output is returned instead.
+     */
+    for(uint16_t n = 0; n < QRS_NUM_SAMP; n++) {
+        updateBlockState(&detector->block, yn[n]);
     }
 
-    return;
+    return finishBlock(&detector->block);
 }
 
-float32_t QRS_applyDecisionRules(const float32_t yn[]) {
-    /// @todo Write implementation explanation
+float32_t QRS_DetectorFindBeats(QrsDetector_t detector, const float32_t yn[],
+                                uint32_t beatSampleNums[], uint16_t * numBeatsPtr) {
+    uint16_t numBeats = 0;
+    for(uint16_t n = 0; n < QRS_NUM_SAMP; n++) {
+        if(updateBlockState(&detector->block, yn[n])) {
+            assert(numBeats < QRS_MAX_BEATS_PER_BLOCK);
+            beatSampleNums[numBeats] = detector->block.rules.prevBeatSampleNum;
+            numBeats += 1;
+        }
+    }
+    *numBeatsPtr = numBeats;
 
-    // copy variables from `Detector` for readability
-    float32_t signalLevel = Detector.signalLevel;
-    float32_t noiseLevel = Detector.noiseLevel;
-    float32_t threshold = Detector.threshold;
+    return finishBlock(&detector->block);
+}
 
-    uint16_t * fidMarkArray = Detector.fidMarkArray;
+bool QRS_DetectorProcessSample(QrsDetector_t detector, float32_t xn, float32_t * heartRatePtr) {
+    /**
+     * The sample goes through the same filters as in QRS_Preprocess(), just one at a time.
+     * The output is then checked against the decision rules right away.
+     */
+    float32_t yn = preprocessSample(&detector->streamFilters, xn);
+
+    // store RR interval, then convert the average RR interval to HR
+    bool isNewBeat = false;
+    uint32_t rrInterval;
+    if(updateDecisionState(&detector->streamRules, yn, &rrInterval)) {
+        detector->rrBuffer[detector->rrIdx] = (uint16_t) rrInterval;
+        detector->rrIdx = (detector->rrIdx + 1) % QRS_NUM_RR_INTERVALS;
+        if(detector->numIntervals < QRS_NUM_RR_INTERVALS) {
+            detector->numIntervals += 1;
+        }
 
-    float32_t * timeBuffer = Detector.utilityBuffer1;                    // time in [s] of each peak
-    float32_t * heartRateBuffer = Detector.utilityBuffer2;               // HR in [BPM]
+        uint32_t sum = 0;
+        for(uint8_t idx = 0; idx < detector->numIntervals; idx++) {
+            sum += detector->rrBuffer[idx];
+        }
+        float32_t avgInterval_sec =
+            ((float32_t) sum / detector->numIntervals) * QRS_SAMP_PERIOD_SEC;
 
-    // calibrate detector on first pass
-    if(Detector.isCalibrated == false) {
-        initLevels(yn, &signalLevel, &noiseLevel);
-        threshold = updateThreshold(signalLevel, noiseLevel);
-        Detector.isCalibrated = true;
+        *heartRatePtr = 60.0f / avgInterval_sec;
+        isNewBeat = true;
     }
 
-    // classify fiducial marks as signal (confirmed R peaks) or noise
-    uint8_t numMarks = findFiducialMarks(yn, fidMarkArray);
-    uint8_t numPeaks = 0;
+    return isNewBeat;
+}
+
+float32_t QRS_DetectorGetIntegratedSample(QrsDetector_t detector) {
+    return detector->streamRules.prevSamples[0];               // i.e. the newest y[n]
+}
+
+uint32_t QRS_DetectorGetBeatSampleNum(QrsDetector_t detector) {
+    return detector->streamRules.prevBeatSampleNum;
+}
+
+QrsDetector_q15_t QRS_DetectorInit_q15(QrsDetectorStruct_q15_t * detectorStruct) {
+    assert(detectorStruct != 0);
+    QrsDetector_q15_t detector = detectorStruct;
+
+    detector->bandpassFilter = (arm_biquad_casd_df1_inst_q31){ NUM_STAGES_BANDPASS,
+                                                               detector->bandpassState,
+                                                               COEFF_BANDPASS_Q31,
+                                                               COEFF_POST_SHIFT };
 
-    for(uint8_t idx = 0; idx < numMarks; idx++) {
-        uint16_t n = fidMarkArray[idx];
+    QRS_DetectorReset_q15(detector);
+
+    return detector;
+}
 
-        if(IS_GREATER(yn[n], threshold)) {
-            timeBuffer[numPeaks] = n * QRS_SAMP_PERIOD_SEC;
-            numPeaks += 1;
+void QRS_DetectorReset_q15(QrsDetector_q15_t detector) {
+    assert(detector != 0);
 
-            signalLevel = updateLevel(yn[n], signalLevel);
+    memset(detector->bandpassState, 0, sizeof(detector->bandpassState));
+    memset(&detector->filters, 0, sizeof(detector->filters));
+    memset(&detector->block, 0, sizeof(detector->block));
+
+    return;
+}
+
+void QRS_DetectorPreprocess_q15(QrsDetector_q15_t detector, const q15_t xn[], q15_t yn[]) {
+    /**
+     * The bandpass filter's poles are too close to the unit circle for `q15_t` coefficients, so
+     * it is applied in `q31_t` using a small working buffer on the stack. The rest of the
+     * pipeline is then applied to each sample of the working buffer as it is written to `yn`.
+     */
+    q31_t bandpassBuffer[BLOCK_SIZE_BANDPASS_Q31];
+
+    for(uint16_t n = 0; n < QRS_NUM_SAMP; n += BLOCK_SIZE_BANDPASS_Q31) {
+        uint16_t blockSize = ((QRS_NUM_SAMP - n) < BLOCK_SIZE_BANDPASS_Q31)
+                                 ? (QRS_NUM_SAMP - n)
+                                 : BLOCK_SIZE_BANDPASS_Q31;
+
+        for(uint16_t idx = 0; idx < blockSize; idx++) {
+            bandpassBuffer[idx] = ((q31_t) xn[n + idx]) << Q15_TO_Q31_SHIFT;
         }
-        else {
-            noiseLevel = updateLevel(yn[n], noiseLevel);
+        arm_biquad_cascade_df1_q31(&detector->bandpassFilter, bandpassBuffer, bandpassBuffer,
+                                   blockSize);
+        for(uint16_t idx = 0; idx < blockSize; idx++) {
+            q15_t sample = (q15_t) __SSAT(bandpassBuffer[idx] >> Q15_TO_Q31_SHIFT, 16);
+            yn[n + idx] = preprocessSample_q15(&detector->filters, sample);
         }
-
-        threshold = updateThreshold(signalLevel, noiseLevel);
     }
 
-    // store updated values in `Detector`
-    Detector.signalLevel = signalLevel;
-    Detector.noiseLevel = noiseLevel;
-    Detector.threshold = threshold;
+    return;
+}
 
-    // calculate RR interval and convert to HR
-    for(uint8_t idx = 0; idx < (numPeaks - 1); idx++) {
-        heartRateBuffer[idx] = 60.0f / (timeBuffer[idx + 1] - timeBuffer[idx]);
+float32_t QRS_DetectorApplyDecisionRules_q15(QrsDetector_q15_t detector, const q15_t yn[]) {
+    /**
+     * This uses the same decision rules as QRS_applyDecisionRules(). Each `q15_t` sample is
+     * integer-valued, so it is converted to `float32_t` exactly.
+     */
+    for(uint16_t n = 0; n < QRS_NUM_SAMP; n++) {
+        updateBlockState(&detector->block, (float32_t) yn[n]);
     }
 
-    float32_t avgHeartRate_bpm;
-    arm_mean_f32(heartRateBuffer, numPeaks, &avgHeartRate_bpm);
-
-    return avgHeartRate_bpm;
+    return finishBlock(&detector->block);
 }
 
-/** @} */               // Interface Functions
+/** @} */               // Reentrant Interface
 
 /*******************************************************************************
 Static Function Definitions
 ********************************************************************************/
 
-/** @name Pan-Tompkins Algorithm-specific Functions */               /// @{
+/** @name Default Instance */               /// @{
 
-static void initLevels(const float32_t yn[], float32_t * sigLvlPtr, float32_t * noiseLvlPtr) {
-    float32_t max;
-    uint32_t maxIdx;
-    arm_max_f32(yn, QRS_SAMP_FREQ * 2, &max, &maxIdx);
-    *sigLvlPtr = 0.25f * max;
+static QrsDetector_t getDefaultDetector(void) {
+    if(isDefaultInit == false) {
+        QRS_DetectorInit(&DefaultDetector);
+        isDefaultInit = true;
+    }
 
-    float32_t mean;
-    arm_mean_f32(yn, QRS_SAMP_FREQ * 2, &mean);
-    *noiseLvlPtr = 0.5f * mean;
+    return &DefaultDetector;
+}
 
-    return;
+static QrsDetector_q15_t getDefaultDetector_q15(void) {
+    if(isDefaultInit_q15 == false) {
+        QRS_DetectorInit_q15(&DefaultDetector_q15);
+        isDefaultInit_q15 = true;
+    }
+
+    return &DefaultDetector_q15;
 }
 
-static uint8_t findFiducialMarks(const float32_t yn[], uint16_t fidMarkArray[]) {
-    uint8_t numMarks = 0;                      // running counter of peak candidates
-    uint16_t countSincePrev = 1;               // samples checked since previous peak candidate
-    uint16_t n_prevMark = 0;                   // sample number of previous peak candidate
-
-    for(uint16_t n = 1; n < (QRS_NUM_SAMP - 1); n++) {
-        if(IS_GREATER(yn[n], yn[n - 1]) &&
-           IS_GREATER(yn[n], yn[n + 1])) {               // Verify `y[n]` is a peak
-            /**
-             * The fiducial marks must be spaced apart by at least 200 [ms] (40 samples
-             * @ fs = 200 [Hz]). If a peak is found within this range, the one with the
-             * largest amplitude is taken to be the correct peak and the other is ignored.
-             */
-            if(countSincePrev >= 40) {
-                fidMarkArray[numMarks] = n;
-                numMarks += 1;
-
-                n_prevMark = n;
-                countSincePrev = 0;
-            }
-            else if(countSincePrev < 40) {
-                if(IS_GREATER(yn[n], yn[n_prevMark])) {
-                    fidMarkArray[numMarks - 1] = n;
-                    n_prevMark = n;
-                    countSincePrev = 0;
-                }
-                else {
-                    countSincePrev += 1;
-                }
-            }
-        }
-        else {
-            countSincePrev += 1;
+/** @} */               // Default Instance
+
+/** @name Preprocessing Kernels */               /// @{
+
+static inline float32_t preprocessSample(QrsFilterState_t * filters, float32_t xn) {
+    /**
+     * The bandpass filter uses the same equations (and state layout) as
+     * `arm_biquad_cascade_df1_f32()`. The derivative filter's coefficients are antisymmetric, so
+     * it only needs two multiplications:
+     *
+     * \f$
+     * y[n] = \frac{1}{8}(x[n] - x[n-4]) + \frac{1}{4}(x[n-1] - x[n-3])
+     * \f$
+     *
+     * All of the moving average filter's coefficients are equal, so it is calculated from a
+     * running sum of the last 10 squared samples. The sum is recalculated from scratch whenever
+     * the buffer index wraps around, so rounding errors cannot build up.
+     */
+
+    // bandpass filter
+    float32_t sample = xn;
+    float32_t * state = filters->bandpassState;
+    const float32_t * coeffs = COEFF_BANDPASS;
+    for(uint8_t stage = 0; stage < NUM_STAGES_BANDPASS; stage++) {
+        float32_t acc = (coeffs[0] * sample) + (coeffs[1] * state[0]) + (coeffs[2] * state[1]) +
+                        (coeffs[3] * state[2]) + (coeffs[4] * state[3]);
+        state[1] = state[0];
+        state[0] = sample;
+        state[3] = state[2];
+        state[2] = acc;
+
+        sample = acc;
+        state += 4;
+        coeffs += 5;
+    }
+
+    // derivative filter (coefficients are time-reversed)
+    float32_t * x = filters->derivativeState;
+    float32_t derivative =
+        (COEFF_DERFILT[4] * (sample - x[3])) + (COEFF_DERFILT[3] * (x[0] - x[2]));
+    x[3] = x[2];
+    x[2] = x[1];
+    x[1] = x[0];
+    x[0] = sample;
+
+    // square
+    float32_t square = derivative * derivative;
+
+    // moving-window integration
+    uint8_t idx = filters->movingAverageIdx;
+    filters->movingAverageSum += square - filters->movingAverageState[idx];
+    filters->movingAverageState[idx] = square;
+
+    idx += 1;
+    if(idx == NUM_COEFF_MOVAVG) {
+        idx = 0;
+
+        float32_t sum = 0;
+        for(uint8_t k = 0; k < NUM_COEFF_MOVAVG; k++) {
+            sum += filters->movingAverageState[k];
         }
+        filters->movingAverageSum = sum;
     }
+    filters->movingAverageIdx = idx;
+
+    return COEFF_MOVAVG[0] * filters->movingAverageSum;
+}
+
+static inline q15_t preprocessSample_q15(QrsFilterState_q15_t * filters, q15_t xn) {
+    /**
+     * This gives exactly the same output as `arm_fir_fast_q15()` with the same coefficients,
+     * since the products are summed in 32 bits without overflowing and then shifted back to
+     * `q15_t` with saturation. The running sum is exact here, so it never needs to be reset.
+     */
 
-    return numMarks;
+    // derivative filter
+    q15_t * x = filters->derivativeState;
+    q31_t acc = (COEFF_DERFILT_Q15[4] * (xn - x[3])) + (COEFF_DERFILT_Q15[3] * (x[0] - x[2]));
+    q15_t derivative = (q15_t) __SSAT(acc >> 15, 16);
+    x[3] = x[2];
+    x[2] = x[1];
+    x[1] = x[0];
+    x[0] = xn;
+
+    // square, with a gain to keep the resolution of small slopes
+    q31_t square = ((q31_t) derivative * derivative) >> (15 - QRS_Q15_SQUARE_GAIN_SHIFT);
+    q15_t squareSat = (q15_t) __SSAT(square, 16);
+
+    // moving-window integration
+    uint8_t idx = filters->movingAverageIdx;
+    filters->movingAverageSum += squareSat - filters->movingAverageState[idx];
+    filters->movingAverageState[idx] = squareSat;
+    filters->movingAverageIdx = ((idx + 1) == NUM_COEFF_MOVAVG) ? 0 : (idx + 1);
+
+    acc = COEFF_MOVAVG_Q15[0] * filters->movingAverageSum;
+    return (q15_t) __SSAT(acc >> 15, 16);
 }
 
+/** @} */               // Preprocessing Kernels
+
+/** @name Pan-Tompkins Algorithm-specific Functions */               /// @{
+
 static float32_t updateLevel(const float32_t peakAmplitude, float32_t level) {
     /**
      * This function updates the signal level or noise level using the amplitude of a peak
@@ -406,6 +647,118 @@ static float32_t updateThreshold(const float32_t signalLevel, const float32_t no
     return (noiseLevel + (0.25f * (signalLevel - noiseLevel)));
 }
 
+static bool updateBlockState(QrsBlockState_t * block, float32_t yn) {
+    bool hadPrevBeat = block->rules.hasPrevBeat;
+
+    uint32_t rrInterval;
+    bool isNewInterval = updateDecisionState(&block->rules, yn, &rrInterval);
+    if(isNewInterval) {
+        block->heartRateSum += 60.0f / (rrInterval * QRS_SAMP_PERIOD_SEC);
+        block->numIntervals += 1;
+    }
+
+    // the first confirmed QRS complex has no RR interval
+    return (isNewInterval || (block->rules.hasPrevBeat != hadPrevBeat));
+}
+
+static float32_t finishBlock(QrsBlockState_t * block) {
+    if(block->numIntervals > 0) {
+        block->heartRate = block->heartRateSum / block->numIntervals;
+    }
+
+    block->heartRateSum = 0;
+    block->numIntervals = 0;
+
+    return block->heartRate;
+}
+
+static bool updateDecisionState(QrsDecisionState_t * state, float32_t yn,
+                                uint32_t * rrIntervalPtr) {
+    /**
+     * A local peak is marked as a candidate for a QRS complex (AKA a "fiducial mark"). The
+     * fiducial marks must be spaced apart by at least 200 [ms] (40 samples @ fs = 200 [Hz]). If a
+     * larger peak is found within this range, it replaces the pending mark. Otherwise, the mark is
+     * classified once the 200 [ms] have passed.
+     */
+    bool isNewInterval = false;
+
+    uint32_t n = state->sampleNum;
+    state->sampleNum += 1;
+
+    // calibrate detector using the first 2 [s] of data
+    if(n < QRS_CALIB_NUM_SAMP) {
+        state->calibMax = (yn > state->calibMax) ? yn : state->calibMax;
+        state->calibSum += yn;
+
+        if(n == (QRS_CALIB_NUM_SAMP - 1)) {
+            state->signalLevel = 0.25f * state->calibMax;
+            state->noiseLevel = 0.5f * (state->calibSum / QRS_CALIB_NUM_SAMP);
+            state->threshold = updateThreshold(state->signalLevel, state->noiseLevel);
+        }
+    }
+
+    // check if `y[n-1]` is a peak, and mark it as a candidate if necessary
+    float32_t y1 = state->prevSamples[0];
+    float32_t y2 = state->prevSamples[1];
+    state->prevSamples[1] = y1;
+    state->prevSamples[0] = yn;
+
+    if((n >= 2) && IS_GREATER(y1, y2) && IS_GREATER(y1, yn)) {
+        if(state->isMarkPending == false) {
+            state->isMarkPending = true;
+            state->markSampleNum = n - 1;
+            state->markAmplitude = y1;
+            state->countSinceMark = 0;
+        }
+        else if(IS_GREATER(y1, state->markAmplitude)) {
+            state->markSampleNum = n - 1;
+            state->markAmplitude = y1;
+            state->countSinceMark = 0;
+        }
+        else {
+            state->countSinceMark += 1;
+        }
+    }
+    else if(state->isMarkPending) {
+        state->countSinceMark += 1;
+    }
+
+    // classify the pending mark once no larger peak can replace it
+    if(state->isMarkPending && (state->countSinceMark >= QRS_MIN_MARK_SPACING)) {
+        state->isMarkPending = false;
+
+        if(n >= QRS_CALIB_NUM_SAMP) {               // marks found during calibration are discarded
+            isNewInterval = classifyMark(state, rrIntervalPtr);
+        }
+    }
+
+    return isNewInterval;
+}
+
+static bool classifyMark(QrsDecisionState_t * state, uint32_t * rrIntervalPtr) {
+    bool isNewInterval = false;
+    float32_t peakAmplitude = state->markAmplitude;
+
+    if(IS_GREATER(peakAmplitude, state->threshold)) {
+        state->signalLevel = updateLevel(peakAmplitude, state->signalLevel);
+
+        if(state->hasPrevBeat) {
+            *rrIntervalPtr = state->markSampleNum - state->prevBeatSampleNum;
+            isNewInterval = true;
+        }
+
+        state->prevBeatSampleNum = state->markSampleNum;
+        state->hasPrevBeat = true;
+    }
+    else {
+        state->noiseLevel = updateLevel(peakAmplitude, state->noiseLevel);
+    }
+
+    state->threshold = updateThreshold(state->signalLevel, state->noiseLevel);
+
+    return isNewInterval;
+}
+
 /** @} */               // Implementation-specific Functions
 
 /** @} */               // qrs
@@ -11,16 +11,132 @@
 #define QRS_H
 
 #include "arm_math_types.h"
+#include "dsp/filtering_functions.h"
+
 #include <stdbool.h>
+#include <stdint.h>
 
 #define QRS_SAMP_FREQ       ((uint32_t) 200)                     // [Hz]
 #define QRS_SAMP_PERIOD_SEC ((float32_t) 0.005f)
-#define QRS_NUM_SAMP        ((uint16_t) (1 << 11))               // num. samples to process
+
+#ifndef QRS_NUM_SAMP
+#define QRS_NUM_SAMP ((uint16_t) (1 << 11))               // num. samples to process per block
+#endif
+
+#define QRS_MIN_MARK_SPACING ((uint16_t) 40)                // 200 [ms] @ fs = 200 [Hz]
+
+/// max. num. of QRS complexes that can be confirmed during one block
+#define QRS_MAX_BEATS_PER_BLOCK ((QRS_NUM_SAMP / QRS_MIN_MARK_SPACING) + 1)
+
+/// gain (as a left shift) applied when squaring in QRS_Preprocess_q15() to keep small slopes
+#define QRS_Q15_SQUARE_GAIN_SHIFT 8
+
+/*******************************************************************************
+Detector Instances
+********************************************************************************/
+
+/// @brief  Sizes of the buffers held by each detector.
+enum QRS_DETECTOR_SIZES {
+    QRS_NUM_STAGES_BANDPASS = 4,                                ///< num. bandpass biquad stages
+    QRS_STATE_BUFF_SIZE_BANDPASS = QRS_NUM_STAGES_BANDPASS * 4,
+
+    QRS_NUM_COEFF_DERFILT = 5,
+    QRS_STATE_BUFF_SIZE_DERFILT = QRS_NUM_COEFF_DERFILT - 1,    ///< previous 4 input samples
+
+    QRS_NUM_COEFF_MOVAVG = 10,
+    QRS_STATE_BUFF_SIZE_MOVAVG = QRS_NUM_COEFF_MOVAVG,          ///< last 10 squared samples
+
+    QRS_NUM_RR_INTERVALS = 8,                                   ///< num. RR intervals to average
+};
+
+/// @brief  State of the decision rules, carried from one sample (and one block) to the next.
+typedef struct {
+    uint32_t sampleNum;                                     ///< num. of samples processed so far
+    float32_t calibMax;                                     ///< max. value during calibration
+    float32_t calibSum;                                     ///< sum of values during calibration
+
+    float32_t signalLevel;                                  ///< estimated signal level
+    float32_t noiseLevel;                                   ///< estimated noise level
+    float32_t threshold;                                    ///< amplitude threshold
+
+    float32_t prevSamples[2];                               ///< \f$ y[n-1] \f$ and \f$ y[n-2] \f$
+
+    bool isMarkPending;                                     ///< `true` if a mark is unconfirmed
+    uint32_t markSampleNum;                                 ///< sample num. of pending mark
+    float32_t markAmplitude;                                ///< amplitude of pending mark
+    uint16_t countSinceMark;                                ///< samples checked since pending mark
+
+    bool hasPrevBeat;                                       ///< `true` after the first beat
+    uint32_t prevBeatSampleNum;                             ///< sample num. of previous beat
+} QrsDecisionState_t;
+
+/// @brief  State of the block-based decision rules.
+typedef struct {
+    QrsDecisionState_t rules;                               ///< carried between blocks
+    float32_t heartRateSum;                                 ///< sum of HRs in current block
+    uint16_t numIntervals;                                  ///< num. RR intervals in current block
+    float32_t heartRate;                                    ///< most recent average HR in [bpm]
+} QrsBlockState_t;
+
+/// @brief  State of the preprocessing filters (bandpass, derivative, square, and integration).
+typedef struct {
+    float32_t bandpassState[QRS_STATE_BUFF_SIZE_BANDPASS];  ///< 4 values per stage
+    float32_t derivativeState[QRS_STATE_BUFF_SIZE_DERFILT]; ///< newest first
+    float32_t movingAverageState[QRS_STATE_BUFF_SIZE_MOVAVG];
+    float32_t movingAverageSum;                             ///< sum of `movingAverageState`
+    uint8_t movingAverageIdx;                               ///< idx of oldest squared sample
+} QrsFilterState_t;
+
+/// @brief  Fixed-point version of @ref QrsFilterState_t (the bandpass filter is kept separately).
+typedef struct {
+    q15_t derivativeState[QRS_STATE_BUFF_SIZE_DERFILT];     ///< newest first
+    q15_t movingAverageState[QRS_STATE_BUFF_SIZE_MOVAVG];
+    int32_t movingAverageSum;                               ///< sum of `movingAverageState`
+    uint8_t movingAverageIdx;                               ///< idx of oldest squared sample
+} QrsFilterState_q15_t;
+
+/**
+ * @brief   Storage for one floating-point QRS detector.
+ *
+ * @details The type is complete so that the caller can provide the storage (e.g. as a `static`
+ *          variable, or one per thread on the host). Its members should only be accessed through
+ *          the `QRS_Detector*()` functions.
+ */
+typedef struct {
+    // block-based processing
+    QrsFilterState_t filters;
+    QrsBlockState_t block;
+
+    // streaming (uses separate filters so that both modes can coexist)
+    QrsFilterState_t streamFilters;
+    QrsDecisionState_t streamRules;
+    uint16_t rrBuffer[QRS_NUM_RR_INTERVALS];                ///< recent RR intervals in [samples]
+    uint8_t rrIdx;                                          ///< idx of next RR interval to replace
+    uint8_t numIntervals;                                   ///< num. RR intervals in `rrBuffer`
+} QrsDetectorStruct_t;
+
+typedef QrsDetectorStruct_t * QrsDetector_t;
+
+/// @brief  Storage for one fixed-point QRS detector. See @ref QrsDetectorStruct_t.
+typedef struct {
+    arm_biquad_casd_df1_inst_q31 bandpassFilter;
+    q31_t bandpassState[QRS_STATE_BUFF_SIZE_BANDPASS];
+    QrsFilterState_q15_t filters;
+    QrsBlockState_t block;
+} QrsDetectorStruct_q15_t;
+
+typedef QrsDetectorStruct_q15_t * QrsDetector_q15_t;
+
+/*******************************************************************************
+Default Instance
+********************************************************************************/
+/** @name Default Instance */               /// @{
 
 /**
  * @brief                   Initialize the QRS detector.
- * @note                    This function isn't necessary anymore, but I'm keeping it here
- *                          just in case.
+ * @post                    The default detector's filters and decision state are reset.
+ * @note                    The default detector is initialized on first use, so the other
+ *                          functions do not require this to be called.
  */
 void QRS_Init(void);
 
@@ -50,16 +166,164 @@ void QRS_Preprocess(const float32_t xn[], float32_t yn[]);
  * @param[out] heartRate    Average heart rate in [bpm].
  *
  * @post                    Certain information (signal/noise levels, thresholds, etc.) is retained
- *                          between calls and used to improve further detection.
- *
- * @bug                     The current implementation processes one block of data at a time and
- *                          discards the entire block immediately after. As a result, QRS complexes
- *                          that are cutoff between one block and another are not being counted.
+ *                          between calls and used to improve further detection. This includes the
+ *                          end of the current block and the last confirmed peak, so QRS complexes
+ *                          and RR intervals that span two blocks are counted exactly once.
+ * @note                    If no RR interval is completed during the block, the previous heart
+ *                          rate is returned.
  *
  * @see                     QRS_Preprocess()
  */
 float32_t QRS_applyDecisionRules(const float32_t yn[]);
 
+/**
+ * @brief                   Fixed-point version of QRS_Preprocess().
+ *
+ * @pre                     Fill input buffer `xn` with `q15_t` ECG data (e.g. from
+ *                          DAQ_convertToQ15()).
+ *
+ * @param[in] xn            Array of raw ECG signal values.
+ * @param[in] yn            Array used to store preprocessed ECG signal values.
+ *
+ * @post                    The preprocessed signal data \f$y[n]\f$ is stored in `yn` and is ready
+ *                          to be analyzed by QRS_applyDecisionRules_q15().
+ * @post                    The squared signal is scaled up by \f$ 2^{8} \f$ (see
+ *                          @ref QRS_Q15_SQUARE_GAIN_SHIFT) so that it keeps enough resolution in
+ *                          `q15_t`. Large values saturate instead of overflowing.
+ *
+ * @see                     QRS_Preprocess(), QRS_applyDecisionRules_q15()
+ */
+void QRS_Preprocess_q15(const q15_t xn[], q15_t yn[]);
+
+/**
+ * @brief                   Fixed-point version of QRS_applyDecisionRules().
+ *
+ * @pre                     Preprocess the raw ECG data with QRS_Preprocess_q15().
+ *
+ * @param[in] yn            Array of preprocessed ECG signal values.
+ * @param[out] heartRate    Average heart rate in [bpm].
+ *
+ * @post                    The detector state is kept separate from QRS_applyDecisionRules(), so
+ *                          the two versions can be used side by side.
+ *
+ * @see                     QRS_applyDecisionRules(), QRS_Preprocess_q15()
+ */
+float32_t QRS_applyDecisionRules_q15(const q15_t yn[]);
+
+/**
+ * @brief                   Process a single ECG sample and check for a newly confirmed beat.
+ *
+ * @details                 This is the streaming counterpart to QRS_Preprocess() and
+ *                          QRS_applyDecisionRules(). The filter states, the signal/noise levels,
+ *                          and the threshold are retained between calls, so the work is spread
+ *                          evenly across samples instead of being done once per block.
+ *
+ * @pre                     Initialize the QRS detector.
+ *
+ * @param[in] xn            Raw or lightly preprocessed ECG sample.
+ * @param[out] heartRatePtr Heart rate in [bpm]. Only written to when `true` is returned.
+ * @param[out] true         A QRS complex was confirmed, and the heart rate was updated.
+ * @param[out] false        No new QRS complex was confirmed.
+ *
+ * @post                    A peak is confirmed 200 [ms] after it occurs, since any larger peak
+ *                          within that window takes its place.
+ * @note                    The first 2 [s] of input are used to calibrate the detector, and the
+ *                          first confirmed beat is only used as a reference for the next one.
+ *
+ * @see                     QRS_Init()
+ */
+bool QRS_ProcessSample(float32_t xn, float32_t * heartRatePtr);
+
+/**
+ * @brief                   Get the preprocessed (i.e. integrated) value of the last sample passed
+ *                          to QRS_ProcessSample().
+ *
+ * @param[out] float32_t    Output of the moving-window integrator.
+ */
+float32_t QRS_getIntegratedSample(void);
+
+/**
+ * @brief                   Get the sample num. of the last beat confirmed by QRS_ProcessSample().
+ *
+ * @param[out] uint32_t     Sample num. of the QRS complex in the integrated signal, counting from
+ *                          the first sample. It includes the preprocessing delay.
+ */
+uint32_t QRS_getBeatSampleNum(void);
+
+/** @} */               // Default Instance
+
+/*******************************************************************************
+Reentrant Interface
+********************************************************************************/
+/** @name Reentrant Interface */               /// @{
+
+/**
+ * @brief                   Initialize a QRS detector in caller-provided storage.
+ *
+ * @param[in] detectorStruct    Storage for the detector. It does not need to be zeroed first.
+ * @param[out] detector     Handle to the detector.
+ *
+ * @post                    The detector's filters are set up and all of its state is reset.
+ * @note                    Each detector only uses its own storage, so different detectors can be
+ *                          used from different threads or interrupts without locking.
+ *
+ * @see                     QRS_Init()
+ */
+QrsDetector_t QRS_DetectorInit(QrsDetectorStruct_t * detectorStruct);
+
+/**
+ * @brief                   Reset the filters and decision state of a QRS detector.
+ * @param[in] detector      Handle to an initialized detector.
+ */
+void QRS_DetectorReset(QrsDetector_t detector);
+
+/// @brief                  Same as QRS_Preprocess(), but for the given detector.
+void QRS_DetectorPreprocess(QrsDetector_t detector, const float32_t xn[], float32_t yn[]);
+
+/// @brief                  Same as QRS_applyDecisionRules(), but for the given detector.
+float32_t QRS_DetectorApplyDecisionRules(QrsDetector_t detector, const float32_t yn[]);
+
+/**
+ * @brief                   Same as QRS_DetectorApplyDecisionRules(), but also reports where each
+ *                          QRS complex was found.
+ *
+ * @param[in] detector      Handle to an initialized detector.
+ * @param[in] yn            Array of preprocessed ECG signal values.
+ * @param[out] beatSampleNums   Array of at least @ref QRS_MAX_BEATS_PER_BLOCK elements, used to
+ *                              store the sample number of each QRS complex confirmed during this
+ *                              block. Sample numbers count from the detector's first sample of
+ *                              \f$ y[n] \f$, so they include the preprocessing delay.
+ * @param[out] numBeatsPtr  Number of values written to `beatSampleNums`.
+ * @param[out] heartRate    Average heart rate in [bpm].
+ *
+ * @note                    This is intended for offline evaluation against annotated recordings.
+ */
+float32_t QRS_DetectorFindBeats(QrsDetector_t detector, const float32_t yn[],
+                                uint32_t beatSampleNums[], uint16_t * numBeatsPtr);
+
+/// @brief                  Same as QRS_ProcessSample(), but for the given detector.
+bool QRS_DetectorProcessSample(QrsDetector_t detector, float32_t xn, float32_t * heartRatePtr);
+
+/// @brief                  Same as QRS_getIntegratedSample(), but for the given detector.
+float32_t QRS_DetectorGetIntegratedSample(QrsDetector_t detector);
+
+/// @brief                  Same as QRS_getBeatSampleNum(), but for the given detector.
+uint32_t QRS_DetectorGetBeatSampleNum(QrsDetector_t detector);
+
+/// @brief                  Same as QRS_DetectorInit(), but for a fixed-point detector.
+QrsDetector_q15_t QRS_DetectorInit_q15(QrsDetectorStruct_q15_t * detectorStruct);
+
+/// @brief                  Same as QRS_DetectorReset(), but for a fixed-point detector.
+void QRS_DetectorReset_q15(QrsDetector_q15_t detector);
+
+/// @brief                  Same as QRS_Preprocess_q15(), but for the given detector.
+void QRS_DetectorPreprocess_q15(QrsDetector_q15_t detector, const q15_t xn[], q15_t yn[]);
+
+/// @brief                  Same as QRS_applyDecisionRules_q15(), but for the given detector.
+float32_t QRS_DetectorApplyDecisionRules_q15(QrsDetector_q15_t detector, const q15_t yn[]);
+
+/** @} */               // Reentrant Interface
+
 #endif               // QRS_H
 
 /** @} */
@@ -17,6 +17,10 @@ SECTIONS
         Basic Operations (Float)
         Peeking
         Status Checks
+        Lock-Free Ring Buffer
+        Lock-Free Ring Buffer (Zero-Copy)
+        Lock-Free Ring Buffer (Instrumentation)
+        Broadcast Ring Buffer
 *******************************************************************************/
 
 #include "NewAssert.h"
@@ -187,4 +191,694 @@ uint32_t Fifo_getCurrSize(volatile Fifo_t fifo) {
     return size;
 }
 
+/******************************************************************************
+Lock-Free Ring Buffer
+*******************************************************************************/
+
+/**
+ * @name    Memory Ordering
+ * @brief   The other side's index is loaded with an acquire barrier, and this side's index is
+ *          stored with a release barrier, so data accesses can't be reordered across them. On the
+ *          Cortex-M4 each barrier is a `DMB` instruction.
+ */
+/// @{
+#define RING_LOAD_ACQUIRE(IDX_PTR)          __atomic_load_n((IDX_PTR), __ATOMIC_ACQUIRE)
+#define RING_STORE_RELEASE(IDX_PTR, VAL)    __atomic_store_n((IDX_PTR), (VAL), __ATOMIC_RELEASE)
+/// @}
+
+typedef struct RingFifoStruct_t {
+    uint8_t * buffer;                ///< (pointer to) array to use as ring buffer
+    uint32_t N;                      ///< length of `buffer` in elements (power of 2)
+    uint32_t mask;                   ///< `N - 1`, used to wrap indices
+    uint32_t elemSize;               ///< size of each element in bytes
+    uint32_t frontIdx;               ///< free-running idx of front; written by consumer
+    uint32_t backIdx;                ///< free-running idx of back; only written by producer
+    RingFifoPolicy_t policy;         ///< what the producer does when the ring is full
+#ifdef FIFO_RING_STATS
+    RingFifoStats_t stats;           ///< usage statistics
+#endif
+} RingFifoStruct_t;
+
+static RingFifoStruct_t ringPool[FIFO_RING_POOL_SIZE] = { 0 };               ///< pre-allocated pool
+static uint8_t numFreeRings = FIFO_RING_POOL_SIZE;
+
+/// @brief  Get a pointer to the element at free-running index `idx`.
+static inline uint8_t * getElemPtr(RingFifo_t ring, uint32_t idx) {
+    return &ring->buffer[(idx & ring->mask) * ring->elemSize];
+}
+
+/**
+ * @brief   Copy one element.
+ * @note    The common sizes use a constant-size `memcpy()`, which compiles to a single load/store
+ *          instead of a function call.
+ */
+static inline void copyElem(void * dest, const void * src, uint32_t elemSize) {
+    switch(elemSize) {
+        case sizeof(uint16_t):
+            memcpy(dest, src, sizeof(uint16_t));
+            break;
+        case sizeof(uint32_t):
+            memcpy(dest, src, sizeof(uint32_t));
+            break;
+        default:
+            memcpy(dest, src, elemSize);
+            break;
+    }
+    return;
+}
+
+/// @brief  Copy `numVals` elements into the ring, starting at free-running index `idx`.
+static inline void copyIntoRing(RingFifo_t ring, uint32_t idx, const uint8_t * input,
+                                uint32_t numVals) {
+    // copy up to the end of the array, then wrap around to the start
+    uint32_t firstSpan = ring->N - (idx & ring->mask);
+    firstSpan = (numVals < firstSpan) ? numVals : firstSpan;
+
+    memcpy(getElemPtr(ring, idx), input, firstSpan * ring->elemSize);
+    memcpy(&ring->buffer[0], &input[firstSpan * ring->elemSize],
+           (numVals - firstSpan) * ring->elemSize);
+    return;
+}
+
+/// @brief  Copy `numVals` elements out of the ring, starting at free-running index `idx`.
+static inline void copyFromRing(RingFifo_t ring, uint32_t idx, uint8_t * output,
+                                uint32_t numVals) {
+    uint32_t firstSpan = ring->N - (idx & ring->mask);
+    firstSpan = (numVals < firstSpan) ? numVals : firstSpan;
+
+    memcpy(output, getElemPtr(ring, idx), firstSpan * ring->elemSize);
+    memcpy(&output[firstSpan * ring->elemSize], &ring->buffer[0],
+           (numVals - firstSpan) * ring->elemSize);
+    return;
+}
+
+/** @name Statistics */               /// @{
+
+/// @brief  Update the peak size. Only called by the producer.
+static inline void recordSize(RingFifo_t ring, uint32_t size) {
+#ifdef FIFO_RING_STATS
+    if(size > ring->stats.peakSize) {
+        ring->stats.peakSize = size;
+    }
+#else
+    (void) ring;
+    (void) size;
+#endif
+    return;
+}
+
+/// @brief  Count values discarded because the ring was full. Only called by the producer.
+static inline void recordDrops(RingFifo_t ring, uint32_t numDropped) {
+#ifdef FIFO_RING_STATS
+    ring->stats.numDropped += numDropped;
+#else
+    (void) ring;
+    (void) numDropped;
+#endif
+    return;
+}
+
+/// @brief  Count a read from an empty ring. Only called by the consumer.
+static inline void recordUnderflow(RingFifo_t ring) {
+#ifdef FIFO_RING_STATS
+    ring->stats.numUnderflows += 1;
+#else
+    (void) ring;
+#endif
+    return;
+}
+
+/** @} */               // Statistics
+
+/** @name Overflow Policy */               /// @{
+
+/**
+ * @brief                   Apply the overflow policy when there isn't room for `numVals` values.
+ *
+ * @param[in] ring          Pointer to the ring buffer.
+ * @param[in] backIdx       Producer's current back index.
+ * @param[in] frontIdxPtr   Pointer to the front index the producer loaded. Updated if values are
+ *                          dropped (or the consumer removed some in the meantime).
+ * @param[in] numVals       Number of values to add. Must be `<= N`.
+ * @param[out] numPut       Number of values that can now be added.
+ */
+static uint32_t handleOverflow(RingFifo_t ring, uint32_t backIdx, uint32_t * frontIdxPtr,
+                               uint32_t numVals) {
+    uint32_t frontIdx = *frontIdxPtr;
+    uint32_t numFree = ring->N - (backIdx - frontIdx);
+
+    switch(ring->policy) {
+        case RING_FIFO_DROP_OLDEST: {
+            /**
+             * The front index is moved with a compare-and-swap, since the consumer may be
+             * removing the same values at the same time. If the consumer wins, the front index
+             * is reloaded and only the values still needed are dropped.
+             */
+            uint32_t newFrontIdx = backIdx + numVals - ring->N;
+            while((int32_t) (newFrontIdx - frontIdx) > 0) {
+                if(__atomic_compare_exchange_n(&ring->frontIdx, &frontIdx, newFrontIdx, false,
+                                               __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE)) {
+                    recordDrops(ring, newFrontIdx - frontIdx);
+                    frontIdx = newFrontIdx;
+                }
+            }
+            numFree = numVals;
+            break;
+        }
+        case RING_FIFO_ASSERT:
+            assert(false);
+            numFree = 0;
+            break;
+        case RING_FIFO_DROP_NEWEST:
+        default:
+            recordDrops(ring, numVals - numFree);
+            break;
+    }
+
+    *frontIdxPtr = frontIdx;
+    return numFree;
+}
+
+/**
+ * @brief               Get the number of values the producer can add, applying the overflow
+ *                      policy if needed.
+ *
+ * @param[in] ring      Pointer to the ring buffer.
+ * @param[in] backIdx   Producer's current back index.
+ * @param[in] numVals   Number of values to add. Must be `<= N`.
+ * @param[out] numPut   Number of values that can be added.
+ */
+static inline uint32_t makeRoom(RingFifo_t ring, uint32_t backIdx, uint32_t numVals) {
+    uint32_t frontIdx = RING_LOAD_ACQUIRE(&ring->frontIdx);               // space is released
+
+    if((backIdx - frontIdx + numVals) > ring->N) {
+        numVals = handleOverflow(ring, backIdx, &frontIdx, numVals);
+    }
+    recordSize(ring, (backIdx - frontIdx) + numVals);
+
+    return numVals;
+}
+
+/**
+ * @brief               Load the front index on the consumer's side.
+ * @note                This is a plain load on the Cortex-M4. It is only atomic because the
+ *                      producer may also move the front index (@ref RING_FIFO_DROP_OLDEST).
+ */
+static inline uint32_t loadFront(RingFifo_t ring) {
+    return __atomic_load_n(&ring->frontIdx, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief               Remove `numVals` values that the consumer has already copied.
+ *
+ * @param[in] ring      Pointer to the ring buffer.
+ * @param[in] frontIdx  Front index that the values were copied from.
+ * @param[in] numVals   Number of values to remove.
+ * @param[out] true     The values were removed.
+ * @param[out] false    The producer dropped them first (and may have overwritten them), so the
+ *                      copy must be redone.
+ */
+static inline bool releaseFront(RingFifo_t ring, uint32_t frontIdx, uint32_t numVals) {
+    bool isReleased = true;
+
+    if(ring->policy == RING_FIFO_DROP_OLDEST) {
+        isReleased = __atomic_compare_exchange_n(&ring->frontIdx, &frontIdx, frontIdx + numVals,
+                                                 false, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+    }
+    else {
+        RING_STORE_RELEASE(&ring->frontIdx, frontIdx + numVals);               // release space
+    }
+
+    return isReleased;
+}
+
+/** @} */               // Overflow Policy
+
+RingFifo_t RingFifo_Init(uint32_t buffer[], const uint32_t N) {
+    return RingFifo_InitElem(buffer, N, sizeof(uint32_t));
+}
+
+RingFifo_t RingFifo_InitElem(void * buffer, const uint32_t N, const uint32_t elemSize) {
+    assert(numFreeRings > 0);
+    assert((N > 0) && ((N & (N - 1)) == 0));               // power of 2
+    assert(elemSize > 0);
+
+    numFreeRings -= 1;
+    RingFifo_t ring = &(ringPool[numFreeRings]);
+
+    ring->buffer = (uint8_t *) buffer;
+    ring->N = N;
+    ring->mask = N - 1;
+    ring->elemSize = elemSize;
+    ring->frontIdx = 0;
+    ring->backIdx = 0;
+    ring->policy = RING_FIFO_DROP_NEWEST;
+    RingFifo_resetStats(ring);
+
+    return ring;
+}
+
+void RingFifo_Reset(RingFifo_t ring) {
+    RING_STORE_RELEASE(&ring->frontIdx, RING_LOAD_ACQUIRE(&ring->backIdx));
+    return;
+}
+
+bool RingFifo_Put(RingFifo_t ring, const uint32_t val) {
+    // NOTE: same as RingFifo_PutElem(), but without the element size lookup
+    assert(ring->elemSize == sizeof(uint32_t));
+
+    uint32_t backIdx = ring->backIdx;               // only written here
+
+    bool isFree = (bool) (makeRoom(ring, backIdx, 1) > 0);
+    if(isFree) {
+        ((uint32_t *) ring->buffer)[backIdx & ring->mask] = val;
+        RING_STORE_RELEASE(&ring->backIdx, backIdx + 1);               // publish data
+    }
+
+    return isFree;
+}
+
+bool RingFifo_Get(RingFifo_t ring, uint32_t * valPtr) {
+    // NOTE: same as RingFifo_GetElem(), but without the element size lookup
+    assert(ring->elemSize == sizeof(uint32_t));
+
+    uint32_t frontIdx;
+    bool isUsed;
+
+    do {
+        frontIdx = loadFront(ring);
+        uint32_t backIdx = RING_LOAD_ACQUIRE(&ring->backIdx);               // data is visible
+        isUsed = (bool) (backIdx != frontIdx);
+        if(isUsed == false) {
+            recordUnderflow(ring);
+            break;
+        }
+        *valPtr = ((uint32_t *) ring->buffer)[frontIdx & ring->mask];
+    } while(releaseFront(ring, frontIdx, 1) == false);
+
+    return isUsed;
+}
+
+uint32_t RingFifo_PutBlock(RingFifo_t ring, const uint32_t inputBuffer[], uint32_t numVals) {
+    assert(ring->elemSize == sizeof(uint32_t));
+    return RingFifo_PutElems(ring, inputBuffer, numVals);
+}
+
+uint32_t RingFifo_GetBlock(RingFifo_t ring, uint32_t outputBuffer[], uint32_t numVals) {
+    assert(ring->elemSize == sizeof(uint32_t));
+    return RingFifo_GetElems(ring, outputBuffer, numVals);
+}
+
+bool RingFifo_PutElem(RingFifo_t ring, const void * valPtr) {
+    uint32_t backIdx = ring->backIdx;               // only written here
+
+    bool isFree = (bool) (makeRoom(ring, backIdx, 1) > 0);
+    if(isFree) {
+        copyElem(getElemPtr(ring, backIdx), valPtr, ring->elemSize);
+        RING_STORE_RELEASE(&ring->backIdx, backIdx + 1);               // publish data
+    }
+
+    return isFree;
+}
+
+bool RingFifo_GetElem(RingFifo_t ring, void * valPtr) {
+    uint32_t frontIdx;
+    bool isUsed;
+
+    do {
+        frontIdx = loadFront(ring);
+        uint32_t backIdx = RING_LOAD_ACQUIRE(&ring->backIdx);               // data is visible
+        isUsed = (bool) (backIdx != frontIdx);
+        if(isUsed == false) {
+            recordUnderflow(ring);
+            break;
+        }
+        copyElem(valPtr, getElemPtr(ring, frontIdx), ring->elemSize);
+    } while(releaseFront(ring, frontIdx, 1) == false);
+
+    return isUsed;
+}
+
+uint32_t RingFifo_PutElems(RingFifo_t ring, const void * inputBuffer, uint32_t numVals) {
+    uint32_t backIdx = ring->backIdx;               // only written here
+    const uint8_t * input = (const uint8_t *) inputBuffer;
+
+    if((numVals > ring->N) && (ring->policy == RING_FIFO_DROP_OLDEST)) {
+        // only the newest `N` values can fit
+        recordDrops(ring, numVals - ring->N);
+        input = &input[(numVals - ring->N) * ring->elemSize];
+        numVals = ring->N;
+    }
+    else if(numVals > ring->N) {
+        recordDrops(ring, numVals - ring->N);               // never fit, regardless of policy
+        numVals = ring->N;
+    }
+    numVals = makeRoom(ring, backIdx, numVals);
+
+    if(numVals > 0) {
+        copyIntoRing(ring, backIdx, input, numVals);
+        RING_STORE_RELEASE(&ring->backIdx, backIdx + numVals);               // publish data
+    }
+
+    return numVals;
+}
+
+uint32_t RingFifo_GetElems(RingFifo_t ring, void * outputBuffer, uint32_t numVals) {
+    uint8_t * output = (uint8_t *) outputBuffer;
+    uint32_t maxVals = numVals;
+    uint32_t frontIdx;
+
+    do {
+        frontIdx = loadFront(ring);
+        uint32_t backIdx = RING_LOAD_ACQUIRE(&ring->backIdx);               // data is visible
+        uint32_t numUsed = backIdx - frontIdx;
+        numVals = (maxVals < numUsed) ? maxVals : numUsed;
+        if(numVals == 0) {
+            if(maxVals > 0) {
+                recordUnderflow(ring);
+            }
+            break;
+        }
+        copyFromRing(ring, frontIdx, output, numVals);
+    } while(releaseFront(ring, frontIdx, numVals) == false);
+
+    return numVals;
+}
+
+bool RingFifo_isFull(RingFifo_t ring) {
+    return (bool) (RingFifo_getCurrSize(ring) == ring->N);
+}
+
+bool RingFifo_isEmpty(RingFifo_t ring) {
+    return (bool) (RingFifo_getCurrSize(ring) == 0);
+}
+
+uint32_t RingFifo_getCurrSize(RingFifo_t ring) {
+    return RING_LOAD_ACQUIRE(&ring->backIdx) - RING_LOAD_ACQUIRE(&ring->frontIdx);
+}
+
+/******************************************************************************
+Lock-Free Ring Buffer (Zero-Copy)
+*******************************************************************************/
+
+uint32_t RingFifo_ReserveWrite(RingFifo_t ring, uint32_t ** spanPtr, uint32_t maxVals) {
+    void * span;
+    uint32_t numFree = RingFifo_ReserveWriteElems(ring, &span, maxVals);
+    *spanPtr = (uint32_t *) span;
+    return numFree;
+}
+
+uint32_t RingFifo_ReserveWriteElems(RingFifo_t ring, void ** spanPtr, uint32_t maxVals) {
+    uint32_t backIdx = ring->backIdx;               // only written here
+    uint32_t frontIdx = RING_LOAD_ACQUIRE(&ring->frontIdx);               // space is released
+
+    // limit to free space, then to the end of the array
+    uint32_t numToEnd = ring->N - (backIdx & ring->mask);
+    uint32_t numFree = ring->N - (backIdx - frontIdx);
+    numFree = (numFree < numToEnd) ? numFree : numToEnd;
+
+    *spanPtr = getElemPtr(ring, backIdx);
+    return (maxVals < numFree) ? maxVals : numFree;
+}
+
+void RingFifo_CommitWrite(RingFifo_t ring, uint32_t numVals) {
+    uint32_t backIdx = ring->backIdx;
+    uint32_t numUsed = backIdx - RING_LOAD_ACQUIRE(&ring->frontIdx);
+    assert((numUsed + numVals) <= ring->N);
+    recordSize(ring, numUsed + numVals);
+
+    RING_STORE_RELEASE(&ring->backIdx, backIdx + numVals);               // publish data
+    return;
+}
+
+uint32_t RingFifo_PeekSpan(RingFifo_t ring, uint32_t ** spanPtr) {
+    void * span;
+    uint32_t numUsed = RingFifo_PeekSpanElems(ring, &span);
+    *spanPtr = (uint32_t *) span;
+    return numUsed;
+}
+
+uint32_t RingFifo_PeekSpanElems(RingFifo_t ring, void ** spanPtr) {
+    // the producer could drop (and overwrite) the span while it's in use
+    assert(ring->policy != RING_FIFO_DROP_OLDEST);
+
+    uint32_t frontIdx = ring->frontIdx;               // only written here
+    uint32_t backIdx = RING_LOAD_ACQUIRE(&ring->backIdx);               // data is visible
+
+    // limit to used space, then to the end of the array
+    uint32_t numToEnd = ring->N - (frontIdx & ring->mask);
+    uint32_t numUsed = backIdx - frontIdx;
+
+    *spanPtr = getElemPtr(ring, frontIdx);
+    return (numUsed < numToEnd) ? numUsed : numToEnd;
+}
+
+void RingFifo_Release(RingFifo_t ring, uint32_t numVals) {
+    uint32_t frontIdx = ring->frontIdx;
+    assert(numVals <= (RING_LOAD_ACQUIRE(&ring->backIdx) - frontIdx));
+
+    RING_STORE_RELEASE(&ring->frontIdx, frontIdx + numVals);               // release space
+    return;
+}
+
+/******************************************************************************
+Lock-Free Ring Buffer (Instrumentation)
+*******************************************************************************/
+
+void RingFifo_setOverflowPolicy(RingFifo_t ring, RingFifoPolicy_t policy) {
+    ring->policy = policy;
+    return;
+}
+
+void RingFifo_getStats(RingFifo_t ring, RingFifoStats_t * statsPtr) {
+#ifdef FIFO_RING_STATS
+    *statsPtr = ring->stats;
+#else
+    *statsPtr = (RingFifoStats_t){ 0 };
+#endif
+    statsPtr->N = ring->N;
+    return;
+}
+
+void RingFifo_resetStats(RingFifo_t ring) {
+#ifdef FIFO_RING_STATS
+    ring->stats = (RingFifoStats_t){ 0 };
+#else
+    (void) ring;
+#endif
+    return;
+}
+
+/******************************************************************************
+Broadcast Ring Buffer
+*******************************************************************************/
+
+typedef struct BroadcastReaderStruct_t {
+    BroadcastFifo_t fifo;                ///< ring buffer being read
+    uint32_t frontIdx;                   ///< free-running idx of front; only written by reader
+#ifdef FIFO_RING_STATS
+    RingFifoStats_t stats;               ///< `peakSize` is the reader's peak lag
+#endif
+} BroadcastReaderStruct_t;
+
+typedef struct BroadcastFifoStruct_t {
+    RingFifoStruct_t ring;               ///< buffer and back idx (`ring.frontIdx` is unused)
+    uint32_t numReaders;                 ///< num. readers in use
+    BroadcastReaderStruct_t readers[FIFO_BROADCAST_MAX_READERS];
+} BroadcastFifoStruct_t;
+
+/// pre-allocated pool
+static BroadcastFifoStruct_t broadcastPool[FIFO_BROADCAST_POOL_SIZE] = { 0 };
+static uint8_t numFreeBroadcasts = FIFO_BROADCAST_POOL_SIZE;
+
+/**
+ * @brief               Get the number of values the slowest reader hasn't read yet.
+ * @note                Only called by the producer.
+ */
+static inline uint32_t getMaxLag(BroadcastFifo_t fifo, uint32_t backIdx) {
+    uint32_t maxLag = 0;
+    uint32_t numReaders = RING_LOAD_ACQUIRE(&fifo->numReaders);
+
+    for(uint32_t idx = 0; idx < numReaders; idx++) {
+        // space is released
+        uint32_t lag = backIdx - RING_LOAD_ACQUIRE(&fifo->readers[idx].frontIdx);
+        maxLag = (lag > maxLag) ? lag : maxLag;
+    }
+
+    return maxLag;
+}
+
+/// @brief  Update the reader's peak lag and underflow count. Only called by the reader.
+static inline void recordRead(BroadcastReader_t reader, uint32_t lag, uint32_t maxVals) {
+#ifdef FIFO_RING_STATS
+    if(lag > reader->stats.peakSize) {
+        reader->stats.peakSize = lag;
+    }
+    if((lag == 0) && (maxVals > 0)) {
+        reader->stats.numUnderflows += 1;
+    }
+#else
+    (void) reader;
+    (void) lag;
+    (void) maxVals;
+#endif
+    return;
+}
+
+BroadcastFifo_t BroadcastFifo_Init(void * buffer, const uint32_t N, const uint32_t elemSize) {
+    assert(numFreeBroadcasts > 0);
+    assert((N > 0) && ((N & (N - 1)) == 0));               // power of 2
+    assert(elemSize > 0);
+
+    numFreeBroadcasts -= 1;
+    BroadcastFifo_t fifo = &(broadcastPool[numFreeBroadcasts]);
+
+    fifo->ring.buffer = (uint8_t *) buffer;
+    fifo->ring.N = N;
+    fifo->ring.mask = N - 1;
+    fifo->ring.elemSize = elemSize;
+    fifo->ring.frontIdx = 0;
+    fifo->ring.backIdx = 0;
+    fifo->ring.policy = RING_FIFO_DROP_NEWEST;
+    fifo->numReaders = 0;
+    RingFifo_resetStats(&fifo->ring);
+
+    return fifo;
+}
+
+BroadcastReader_t BroadcastFifo_AddReader(BroadcastFifo_t fifo) {
+    assert(fifo->numReaders < FIFO_BROADCAST_MAX_READERS);
+
+    BroadcastReader_t reader = &(fifo->readers[fifo->numReaders]);
+    reader->fifo = fifo;
+    reader->frontIdx = RING_LOAD_ACQUIRE(&fifo->ring.backIdx);               // starts out empty
+    BroadcastFifo_resetReaderStats(reader);
+
+    RING_STORE_RELEASE(&fifo->numReaders, fifo->numReaders + 1);               // publish reader
+    return reader;
+}
+
+bool BroadcastFifo_Put(BroadcastFifo_t fifo, const void * valPtr) {
+    RingFifo_t ring = &fifo->ring;
+    uint32_t backIdx = ring->backIdx;               // only written here
+    uint32_t numUsed = getMaxLag(fifo, backIdx);
+
+    bool isFree = (bool) (numUsed != ring->N);
+    if(isFree) {
+        recordSize(ring, numUsed + 1);
+        copyElem(getElemPtr(ring, backIdx), valPtr, ring->elemSize);
+        RING_STORE_RELEASE(&ring->backIdx, backIdx + 1);               // publish data
+    }
+    else {
+        recordDrops(ring, 1);
+    }
+
+    return isFree;
+}
+
+uint32_t BroadcastFifo_PutBlock(BroadcastFifo_t fifo, const void * inputBuffer, uint32_t numVals) {
+    RingFifo_t ring = &fifo->ring;
+    uint32_t backIdx = ring->backIdx;               // only written here
+    uint32_t numUsed = getMaxLag(fifo, backIdx);
+
+    uint32_t numFree = ring->N - numUsed;
+    if(numVals > numFree) {
+        recordDrops(ring, numVals - numFree);
+        numVals = numFree;
+    }
+    recordSize(ring, numUsed + numVals);
+
+    if(numVals > 0) {
+        copyIntoRing(ring, backIdx, (const uint8_t *) inputBuffer, numVals);
+        RING_STORE_RELEASE(&ring->backIdx, backIdx + numVals);               // publish data
+    }
+
+    return numVals;
+}
+
+bool BroadcastFifo_Get(BroadcastReader_t reader, void * valPtr) {
+    RingFifo_t ring = &reader->fifo->ring;
+    uint32_t frontIdx = reader->frontIdx;               // only written here
+    uint32_t backIdx = RING_LOAD_ACQUIRE(&ring->backIdx);               // data is visible
+    recordRead(reader, backIdx - frontIdx, 1);
+
+    bool isUsed = (bool) (backIdx != frontIdx);
+    if(isUsed) {
+        copyElem(valPtr, getElemPtr(ring, frontIdx), ring->elemSize);
+        RING_STORE_RELEASE(&reader->frontIdx, frontIdx + 1);               // release space
+    }
+
+    return isUsed;
+}
+
+uint32_t BroadcastFifo_GetBlock(BroadcastReader_t reader, void * outputBuffer, uint32_t numVals) {
+    RingFifo_t ring = &reader->fifo->ring;
+    uint32_t frontIdx = reader->frontIdx;               // only written here
+    uint32_t backIdx = RING_LOAD_ACQUIRE(&ring->backIdx);               // data is visible
+    uint32_t numUsed = backIdx - frontIdx;
+    recordRead(reader, numUsed, numVals);
+
+    numVals = (numVals < numUsed) ? numVals : numUsed;
+    if(numVals > 0) {
+        copyFromRing(ring, frontIdx, (uint8_t *) outputBuffer, numVals);
+        RING_STORE_RELEASE(&reader->frontIdx, frontIdx + numVals);               // release space
+    }
+
+    return numVals;
+}
+
+uint32_t BroadcastFifo_PeekSpan(BroadcastReader_t reader, void ** spanPtr) {
+    RingFifo_t ring = &reader->fifo->ring;
+    uint32_t frontIdx = reader->frontIdx;               // only written here
+    uint32_t backIdx = RING_LOAD_ACQUIRE(&ring->backIdx);               // data is visible
+    uint32_t numUsed = backIdx - frontIdx;
+
+    // limit to the end of the array
+    uint32_t numToEnd = ring->N - (frontIdx & ring->mask);
+
+    *spanPtr = getElemPtr(ring, frontIdx);
+    return (numUsed < numToEnd) ? numUsed : numToEnd;
+}
+
+void BroadcastFifo_Release(BroadcastReader_t reader, uint32_t numVals) {
+    uint32_t frontIdx = reader->frontIdx;
+    assert(numVals <= (RING_LOAD_ACQUIRE(&reader->fifo->ring.backIdx) - frontIdx));
+
+    RING_STORE_RELEASE(&reader->frontIdx, frontIdx + numVals);               // release space
+    return;
+}
+
+uint32_t BroadcastFifo_getLag(BroadcastReader_t reader) {
+    return RING_LOAD_ACQUIRE(&reader->fifo->ring.backIdx) - RING_LOAD_ACQUIRE(&reader->frontIdx);
+}
+
+void BroadcastFifo_getStats(BroadcastFifo_t fifo, RingFifoStats_t * statsPtr) {
+    RingFifo_getStats(&fifo->ring, statsPtr);
+    return;
+}
+
+void BroadcastFifo_getReaderStats(BroadcastReader_t reader, RingFifoStats_t * statsPtr) {
+#ifdef FIFO_RING_STATS
+    *statsPtr = reader->stats;
+#else
+    *statsPtr = (RingFifoStats_t){ 0 };
+#endif
+    statsPtr->N = reader->fifo->ring.N;
+    return;
+}
+
+void BroadcastFifo_resetStats(BroadcastFifo_t fifo) {
+    RingFifo_resetStats(&fifo->ring);
+    return;
+}
+
+void BroadcastFifo_resetReaderStats(BroadcastReader_t reader) {
+#ifdef FIFO_RING_STATS
+    reader->stats = (RingFifoStats_t){ 0 };
+#else
+    (void) reader;
+#endif
+    return;
+}
+
 /** @} */
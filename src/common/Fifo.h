@@ -18,6 +18,11 @@ SECTIONS
         Basic Operations (Float)
         Peeking
         Status Checks
+        Lock-Free Ring Buffer
+        Lock-Free Ring Buffer (Zero-Copy)
+        Lock-Free Ring Buffer (Instrumentation)
+        Lock-Free Ring Buffer (Any Type)
+        Broadcast Ring Buffer
 *******************************************************************************/
 
 /******************************************************************************
@@ -33,6 +38,23 @@ Preprocessor Directives
 #define FIFO_POOL_SIZE 5               // default val
 #endif
 
+// Same for the number of pre-allocated lock-free ring buffers
+#ifndef FIFO_RING_POOL_SIZE
+#define FIFO_RING_POOL_SIZE 5               // default val
+#endif
+
+// Same for the number of pre-allocated broadcast ring buffers, and the max. number of readers each
+#ifndef FIFO_BROADCAST_POOL_SIZE
+#define FIFO_BROADCAST_POOL_SIZE 2               // default val
+#endif
+
+#ifndef FIFO_BROADCAST_MAX_READERS
+#define FIFO_BROADCAST_MAX_READERS 3               // default val
+#endif
+
+// Ring buffer statistics are only collected if `FIFO_RING_STATS` is defined
+// (e.g. via the `OPT_FIFO_STATS` CMake option)
+
 /******************************************************************************
 Initialization
 *******************************************************************************/
@@ -231,6 +253,526 @@ uint32_t Fifo_getCurrSize(volatile Fifo_t fifo);
 
 /** @} */               // Status Checks
 
+/******************************************************************************
+Lock-Free Ring Buffer
+*******************************************************************************/
+/** @name Lock-Free Ring Buffer */               /// @{
+
+/**
+ * @details     This is a variant of @ref Fifo_t meant for passing data between exactly one
+ *              producer and exactly one consumer (e.g. an ISR and a thread, or two ISRs), without
+ *              disabling interrupts or taking a lock.
+ *
+ *              - The length must be a power of 2, so the indices wrap with a bitmask instead
+ *                of a `%` (which needs a hardware divide on the Cortex-M4).
+ *              - The indices are free-running, so all `N` elements of the buffer are usable.
+ *              - Only the producer writes the back index, and only the consumer writes the
+ *                front index (unless the overflow policy is @ref RING_FIFO_DROP_OLDEST). Each side
+ *                publishes its index after a memory barrier, so the other side never sees an
+ *                index before the data it covers.
+ *              - RingFifo_PutBlock() and RingFifo_GetBlock() move several values with at most
+ *                two `memcpy()` calls (one per contiguous span of the buffer).
+ *              - The elements can be any size. The functions in this section use `uint32_t`
+ *                elements; see @ref RING_FIFO_DEFINE_TYPE() for other types.
+ *
+ * @warning     Calling RingFifo_Put() or RingFifo_PutBlock() from more than one context (or
+ *              RingFifo_Get() or RingFifo_GetBlock() from more than one context) is not safe.
+ */
+typedef struct RingFifoStruct_t * RingFifo_t;
+
+/**
+ * @brief               Initialize a lock-free ring buffer of `N` `uint32_t` values.
+ *
+ * @param[in] buffer    Array of size `N` to be used as the ring buffer.
+ * @param[in] N         Length of `buffer`. Must be a power of 2. Usable length is `N`.
+ * @param[out] ring     Pointer to the ring buffer.
+ *
+ * @post                The number of available ring buffers is reduced by 1.
+ */
+RingFifo_t RingFifo_Init(uint32_t buffer[], const uint32_t N);
+
+/**
+ * @brief               Reset the ring buffer.
+ *
+ * @param[in] ring      Pointer to the ring buffer.
+ *
+ * @post                The ring buffer is now considered empty.
+ *
+ * @note                This discards data from the consumer's side, so only the consumer
+ *                      should call it once both sides are running.
+ */
+void RingFifo_Reset(RingFifo_t ring);
+
+/**
+ * @brief               Add a value to the end of the ring buffer.
+ *
+ * @param[in] ring      Pointer to the ring buffer.
+ * @param[in] val       Value to add to the buffer.
+ * @param[out] true     `val` was added.
+ * @param[out] false    The ring buffer was full, so `val` was discarded.
+ *
+ * @see                 RingFifo_setOverflowPolicy()
+ */
+bool RingFifo_Put(RingFifo_t ring, const uint32_t val);
+
+/**
+ * @brief               Remove the first value of the ring buffer.
+ *
+ * @param[in] ring      Pointer to the ring buffer.
+ * @param[in] valPtr    Pointer to the output value.
+ * @param[out] true     The first value was removed and written to `valPtr`.
+ * @param[out] false    The ring buffer was empty, and `valPtr` was not changed.
+ */
+bool RingFifo_Get(RingFifo_t ring, uint32_t * valPtr);
+
+/**
+ * @brief                   Add several values to the end of the ring buffer.
+ *
+ * @param[in] ring          Pointer to the ring buffer.
+ * @param[in] inputBuffer   Array of values to add.
+ * @param[in] numVals       Number of values in `inputBuffer`.
+ * @param[out] numPut       Number of values actually added. This is less than `numVals` if the
+ *                          ring buffer did not have enough room for all of them.
+ */
+uint32_t RingFifo_PutBlock(RingFifo_t ring, const uint32_t inputBuffer[], uint32_t numVals);
+
+/**
+ * @brief                   Remove several values from the front of the ring buffer.
+ *
+ * @param[in] ring          Pointer to the ring buffer.
+ * @param[in] outputBuffer  Array to output values to. Must hold at least `numVals` values.
+ * @param[in] numVals       Max. number of values to remove.
+ * @param[out] numGot       Number of values actually removed. This is less than `numVals` if the
+ *                          ring buffer did not contain that many.
+ */
+uint32_t RingFifo_GetBlock(RingFifo_t ring, uint32_t outputBuffer[], uint32_t numVals);
+
+/// @brief  Check if the ring buffer is full.
+bool RingFifo_isFull(RingFifo_t ring);
+
+/// @brief  Check if the ring buffer is empty.
+bool RingFifo_isEmpty(RingFifo_t ring);
+
+/**
+ * @brief               Get the current size of the ring buffer.
+ *
+ * @note                If called while the other side is active, the result is a snapshot
+ *                      that may already be out of date.
+ */
+uint32_t RingFifo_getCurrSize(RingFifo_t ring);
+
+/** @} */               // Lock-Free Ring Buffer
+
+/******************************************************************************
+Lock-Free Ring Buffer (Zero-Copy)
+*******************************************************************************/
+/** @name Lock-Free Ring Buffer (Zero-Copy) */               /// @{
+
+/**
+ * @details     These functions give direct access to a contiguous span of the ring buffer's
+ *              array, so values can be written or used in place instead of being copied through
+ *              a local buffer first. A span never wraps around the end of the array, so using all
+ *              of the free (or used) space can take two spans.
+ *
+ * @code
+ *      // producer: write samples directly into the ring
+ *      uint32_t * span;
+ *      uint32_t numFree = RingFifo_ReserveWrite(ring, &span, numSamples);
+ *      for(uint32_t n = 0; n < numFree; n++) {
+ *          span[n] = samples[n];
+ *      }
+ *      RingFifo_CommitWrite(ring, numFree);
+ *
+ *      // consumer: run a block-based function on the samples in place
+ *      uint32_t numUsed = RingFifo_PeekSpan(ring, &span);
+ *      processBlock(span, numUsed);
+ *      RingFifo_Release(ring, numUsed);
+ * @endcode
+ */
+
+/**
+ * @brief                   Get a contiguous span of free space at the end of the ring buffer.
+ *
+ * @param[in] ring          Pointer to the ring buffer.
+ * @param[in] spanPtr       Pointer to the output span.
+ * @param[in] maxVals       Max. number of values the caller wants to write.
+ * @param[out] numFree      Number of values that can be written to the span (`<= maxVals`).
+ *
+ * @post                    Nothing is visible to the consumer until RingFifo_CommitWrite().
+ */
+uint32_t RingFifo_ReserveWrite(RingFifo_t ring, uint32_t ** spanPtr, uint32_t maxVals);
+
+/**
+ * @brief                   Add the first `numVals` values of the reserved span to the ring buffer.
+ *
+ * @param[in] ring          Pointer to the ring buffer.
+ * @param[in] numVals       Number of values written. Must not exceed the reserved amount.
+ */
+void RingFifo_CommitWrite(RingFifo_t ring, uint32_t numVals);
+
+/**
+ * @brief                   Get a contiguous span of values at the front of the ring buffer,
+ *                          without removing them.
+ *
+ * @param[in] ring          Pointer to the ring buffer.
+ * @param[in] spanPtr       Pointer to the output span.
+ * @param[out] numUsed      Number of values in the span. If this is `0`, the buffer is empty.
+ *
+ * @post                    The span can be read or modified in place until RingFifo_Release().
+ */
+uint32_t RingFifo_PeekSpan(RingFifo_t ring, uint32_t ** spanPtr);
+
+/**
+ * @brief                   Remove the first `numVals` values of the peeked span.
+ *
+ * @param[in] ring          Pointer to the ring buffer.
+ * @param[in] numVals       Number of values to remove. Must not exceed the peeked amount.
+ */
+void RingFifo_Release(RingFifo_t ring, uint32_t numVals);
+
+/** @} */               // Lock-Free Ring Buffer (Zero-Copy)
+
+/******************************************************************************
+Lock-Free Ring Buffer (Instrumentation)
+*******************************************************************************/
+/** @name Lock-Free Ring Buffer (Instrumentation) */               /// @{
+
+/**
+ * @details     Each ring buffer has an overflow policy, which decides what happens when the
+ *              producer adds more values than there is room for. If `FIFO_RING_STATS` is defined,
+ *              each ring buffer also keeps statistics that can be used to size its buffer.
+ *
+ * @code
+ *      RingFifoStats_t stats;
+ *      RingFifo_getStats(ring, &stats);
+ *      Debug_WriteFifoStats("ring", &stats);
+ * @endcode
+ */
+
+/// @brief  What the producer does when the ring buffer is full.
+typedef enum {
+    RING_FIFO_DROP_NEWEST,               ///< discard the new values (default)
+    RING_FIFO_DROP_OLDEST,               ///< discard the oldest values to make room
+    RING_FIFO_ASSERT                     ///< call `assert(false)`
+} RingFifoPolicy_t;
+
+/// @brief  Usage statistics of a ring buffer.
+typedef struct {
+    uint32_t N;                          ///< length of the ring buffer
+    uint32_t peakSize;                   ///< max. number of values held at once
+    uint32_t numDropped;                 ///< num. values discarded because the ring was full
+    uint32_t numUnderflows;              ///< num. reads that found the ring empty
+} RingFifoStats_t;
+
+/**
+ * @brief               Set the overflow policy of the ring buffer.
+ *
+ * @param[in] ring      Pointer to the ring buffer.
+ * @param[in] policy    New overflow policy.
+ *
+ * @note                This should be called before either side starts using the ring buffer.
+ *
+ * @warning             With @ref RING_FIFO_DROP_OLDEST, the producer also moves the front index,
+ *                      so RingFifo_PeekSpan() can't be used (the span could be overwritten while
+ *                      in use). The copying functions still work; if the producer drops the values
+ *                      being copied, the consumer copies the new front of the ring instead.
+ */
+void RingFifo_setOverflowPolicy(RingFifo_t ring, RingFifoPolicy_t policy);
+
+/**
+ * @brief               Get the ring buffer's statistics.
+ *
+ * @param[in] ring      Pointer to the ring buffer.
+ * @param[in] statsPtr  Pointer to the output statistics.
+ *
+ * @note                The counters are all `0` if `FIFO_RING_STATS` is not defined. An
+ *                      underflow is counted when RingFifo_Get() or RingFifo_GetBlock() finds the
+ *                      ring empty, so consumers that poll should check RingFifo_isEmpty() first.
+ */
+void RingFifo_getStats(RingFifo_t ring, RingFifoStats_t * statsPtr);
+
+/// @brief  Reset the ring buffer's statistics to `0`.
+void RingFifo_resetStats(RingFifo_t ring);
+
+/** @} */               // Lock-Free Ring Buffer (Instrumentation)
+
+/******************************************************************************
+Lock-Free Ring Buffer (Any Type)
+*******************************************************************************/
+/** @name Lock-Free Ring Buffer (Any Type) */               /// @{
+
+/**
+ * @details     These functions are the same as the ones above, but each element is `elemSize`
+ *              bytes and is passed by pointer. They are normally used through the typed
+ *              functions generated by @ref RING_FIFO_DEFINE_TYPE() instead of being called
+ *              directly.
+ */
+
+/// @brief  Same as RingFifo_Init(), but for elements of `elemSize` bytes.
+RingFifo_t RingFifo_InitElem(void * buffer, const uint32_t N, const uint32_t elemSize);
+
+/// @brief  Same as RingFifo_Put(), but copies `elemSize` bytes from `valPtr`.
+bool RingFifo_PutElem(RingFifo_t ring, const void * valPtr);
+
+/// @brief  Same as RingFifo_Get(), but copies `elemSize` bytes to `valPtr`.
+bool RingFifo_GetElem(RingFifo_t ring, void * valPtr);
+
+/// @brief  Same as RingFifo_PutBlock(), but for elements of `elemSize` bytes.
+uint32_t RingFifo_PutElems(RingFifo_t ring, const void * inputBuffer, uint32_t numVals);
+
+/// @brief  Same as RingFifo_GetBlock(), but for elements of `elemSize` bytes.
+uint32_t RingFifo_GetElems(RingFifo_t ring, void * outputBuffer, uint32_t numVals);
+
+/// @brief  Same as RingFifo_ReserveWrite(), but for elements of `elemSize` bytes.
+uint32_t RingFifo_ReserveWriteElems(RingFifo_t ring, void ** spanPtr, uint32_t maxVals);
+
+/// @brief  Same as RingFifo_PeekSpan(), but for elements of `elemSize` bytes.
+uint32_t RingFifo_PeekSpanElems(RingFifo_t ring, void ** spanPtr);
+
+// clang-format off
+
+/**
+ * @brief               Define a ring buffer type for elements of type `TYPE`.
+ *
+ * @details             This generates a handle type `PREFIX##_t` and the functions below, which
+ *                      are thin wrappers around the "Any Type" functions. Since each handle is a
+ *                      distinct type, passing a ring buffer of one type to another type's
+ *                      functions causes a compiler error, and no type-punning is needed.
+ *
+ *                      `PREFIX_Init()`, `PREFIX_Reset()`, `PREFIX_Put()`, `PREFIX_Get()`,
+ *                      `PREFIX_PutBlock()`, `PREFIX_GetBlock()`, `PREFIX_ReserveWrite()`,
+ *                      `PREFIX_CommitWrite()`, `PREFIX_PeekSpan()`, `PREFIX_Release()`,
+ *                      `PREFIX_isFull()`, `PREFIX_isEmpty()`, `PREFIX_getCurrSize()`,
+ *                      `PREFIX_setOverflowPolicy()`, `PREFIX_getStats()`, `PREFIX_resetStats()`
+ *
+ * @param[in] PREFIX    Name of the new type (e.g. `RingFifo16`).
+ * @param[in] TYPE      Element type (e.g. `uint16_t`, or a `struct` type).
+ *
+ * @code
+ *      typedef struct {
+ *          uint32_t timestamp;
+ *          uint16_t sample;
+ *      } TimedSample_t;
+ *
+ *      RING_FIFO_DEFINE_TYPE(TimedSampleFifo, TimedSample_t)
+ *
+ *      static TimedSample_t buffer[16];
+ *      TimedSampleFifo_t fifo = TimedSampleFifo_Init(buffer, 16);
+ *      TimedSampleFifo_Put(fifo, (TimedSample_t){ 1234, 0x800 });
+ * @endcode
+ */
+#define RING_FIFO_DEFINE_TYPE(PREFIX, TYPE)                                                        \
+    typedef struct PREFIX##Struct_t * PREFIX##_t;                                                  \
+                                                                                                   \
+    static inline PREFIX##_t PREFIX##_Init(TYPE buffer[], const uint32_t N) {                      \
+        return (PREFIX##_t) RingFifo_InitElem(buffer, N, sizeof(TYPE));                            \
+    }                                                                                              \
+    static inline void PREFIX##_Reset(PREFIX##_t ring) {                                           \
+        RingFifo_Reset((RingFifo_t) ring);                                                         \
+    }                                                                                              \
+    static inline bool PREFIX##_Put(PREFIX##_t ring, const TYPE val) {                             \
+        return RingFifo_PutElem((RingFifo_t) ring, &val);                                          \
+    }                                                                                              \
+    static inline bool PREFIX##_Get(PREFIX##_t ring, TYPE * valPtr) {                              \
+        return RingFifo_GetElem((RingFifo_t) ring, valPtr);                                        \
+    }                                                                                              \
+    static inline uint32_t PREFIX##_PutBlock(PREFIX##_t ring, const TYPE inputBuffer[],            \
+                                             uint32_t numVals) {                                   \
+        return RingFifo_PutElems((RingFifo_t) ring, inputBuffer, numVals);                         \
+    }                                                                                              \
+    static inline uint32_t PREFIX##_GetBlock(PREFIX##_t ring, TYPE outputBuffer[],                 \
+                                             uint32_t numVals) {                                   \
+        return RingFifo_GetElems((RingFifo_t) ring, outputBuffer, numVals);                        \
+    }                                                                                              \
+    static inline uint32_t PREFIX##_ReserveWrite(PREFIX##_t ring, TYPE ** spanPtr,                 \
+                                                 uint32_t maxVals) {                               \
+        void * span;                                                                               \
+        uint32_t numFree = RingFifo_ReserveWriteElems((RingFifo_t) ring, &span, maxVals);          \
+        *spanPtr = (TYPE *) span;                                                                  \
+        return numFree;                                                                            \
+    }                                                                                              \
+    static inline void PREFIX##_CommitWrite(PREFIX##_t ring, uint32_t numVals) {                   \
+        RingFifo_CommitWrite((RingFifo_t) ring, numVals);                                          \
+    }                                                                                              \
+    static inline uint32_t PREFIX##_PeekSpan(PREFIX##_t ring, TYPE ** spanPtr) {                   \
+        void * span;                                                                               \
+        uint32_t numUsed = RingFifo_PeekSpanElems((RingFifo_t) ring, &span);                       \
+        *spanPtr = (TYPE *) span;                                                                  \
+        return numUsed;                                                                            \
+    }                                                                                              \
+    static inline void PREFIX##_Release(PREFIX##_t ring, uint32_t numVals) {                       \
+        RingFifo_Release((RingFifo_t) ring, numVals);                                              \
+    }                                                                                              \
+    static inline bool PREFIX##_isFull(PREFIX##_t ring) {                                          \
+        return RingFifo_isFull((RingFifo_t) ring);                                                 \
+    }                                                                                              \
+    static inline bool PREFIX##_isEmpty(PREFIX##_t ring) {                                         \
+        return RingFifo_isEmpty((RingFifo_t) ring);                                                \
+    }                                                                                              \
+    static inline uint32_t PREFIX##_getCurrSize(PREFIX##_t ring) {                                 \
+        return RingFifo_getCurrSize((RingFifo_t) ring);                                            \
+    }                                                                                              \
+    static inline void PREFIX##_setOverflowPolicy(PREFIX##_t ring, RingFifoPolicy_t policy) {      \
+        RingFifo_setOverflowPolicy((RingFifo_t) ring, policy);                                     \
+    }                                                                                              \
+    static inline void PREFIX##_getStats(PREFIX##_t ring, RingFifoStats_t * statsPtr) {            \
+        RingFifo_getStats((RingFifo_t) ring, statsPtr);                                            \
+    }                                                                                              \
+    static inline void PREFIX##_resetStats(PREFIX##_t ring) {                                      \
+        RingFifo_resetStats((RingFifo_t) ring);                                                    \
+    }
+
+// clang-format on
+
+/// @brief  Ring buffer of `uint16_t` values (e.g. raw 12-bit ADC samples).
+RING_FIFO_DEFINE_TYPE(RingFifo16, uint16_t)
+
+/// @brief  Ring buffer of `float` values.
+RING_FIFO_DEFINE_TYPE(RingFifoFloat, float)
+
+/** @} */               // Lock-Free Ring Buffer (Any Type)
+
+/******************************************************************************
+Broadcast Ring Buffer
+*******************************************************************************/
+/** @name Broadcast Ring Buffer */               /// @{
+
+/**
+ * @details     This is a variant of @ref RingFifo_t with one producer and several readers (e.g. the
+ *              QRS detector and the waveform display), where every reader sees every value.
+ *
+ *              - Each value is copied into the buffer once, no matter how many readers there are.
+ *              - Each reader has its own front index, and only that reader writes it.
+ *              - The producer treats the buffer as full when the slowest reader is `N` values
+ *                behind, so no reader ever misses a value; the values that don't fit are dropped
+ *                (as with @ref RING_FIFO_DROP_NEWEST).
+ *              - Readers can be added without changing the producer's code.
+ *
+ * @code
+ *      static float32_t buffer[8];
+ *      BroadcastFifo_t fifo = BroadcastFifo_Init(buffer, 8, sizeof(float32_t));
+ *      BroadcastReader_t qrsReader = BroadcastFifo_AddReader(fifo);
+ *      BroadcastReader_t lcdReader = BroadcastFifo_AddReader(fifo);
+ *
+ *      BroadcastFifo_Put(fifo, &sample);               // producer
+ *      BroadcastFifo_Get(qrsReader, &sample);          // each reader gets its own copy
+ *      BroadcastFifo_Get(lcdReader, &sample);
+ * @endcode
+ *
+ * @warning     A reader that stops reading eventually stops the producer, since its values can't
+ *              be overwritten. Each reader's lag is available via BroadcastFifo_getLag().
+ */
+typedef struct BroadcastFifoStruct_t * BroadcastFifo_t;
+
+/// @brief  One reader of a @ref BroadcastFifo_t.
+typedef struct BroadcastReaderStruct_t * BroadcastReader_t;
+
+/**
+ * @brief               Initialize a broadcast ring buffer of `N` elements of `elemSize` bytes.
+ *
+ * @param[in] buffer    Array of size `N` to be used as the ring buffer.
+ * @param[in] N         Length of `buffer`. Must be a power of 2. Usable length is `N`.
+ * @param[in] elemSize  Size of each element in bytes.
+ * @param[out] fifo     Pointer to the broadcast ring buffer.
+ *
+ * @post                The number of available broadcast ring buffers is reduced by 1.
+ */
+BroadcastFifo_t BroadcastFifo_Init(void * buffer, const uint32_t N, const uint32_t elemSize);
+
+/**
+ * @brief               Add a reader to the broadcast ring buffer.
+ *
+ * @param[in] fifo      Pointer to the broadcast ring buffer.
+ * @param[out] reader   Pointer to the new reader. It starts out empty, so it only sees values that
+ *                      are added afterwards.
+ *
+ * @pre                 Add all readers before the producer starts.
+ * @post                The number of available readers is reduced by 1.
+ */
+BroadcastReader_t BroadcastFifo_AddReader(BroadcastFifo_t fifo);
+
+/**
+ * @brief               Add a value to the end of the broadcast ring buffer.
+ *
+ * @param[in] fifo      Pointer to the broadcast ring buffer.
+ * @param[in] valPtr    Pointer to the value to add (`elemSize` bytes).
+ * @param[out] true     The value was added.
+ * @param[out] false    The slowest reader was `N` values behind, so the value was discarded.
+ */
+bool BroadcastFifo_Put(BroadcastFifo_t fifo, const void * valPtr);
+
+/**
+ * @brief                   Add several values to the end of the broadcast ring buffer.
+ *
+ * @param[in] fifo          Pointer to the broadcast ring buffer.
+ * @param[in] inputBuffer   Array of values to add.
+ * @param[in] numVals       Number of values in `inputBuffer`.
+ * @param[out] numPut       Number of values actually added.
+ */
+uint32_t BroadcastFifo_PutBlock(BroadcastFifo_t fifo, const void * inputBuffer, uint32_t numVals);
+
+/**
+ * @brief               Remove the reader's first value.
+ *
+ * @param[in] reader    Pointer to the reader.
+ * @param[in] valPtr    Pointer to the output value.
+ * @param[out] true     The first value was removed and written to `valPtr`.
+ * @param[out] false    The reader has no new values, and `valPtr` was not changed.
+ */
+bool BroadcastFifo_Get(BroadcastReader_t reader, void * valPtr);
+
+/**
+ * @brief                   Remove several of the reader's values.
+ *
+ * @param[in] reader        Pointer to the reader.
+ * @param[in] outputBuffer  Array to output values to. Must hold at least `numVals` values.
+ * @param[in] numVals       Max. number of values to remove.
+ * @param[out] numGot       Number of values actually removed.
+ */
+uint32_t BroadcastFifo_GetBlock(BroadcastReader_t reader, void * outputBuffer, uint32_t numVals);
+
+/**
+ * @brief                   Get a contiguous span of the reader's values, without removing them.
+ *
+ * @param[in] reader        Pointer to the reader.
+ * @param[in] spanPtr       Pointer to the output span.
+ * @param[out] numUsed      Number of values in the span.
+ *
+ * @warning                 The span is shared with the other readers, so it should only be
+ *                          modified in place once they have all read it.
+ *
+ * @see                     RingFifo_PeekSpan()
+ */
+uint32_t BroadcastFifo_PeekSpan(BroadcastReader_t reader, void ** spanPtr);
+
+/// @brief  Remove the first `numVals` values of the reader's peeked span.
+void BroadcastFifo_Release(BroadcastReader_t reader, uint32_t numVals);
+
+/// @brief  Get the number of values the reader hasn't read yet.
+uint32_t BroadcastFifo_getLag(BroadcastReader_t reader);
+
+/**
+ * @brief               Get the broadcast ring buffer's statistics, as seen by the producer.
+ * @note                `peakSize` is the peak lag of the slowest reader.
+ * @see                 RingFifo_getStats()
+ */
+void BroadcastFifo_getStats(BroadcastFifo_t fifo, RingFifoStats_t * statsPtr);
+
+/**
+ * @brief               Get one reader's statistics.
+ * @note                `peakSize` is the reader's peak lag, and `numDropped` is always `0`.
+ * @see                 RingFifo_getStats()
+ */
+void BroadcastFifo_getReaderStats(BroadcastReader_t reader, RingFifoStats_t * statsPtr);
+
+/// @brief  Reset the broadcast ring buffer's statistics to `0`.
+void BroadcastFifo_resetStats(BroadcastFifo_t fifo);
+
+/// @brief  Reset one reader's statistics to `0`.
+void BroadcastFifo_resetReaderStats(BroadcastReader_t reader);
+
+/** @} */               // Broadcast Ring Buffer
+
 #endif                  // Fifo_H
 
 /** @} */
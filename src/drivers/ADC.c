@@ -14,6 +14,8 @@
 #include "m-profile/cmsis_gcc_m.h"
 #include "tm4c123gh6pm.h"
 
+#include <stdint.h>
+
 void ADC_Init(void) {
     // enable clock to ADC0 and wait for it to be ready
     SYSCTL_RCGCADC_R |= 0x01;
@@ -43,4 +45,13 @@ void ADC_Init(void) {
     return;
 }
 
+uint16_t ADC_readSample(void) {
+    return (uint16_t) (ADC0_SSFIFO3_R & 0xFFF);
+}
+
+void ADC_acknowledgeInterrupt(void) {
+    ADC0_ISC_R |= 0x08;
+    return;
+}
+
 /** @} */
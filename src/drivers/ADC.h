@@ -10,6 +10,8 @@
 #ifndef ADC_H
 #define ADC_H
 
+#include <stdint.h>
+
 /**
  * @brief           Initialize ADC0 as a single-input analog-to-digital converter.
  * @post            Analog input 8 (`Ain8`) – AKA GPIO pin PE5 – captures samples when
@@ -18,6 +20,20 @@
  */
 void ADC_Init(void);
 
+/**
+ * @brief           Read the most recent sample from sample sequencer 3's FIFO.
+ *
+ * @pre             Initialize the ADC.
+ * @param[out] uint16_t 12-bit sample in range `[0x000, 0xFFF]`.
+ */
+uint16_t ADC_readSample(void);
+
+/**
+ * @brief           Clear sample sequencer 3's interrupt flag.
+ * @pre             This should be used within the ADC's interrupt handler.
+ */
+void ADC_acknowledgeInterrupt(void);
+
 #endif               // ADC_H
 
 /** @} */
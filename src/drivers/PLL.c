@@ -12,6 +12,10 @@
 #include "m-profile/cmsis_gcc_m.h"
 #include "tm4c123gh6pm.h"
 
+#include <stdint.h>
+
+static uint32_t busFreq_Hz = PLL_RESET_BUS_FREQ_HZ;
+
 void PLL_Init(void) {
     // Disable PLL and system clock divider
     SYSCTL_RCC_R &= ~(1 << 22);                // disable system clock divider
@@ -35,6 +39,12 @@ void PLL_Init(void) {
         __NOP();
     }
     SYSCTL_RCC2_R &= ~(1 << 11);                      // clear BYPASS2 to enable PLL
+
+    busFreq_Hz = PLL_BUS_FREQ_HZ;
+}
+
+uint32_t PLL_getBusFreq_Hz(void) {
+    return busFreq_Hz;
 }
 
 /** @} */
@@ -10,12 +10,29 @@
 #ifndef PLL_H
 #define PLL_H
 
+#include <stdint.h>
+
+enum PLL_BUS_FREQUENCIES {
+    PLL_RESET_BUS_FREQ_HZ = 16000000,               ///< precision internal oscillator (PIOSC)
+    PLL_BUS_FREQ_HZ = 80000000                      ///< after PLL_Init()
+};
+
 /**
  * @brief       Initialize the phase-locked-loop to change the bus frequency.
  * @post        The bus frequency is now running at 80 [MHz].
  */
 void PLL_Init(void);
 
+/**
+ * @brief               Get the current bus frequency.
+ *
+ * @param[out] uint32_t Bus frequency in [Hz], i.e. @ref PLL_BUS_FREQ_HZ after PLL_Init() or
+ *                      @ref PLL_RESET_BUS_FREQ_HZ before it.
+ *
+ * @see                 UART_setBaudRate()
+ */
+uint32_t PLL_getBusFreq_Hz(void);
+
 #endif               // PLL_H
 
 /** @} */
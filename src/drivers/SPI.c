@@ -10,6 +10,7 @@
 #include "SPI.h"
 
 #include "GPIO.h"
+#include "PLL.h"
 
 #include "NewAssert.h"
 
@@ -55,6 +56,9 @@ enum SSI_REGISTER_OFFSETS {
 Initialization
 *******************************************************************************/
 
+static void writeClockDivisor(Spi_t spi, const SpiClockDivisor_t * divisorPtr);
+static void waitWhileBusy(Spi_t spi);
+
 typedef struct SpiStruct_t {
     const uint32_t BASE_ADDRESS;
     volatile uint32_t * const DATA_REGISTER;
@@ -131,16 +135,17 @@ Spi_t SPI_Init(GpioPort_t gpioPort, GpioPin_t dcPin, SsiNum_t ssiNum) {
         // config control registers
         register_t ctrlRegister0 = (register_t) (spi->BASE_ADDRESS + CTRL0_OFFSET);
         register_t ctrlRegister1 = (register_t) (spi->BASE_ADDRESS + CTRL1_OFFSET);
-        register_t clkPrescaleReg = (register_t) (spi->BASE_ADDRESS + CLK_PRESCALE_OFFSET);
 
         *ctrlRegister1 &= ~(0x02);               // disable
         *ctrlRegister1 &= ~(0x15);               // controller (master) mode, no EOT, no loopback
 
         *ctrlRegister0 &= ~(0x30);               // SPI frame format
 
-        // set bit rate to 10 [MHz]
-        *clkPrescaleReg = (*clkPrescaleReg & ~(0xFF)) | 4;
-        *ctrlRegister0 = (*ctrlRegister0 & ~(0xFF00)) | (0x0100);
+        SpiClockDivisor_t divisor;
+        bool isValidBitRate =
+            SPI_calcClockDivisor(PLL_getBusFreq_Hz(), SPI_DEFAULT_BIT_RATE, &divisor);
+        assert(isValidBitRate);
+        writeClockDivisor(spi, &divisor);
 
         spi->gpioDataRegister = GPIO_getDataRegister(gpioPort);
         spi->gpioDataCommPin = dcPin;
@@ -217,12 +222,40 @@ void SPI_Enable(Spi_t spi) {
 void SPI_Disable(Spi_t spi) {
     assert(spi->isInit);
     if(spi->isEnabled) {
+        waitWhileBusy(spi);                     // don't cut off frames still in the TX FIFO
+
         register_t ctrlRegister1 = (register_t) (spi->BASE_ADDRESS + CTRL1_OFFSET);
         *ctrlRegister1 &= ~(0x02);
         spi->isEnabled = false;
     }
 }
 
+/******************************************************************************
+Bit Rate
+*******************************************************************************/
+
+void SPI_setBitRate(Spi_t spi, uint32_t bitRate) {
+    assert(spi->isInit);
+    assert(spi->isEnabled == false);
+
+    SpiClockDivisor_t divisor;
+    bool isValidBitRate = SPI_calcClockDivisor(PLL_getBusFreq_Hz(), bitRate, &divisor);
+    assert(isValidBitRate);
+    writeClockDivisor(spi, &divisor);
+
+    return;
+}
+
+/// @brief  Write the clock prescale register and `SCR` field. The SPI must be disabled.
+static void writeClockDivisor(Spi_t spi, const SpiClockDivisor_t * divisorPtr) {
+    register_t ctrlRegister0 = (register_t) (spi->BASE_ADDRESS + CTRL0_OFFSET);
+    register_t clkPrescaleReg = (register_t) (spi->BASE_ADDRESS + CLK_PRESCALE_OFFSET);
+
+    *clkPrescaleReg = (*clkPrescaleReg & ~(0xFF)) | divisorPtr->prescale;
+    *ctrlRegister0 = (*ctrlRegister0 & ~(0xFF00)) | ((uint32_t) divisorPtr->serialClockRate << 8);
+    return;
+}
+
 /******************************************************************************
 Operations
 *******************************************************************************/
@@ -234,20 +267,33 @@ uint16_t SPI_Read(Spi_t spi) {
     return *spi->DATA_REGISTER;
 }
 
+/// @brief  Wait until the TX FIFO is empty and the last frame has been sent.
+static void waitWhileBusy(Spi_t spi) {
+    while(*spi->STATUS_REGISTER & SSI_SR_BSY) {
+        __NOP();
+    }
+    return;
+}
+
+/// @brief  Add a frame to the TX FIFO as soon as it has room. The D/C pin is unaffected.
+static inline void writeFrame(Spi_t spi, uint16_t frame) {
+    while((*spi->STATUS_REGISTER & SSI_SR_TNF) == 0) {               // wait while TX FIFO is full
+        __NOP();
+    }
+    *spi->DATA_REGISTER = frame;
+    return;
+}
+
 void SPI_WriteCmd(Spi_t spi, uint16_t cmd) {
     assert(spi->isInit);
     assert(spi->isEnabled);
 
-    while(*spi->STATUS_REGISTER & SSI_SR_BSY) {                      // wait while SPI is busy
-        __NOP();
-    }
+    waitWhileBusy(spi);                                              // finish sending prev. data
 
     *spi->gpioDataRegister &= ~(spi->gpioDataCommPin);               // signal incoming command
     *spi->DATA_REGISTER = cmd & ((1 << spi->dataSize) - 1);
 
-    while(*spi->STATUS_REGISTER & SSI_SR_BSY) {                      // allow transmission to finish
-        __NOP();
-    }
+    waitWhileBusy(spi);                                              // let transmission finish
     return;
 }
 
@@ -265,4 +311,64 @@ void SPI_WriteData(Spi_t spi, uint16_t data) {
     return;
 }
 
+void SPI_WriteBuffer(Spi_t spi, const uint8_t data[], uint32_t len) {
+    assert(spi->isInit);
+    assert(spi->isEnabled);
+    assert(spi->dataSize <= 8);
+
+    *spi->gpioDataRegister |= spi->gpioDataCommPin;                  // signal incoming data
+    for(uint32_t idx = 0; idx < len; idx++) {
+        writeFrame(spi, data[idx]);
+    }
+
+    waitWhileBusy(spi);
+    return;
+}
+
+void SPI_WriteBuffer16(Spi_t spi, const uint16_t data[], uint32_t len) {
+    assert(spi->isInit);
+    assert(spi->isEnabled);
+    assert((spi->dataSize == 8) || (spi->dataSize == 16));
+
+    *spi->gpioDataRegister |= spi->gpioDataCommPin;                  // signal incoming data
+    if(spi->dataSize == 16) {
+        for(uint32_t idx = 0; idx < len; idx++) {
+            writeFrame(spi, data[idx]);
+        }
+    }
+    else {
+        for(uint32_t idx = 0; idx < len; idx++) {
+            writeFrame(spi, data[idx] >> 8);
+            writeFrame(spi, data[idx] & 0xFF);
+        }
+    }
+
+    waitWhileBusy(spi);
+    return;
+}
+
+void SPI_WriteRepeat16(Spi_t spi, uint16_t value, uint32_t count) {
+    assert(spi->isInit);
+    assert(spi->isEnabled);
+    assert((spi->dataSize == 8) || (spi->dataSize == 16));
+
+    *spi->gpioDataRegister |= spi->gpioDataCommPin;                  // signal incoming data
+    if(spi->dataSize == 16) {
+        for(uint32_t n = 0; n < count; n++) {
+            writeFrame(spi, value);
+        }
+    }
+    else {
+        const uint16_t msb = value >> 8;
+        const uint16_t lsb = value & 0xFF;
+        for(uint32_t n = 0; n < count; n++) {
+            writeFrame(spi, msb);
+            writeFrame(spi, lsb);
+        }
+    }
+
+    waitWhileBusy(spi);
+    return;
+}
+
 /** @} */                                                            // spi
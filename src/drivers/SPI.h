@@ -74,13 +74,13 @@ typedef enum {
 void SPI_configClock(Spi_t spi, SpiClockPhase_t clockPhase, SpiClockPolarity_t clockPolarity);
 
 /**
- * @brief
+ * @brief                       Set the number of bits in each frame.
  *
  * @pre                         Initialize the SPI.
  * @pre                         Disable the SPI.
  *
- * @param[in] spi
- * @param[in] dataSize
+ * @param[in] spi               SPI to configure.
+ * @param[in] dataSize          Frame size in range `[4, 16]`.
  */
 void SPI_setDataSize(Spi_t spi, uint8_t dataSize);
 
@@ -100,12 +100,71 @@ void SPI_Enable(Spi_t spi);
  *
  * @pre                         Initialize the SPI.
  * @param[in] spi               SPI to disable.
- * @post                        The SPI is disabled.
+ * @post                        Any data in the transmit FIFO has been sent, and the SPI is
+ *                              disabled.
  *
  * @see                         SPI_Enable()
  */
 void SPI_Disable(Spi_t spi);
 
+/******************************************************************************
+Bit Rate
+*******************************************************************************/
+
+#ifndef SPI_DEFAULT_BIT_RATE
+#define SPI_DEFAULT_BIT_RATE 10000000               ///< bit rate set by SPI_Init()
+#endif
+
+enum {
+    SPI_MAX_BIT_RATE = 25000000                     ///< max. `SSIClk` in controller mode [Hz]
+};
+
+/// @brief  Clock divisor settings, where \f$ SSIClk = f_{bus} / (CPSDVSR * (1 + SCR)) \f$.
+typedef struct {
+    uint8_t prescale;                               ///< `CPSDVSR`; even, in range `[2, 254]`
+    uint8_t serialClockRate;                        ///< `SCR`; in range `[0, 255]`
+} SpiClockDivisor_t;
+
+/**
+ * @brief                       Set an SPI's bit rate.
+ *
+ * @details                     The divisor is calculated from the current bus frequency. The
+ *                              actual bit rate is the fastest one that doesn't exceed `bitRate`.
+ *
+ * @pre                         Initialize the SPI.
+ * @pre                         Disable the SPI.
+ *
+ * @param[in] spi               SPI to configure.
+ * @param[in] bitRate           Bit rate in [bits/s]. Capped at `SPI_MAX_BIT_RATE`.
+ *
+ * @see                         SPI_calcClockDivisor(), PLL_getBusFreq_Hz()
+ */
+void SPI_setBitRate(Spi_t spi, uint32_t bitRate);
+
+/**
+ * @brief                       Calculate the clock divisor for a bit rate.
+ *
+ * @details                     Of the divisors that don't exceed `bitRate`, the one with the
+ *                              highest bit rate (and then the smallest `CPSDVSR`) is chosen.
+ *                              Bit rates above `SPI_MAX_BIT_RATE` are capped at that limit.
+ *
+ * @param[in] busFreq_Hz        Bus frequency in [Hz].
+ * @param[in] bitRate           Bit rate in [bits/s].
+ * @param[out] divisorPtr       Divisor settings. Unchanged if the bit rate is not possible.
+ * @param[out] true             The bit rate is possible.
+ * @param[out] false            The bit rate is 0 or too low for the bus frequency.
+ */
+bool SPI_calcClockDivisor(uint32_t busFreq_Hz, uint32_t bitRate, SpiClockDivisor_t * divisorPtr);
+
+/**
+ * @brief                       Calculate the actual bit rate that a divisor produces.
+ *
+ * @param[in] busFreq_Hz        Bus frequency in [Hz].
+ * @param[in] divisorPtr        Divisor settings.
+ * @param[out] uint32_t         Bit rate in [bits/s] (rounded down).
+ */
+uint32_t SPI_calcBitRate(uint32_t busFreq_Hz, const SpiClockDivisor_t * divisorPtr);
+
 /******************************************************************************
 Operations
 *******************************************************************************/
@@ -149,6 +208,65 @@ void SPI_WriteCmd(Spi_t spi, uint16_t cmd);
  */
 void SPI_WriteData(Spi_t spi, uint16_t data);
 
+/**
+ * @brief                       Write a block of data to the serial port.
+ *
+ * @details                     Unlike SPI_WriteData(), the D/C pin is only set once, and each
+ *                              frame is written as soon as the hardware's transmit FIFO has room.
+ *
+ * @pre                         Initialize the SPI.
+ * @pre                         Enable the SPI with a data size of at most 8 bits.
+ *
+ * @param[in] spi               SPI to write to.
+ * @param[in] data              Data to write, one frame per byte.
+ * @param[in] len               Number of bytes to write.
+ *
+ * @post                        The D/C pin is set.
+ * @post                        All of the data has been sent (i.e. the SPI is no longer busy).
+ *
+ * @see                         SPI_WriteBuffer16(), SPI_WriteRepeat16()
+ */
+void SPI_WriteBuffer(Spi_t spi, const uint8_t data[], uint32_t len);
+
+/**
+ * @brief                       Write a block of 16-bit data to the serial port.
+ *
+ * @details                     With a data size of 16 bits, each value is one frame. With a data
+ *                              size of 8 bits, each value is sent as two frames, MSB first, so the
+ *                              receiver gets the same bits either way.
+ *
+ * @pre                         Initialize the SPI.
+ * @pre                         Enable the SPI with a data size of 8 or 16 bits.
+ *
+ * @param[in] spi               SPI to write to.
+ * @param[in] data              Data to write.
+ * @param[in] len               Number of values to write.
+ *
+ * @post                        The D/C pin is set.
+ * @post                        All of the data has been sent (i.e. the SPI is no longer busy).
+ *
+ * @see                         SPI_WriteBuffer(), SPI_WriteRepeat16()
+ */
+void SPI_WriteBuffer16(Spi_t spi, const uint16_t data[], uint32_t len);
+
+/**
+ * @brief                       Write the same 16-bit value to the serial port repeatedly
+ *                              (e.g. to fill an area of a display with one color).
+ *
+ * @pre                         Initialize the SPI.
+ * @pre                         Enable the SPI with a data size of 8 or 16 bits.
+ *
+ * @param[in] spi               SPI to write to.
+ * @param[in] value             Value to write. Sent the same way as in SPI_WriteBuffer16().
+ * @param[in] count             Number of times to write `value`.
+ *
+ * @post                        The D/C pin is set.
+ * @post                        All of the data has been sent (i.e. the SPI is no longer busy).
+ *
+ * @see                         SPI_WriteBuffer(), SPI_WriteBuffer16()
+ */
+void SPI_WriteRepeat16(Spi_t spi, uint16_t value, uint32_t count);
+
 #endif                  // SPI_H
 
 /** @} */               // spi
@@ -0,0 +1,55 @@
+/**
+ * @addtogroup spi
+ * @{
+ *
+ * @file
+ * @author  Bryan McElvy
+ * @brief   Clock divisor calculations for the SPI module.
+ *
+ * @details These functions don't access any registers, so they can also be built and tested on
+ *          the host.
+ */
+
+#include "SPI.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+enum CLOCK_DIVISOR_LIMITS {
+    CPSDVSR_MIN = 2,
+    CPSDVSR_MAX = 254,                              ///< `CPSDVSR` must also be even
+    SCR_MAX = 255
+};
+
+bool SPI_calcClockDivisor(uint32_t busFreq_Hz, uint32_t bitRate, SpiClockDivisor_t * divisorPtr) {
+    if(bitRate == 0) {
+        return false;
+    }
+    bitRate = (bitRate > SPI_MAX_BIT_RATE) ? SPI_MAX_BIT_RATE : bitRate;
+
+    uint32_t bestBitRate = 0;
+    for(uint32_t prescale = CPSDVSR_MIN; prescale <= CPSDVSR_MAX; prescale += 2) {
+        // smallest `1 + SCR` that doesn't exceed `bitRate`, i.e. ceil(f_bus / (CPSDVSR * BR))
+        uint64_t prescaledBitRate = (uint64_t) prescale * bitRate;
+        uint64_t clockRate = (busFreq_Hz + prescaledBitRate - 1) / prescaledBitRate;
+        clockRate = (clockRate > 0) ? clockRate : 1;
+        if(clockRate > (SCR_MAX + 1)) {
+            continue;
+        }
+
+        uint32_t actualBitRate = (uint32_t) (busFreq_Hz / (prescale * clockRate));
+        if(actualBitRate > bestBitRate) {
+            bestBitRate = actualBitRate;
+            divisorPtr->prescale = (uint8_t) prescale;
+            divisorPtr->serialClockRate = (uint8_t) (clockRate - 1);
+        }
+    }
+
+    return (bestBitRate > 0);
+}
+
+uint32_t SPI_calcBitRate(uint32_t busFreq_Hz, const SpiClockDivisor_t * divisorPtr) {
+    return busFreq_Hz / ((uint32_t) divisorPtr->prescale * (1 + divisorPtr->serialClockRate));
+}
+
+/** @} */
@@ -37,7 +37,7 @@ enum REGISTER_OFFSETS {
     INT_MASK = 0x18,
     INT_CLEAR = 0x24,
     INTERVAL = 0x28,
-    VALUE = 0x054
+    VALUE = 0x050
 };
 
 typedef struct TimerStruct_t {
@@ -186,6 +186,15 @@ void Timer_setInterval_ms(Timer_t timer, uint32_t time_ms) {
     return;
 }
 
+void Timer_setReloadValue(Timer_t timer, uint32_t reloadValue) {
+    assert(*timer->isInit);
+
+    *timer->controlRegister &= ~(0x101);               // disable timer
+    *timer->intervalLoadRegister = reloadValue;
+
+    return;
+}
+
 uint32_t Timer_getCurrentValue(Timer_t timer) {
     assert(*timer->isInit);
 
@@ -166,7 +166,31 @@ Basic Operations
  */
 void Timer_setInterval_ms(Timer_t timer, uint32_t time_ms);
 
-// TODO: Write description
+/**
+ * @brief                       Set the raw reload value (i.e. interval in clock cycles, minus 1).
+ *
+ * @pre                         Initialize and configure the timer.
+ *
+ * @param[in] timer             Pointer to timer object.
+ * @param[in] reloadValue       Reload value. Use `0xFFFFFFFF` with the `PERIODIC` mode and the
+ *                              `UP` direction for a free-running 32-bit counter.
+ *
+ * @post                        Upon starting, the Timer counts down from or up to this value.
+ *
+ * @see                         Timer_setInterval_ms(), Timer_getCurrentValue()
+ */
+void Timer_setReloadValue(Timer_t timer, uint32_t reloadValue);
+
+/**
+ * @brief                       Get the current value of the counter.
+ *
+ * @pre                         Initialize and configure the timer.
+ *
+ * @param[in] timer             Pointer to timer object.
+ * @param[out] uint32_t         Current value of the 32-bit counter, in clock cycles.
+ *
+ * @see                         Timer_setReloadValue()
+ */
 uint32_t Timer_getCurrentValue(Timer_t timer);
 
 /**
@@ -13,11 +13,14 @@
 SECTIONS
         Constant Declarations
         Initialization
+        Baud Rate
         Reading
         Writing
+        Buffered Writing
 *******************************************************************************/
 
 #include "GPIO.h"
+#include "PLL.h"
 
 #include "NewAssert.h"
 
@@ -26,6 +29,7 @@ SECTIONS
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 
 #define CONVERT_INT_TO_ASCII(X) ((unsigned char) (X + 0x30))
 
@@ -59,6 +63,9 @@ enum UART_REG_OFFSETS {
     FBRD_R_OFFSET = (uint32_t) 0x28,
     LCRH_R_OFFSET = (uint32_t) 0x2C,
     CTL_R_OFFSET = (uint32_t) 0x30,
+    IFLS_R_OFFSET = (uint32_t) 0x34,
+    IM_R_OFFSET = (uint32_t) 0x38,
+    ICR_R_OFFSET = (uint32_t) 0x44,
     CC_R_OFFSET = (uint32_t) 0xFC8
 };
 
@@ -74,6 +81,18 @@ typedef struct UartStruct_t {
 
 static bool initStatusArray[8] = { false, false, false, false, false, false, false, false };
 
+static void writeBaudDivisor(Uart_t uart, const UartBaudDivisor_t * divisorPtr);
+
+typedef struct UartTxBuffer_t {
+    uint8_t * buffer;                                  ///< chars waiting for the hardware FIFO
+    uint32_t mask;                                     ///< `N - 1`, used to wrap indices
+    uint32_t frontIdx;                                 ///< free-running idx of next char to send
+    uint32_t backIdx;                                  ///< free-running idx of next free slot
+    uint32_t numDropped;                               ///< num. chars dropped while full
+} UartTxBuffer_t;
+
+static UartTxBuffer_t txBufferArray[8] = { 0 };               ///< unused if `buffer == 0`
+
 // clang-format off
 static const UartStruct_t UART_STRUCT_ARRAY[8] = {
     { UART0_BASE, REGISTER_CAST(UART0_BASE + UART_FR_R_OFFSET), &initStatusArray[0] },
@@ -139,21 +158,6 @@ Uart_t UART_Init(GpioPort_t port, uartNum_t uartNum) {
             break;
     }
 
-    // clang-format off
-    /**
-     *  @details
-     *  Given the bus frequency (`f_bus`) and desired baud rate (`BR`),
-     *  the baud rate divisor (`BRD`) can be calculated:
-     *      \f$ BRD = f_{bus}/(16*BR) \f$
-     * 
-     *  The integer BRD (`IBRD`) is simply the integer part of the BRD:
-     *      \f$ IBRD = int( BRD ) \f$
-     * 
-     *  The fractional BRD (`FBRD`) is calculated using the fractional part (`mod(BRD,1)`) of the BRD:
-     *      \f$ FBRD = int( ( mod(BRD,1) * 64 ) + 0.5 ) \f$
-     */
-    // clang-format on
-
     // Initialize UART
     Uart_t uart = &UART_STRUCT_ARRAY[uartNum];
     if(*uart->isInitPtr == false) {
@@ -174,18 +178,20 @@ Uart_t UART_Init(GpioPort_t port, uartNum_t uartNum) {
         GPIO_EnableDigital(port, RX_PIN_NUM | TX_PIN_NUM);
 
         // disable UART
-        REGISTER_VAL(uart->BASE_ADDRESS + CTL_R_OFFSET) &= ~(1 << uartNum);
+        REGISTER_VAL(uart->BASE_ADDRESS + CTL_R_OFFSET) &= ~(UART_CTL_UARTEN);
 
-        // 8-bit length, FIFO
-        REGISTER_VAL(uart->BASE_ADDRESS + IBRD_R_OFFSET) |= 43;
-        REGISTER_VAL(uart->BASE_ADDRESS + FBRD_R_OFFSET) |= 26;
+        // baud rate, then 8-bit length and FIFO (NOTE: access `LCRH` *AFTER* `BRD`)
+        UartBaudDivisor_t divisor;
+        bool isValidBaudRate =
+            UART_calcBaudDivisor(PLL_getBusFreq_Hz(), UART_DEFAULT_BAUD_RATE, &divisor);
+        assert(isValidBaudRate);
+        writeBaudDivisor(uart, &divisor);
 
-        // (NOTE: access *AFTER* `BRD`)
-        REGISTER_VAL(uart->BASE_ADDRESS + LCRH_R_OFFSET) |= 0x70;
+        REGISTER_VAL(uart->BASE_ADDRESS + LCRH_R_OFFSET) = (UART_LCRH_WLEN_8 | UART_LCRH_FEN);
         REGISTER_VAL(uart->BASE_ADDRESS + CC_R_OFFSET) &= ~(0x0F);               // system clock
 
         // re-enable
-        REGISTER_VAL(uart->BASE_ADDRESS + CTL_R_OFFSET) |= (1 << uartNum);
+        REGISTER_VAL(uart->BASE_ADDRESS + CTL_R_OFFSET) |= UART_CTL_UARTEN;
 
         *uart->isInitPtr = true;
     }
@@ -197,12 +203,54 @@ bool UART_isInit(Uart_t uart) {
     return *uart->isInitPtr;
 }
 
+/******************************************************************************
+Baud Rate
+*******************************************************************************/
+
+void UART_setBaudRate(Uart_t uart, uint32_t baudRate) {
+    assert(UART_isInit(uart));
+
+    UartBaudDivisor_t divisor;
+    bool isValidBaudRate = UART_calcBaudDivisor(PLL_getBusFreq_Hz(), baudRate, &divisor);
+    assert(isValidBaudRate);
+
+    // finish sending at the old baud rate, and don't let ISRs write until the new one is set
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    UART_Flush(uart);
+
+    REGISTER_VAL(uart->BASE_ADDRESS + CTL_R_OFFSET) &= ~(UART_CTL_UARTEN);
+    writeBaudDivisor(uart, &divisor);
+
+    // writing `LCRH` latches the new divisor
+    uint32_t lineControl = REGISTER_VAL(uart->BASE_ADDRESS + LCRH_R_OFFSET);
+    REGISTER_VAL(uart->BASE_ADDRESS + LCRH_R_OFFSET) = lineControl;
+
+    REGISTER_VAL(uart->BASE_ADDRESS + CTL_R_OFFSET) |= UART_CTL_UARTEN;
+    __set_PRIMASK(primask);
+    return;
+}
+
+/// @brief  Write the divisor registers (and the `HSE` bit). The UART must be disabled.
+static void writeBaudDivisor(Uart_t uart, const UartBaudDivisor_t * divisorPtr) {
+    REGISTER_VAL(uart->BASE_ADDRESS + IBRD_R_OFFSET) = divisorPtr->integer;
+    REGISTER_VAL(uart->BASE_ADDRESS + FBRD_R_OFFSET) = divisorPtr->fraction;
+
+    if(divisorPtr->isHighSpeed) {
+        REGISTER_VAL(uart->BASE_ADDRESS + CTL_R_OFFSET) |= UART_CTL_HSE;
+    }
+    else {
+        REGISTER_VAL(uart->BASE_ADDRESS + CTL_R_OFFSET) &= ~(UART_CTL_HSE);
+    }
+    return;
+}
+
 /******************************************************************************
 Reading
 *******************************************************************************/
 
 unsigned char UART_ReadChar(Uart_t uart) {
-    while((*uart->FLAG_REGISTER & 0x10) != 0) {
+    while((*uart->FLAG_REGISTER & UART_FR_RXFE) != 0) {
         __NOP();
     }
     return (unsigned char) REGISTER_VAL(uart->BASE_ADDRESS);
@@ -212,8 +260,16 @@ unsigned char UART_ReadChar(Uart_t uart) {
 Writing
 *******************************************************************************/
 
+static UartTxBuffer_t * getTxBuffer(Uart_t uart);
+static void writeToTxBuffer(Uart_t uart, const unsigned char chars[], uint32_t numChars);
+
 void UART_WriteChar(Uart_t uart, unsigned char inputChar) {
-    while((*uart->FLAG_REGISTER & 0x20) != 0) {
+    if(getTxBuffer(uart)->buffer != 0) {
+        writeToTxBuffer(uart, &inputChar, 1);
+        return;
+    }
+
+    while((*uart->FLAG_REGISTER & UART_FR_TXFF) != 0) {
         __NOP();
     }
     REGISTER_VAL(uart->BASE_ADDRESS) = inputChar;
@@ -222,6 +278,13 @@ void UART_WriteChar(Uart_t uart, unsigned char inputChar) {
 
 void UART_WriteStr(Uart_t uart, void * inputStr) {
     unsigned char * str_ptr = inputStr;
+
+    // buffer the whole string at once, so writes from other contexts can't split it
+    if(getTxBuffer(uart)->buffer != 0) {
+        writeToTxBuffer(uart, str_ptr, strlen(inputStr));
+        return;
+    }
+
     while(*str_ptr != '\0') {
         UART_WriteChar(uart, *str_ptr);
         str_ptr += 1;
@@ -229,6 +292,19 @@ void UART_WriteStr(Uart_t uart, void * inputStr) {
     return;
 }
 
+void UART_WriteBytes(Uart_t uart, const uint8_t bytes[], uint32_t N) {
+    // unlike strings, the data can contain zeros, so the length is given instead
+    if(getTxBuffer(uart)->buffer != 0) {
+        writeToTxBuffer(uart, bytes, N);
+        return;
+    }
+
+    for(uint32_t idx = 0; idx < N; idx++) {
+        UART_WriteChar(uart, bytes[idx]);
+    }
+    return;
+}
+
 void UART_WriteInt(Uart_t uart, int32_t n) {
     // Send negative sign (`-`) if needed
     if(n < 0) {
@@ -277,4 +353,120 @@ void UART_WriteFloat(Uart_t uart, double n, uint8_t numDecimals) {
     return;
 }
 
+/******************************************************************************
+Buffered Writing
+*******************************************************************************/
+
+static void fillHardwareFifo(Uart_t uart, UartTxBuffer_t * txBuffer);
+
+void UART_EnableTxBuffer(Uart_t uart, uint8_t buffer[], uint32_t N) {
+    assert(UART_isInit(uart));
+    assert(buffer != 0);
+    assert((N > 0) && ((N & (N - 1)) == 0));               // power of 2
+
+    UartTxBuffer_t * txBuffer = getTxBuffer(uart);
+    assert(txBuffer->buffer == 0);
+
+    txBuffer->mask = N - 1;
+    txBuffer->frontIdx = 0;
+    txBuffer->backIdx = 0;
+    txBuffer->numDropped = 0;
+
+    // interrupt when the hardware FIFO is almost empty, so each interrupt refills up to 14 chars
+    REGISTER_VAL(uart->BASE_ADDRESS + IFLS_R_OFFSET) &= ~(UART_IFLS_TX_M);
+    REGISTER_VAL(uart->BASE_ADDRESS + IFLS_R_OFFSET) |= UART_IFLS_TX1_8;
+
+    txBuffer->buffer = buffer;               // (NOTE: set last, since it enables buffering)
+    return;
+}
+
+void UART_handleTxInterrupt(Uart_t uart) {
+    REGISTER_VAL(uart->BASE_ADDRESS + ICR_R_OFFSET) = UART_ICR_TXIC;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    fillHardwareFifo(uart, getTxBuffer(uart));
+    __set_PRIMASK(primask);
+    return;
+}
+
+void UART_Flush(Uart_t uart) {
+    UartTxBuffer_t * txBuffer = getTxBuffer(uart);
+
+    // poll instead of waiting for the interrupt, so this works while interrupts are disabled
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if(txBuffer->buffer != 0) {
+        while(txBuffer->frontIdx != txBuffer->backIdx) {
+            fillHardwareFifo(uart, txBuffer);
+        }
+    }
+
+    while((*uart->FLAG_REGISTER & UART_FR_BUSY) != 0) {
+        __NOP();
+    }
+    __set_PRIMASK(primask);
+    return;
+}
+
+uint32_t UART_getNumDropped(Uart_t uart) {
+    return getTxBuffer(uart)->numDropped;
+}
+
+static UartTxBuffer_t * getTxBuffer(Uart_t uart) {
+    return &txBufferArray[uart - UART_STRUCT_ARRAY];
+}
+
+/**
+ * @brief   Copy chars into the TX buffer, and start sending them.
+ *
+ * @details Tasks and ISRs can both write, so the buffer is only used with interrupts disabled.
+ *          If the buffer is full, the newest chars are dropped instead of waiting for space.
+ */
+static void writeToTxBuffer(Uart_t uart, const unsigned char chars[], uint32_t numChars) {
+    UartTxBuffer_t * txBuffer = getTxBuffer(uart);
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint32_t numFree = (txBuffer->mask + 1) - (txBuffer->backIdx - txBuffer->frontIdx);
+    if(numChars > numFree) {
+        txBuffer->numDropped += numChars - numFree;
+        numChars = numFree;
+    }
+
+    for(uint32_t idx = 0; idx < numChars; idx++) {
+        txBuffer->buffer[(txBuffer->backIdx + idx) & txBuffer->mask] = chars[idx];
+    }
+    txBuffer->backIdx += numChars;
+
+    fillHardwareFifo(uart, txBuffer);
+    __set_PRIMASK(primask);
+    return;
+}
+
+/**
+ * @brief   Move chars from the TX buffer into the hardware FIFO until either is full/empty.
+ *
+ * @details The TX interrupt is only enabled while chars are left in the buffer. In that case the
+ *          hardware FIFO is full, so its level will drop through the trigger level.
+ *
+ * @pre     Disable interrupts.
+ */
+static void fillHardwareFifo(Uart_t uart, UartTxBuffer_t * txBuffer) {
+    while((txBuffer->frontIdx != txBuffer->backIdx) &&
+          ((*uart->FLAG_REGISTER & UART_FR_TXFF) == 0)) {
+        REGISTER_VAL(uart->BASE_ADDRESS) = txBuffer->buffer[txBuffer->frontIdx & txBuffer->mask];
+        txBuffer->frontIdx += 1;
+    }
+
+    if(txBuffer->frontIdx == txBuffer->backIdx) {
+        REGISTER_VAL(uart->BASE_ADDRESS + IM_R_OFFSET) &= ~(UART_IM_TXIM);
+    }
+    else {
+        REGISTER_VAL(uart->BASE_ADDRESS + IM_R_OFFSET) |= UART_IM_TXIM;
+    }
+    return;
+}
+
 /** @} */
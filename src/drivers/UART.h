@@ -11,6 +11,11 @@
  *
  *              UART1 uses PB0 (Rx) and PB1 (Tx), which are broken out but
  *              do not connect to a serial port.
+ *
+ *              By default, the write functions wait for space in the UART's
+ *              hardware FIFO. After UART_EnableTxBuffer(), they copy into a
+ *              software buffer instead and return immediately, and the UART's
+ *              interrupt moves the characters into the hardware FIFO.
  */
 
 #ifndef UART_H
@@ -19,8 +24,10 @@
 /******************************************************************************
 SECTIONS
         Initialization
+        Baud Rate
         Reading
         Writing
+        Buffered Writing
 *******************************************************************************/
 
 #include "GPIO.h"
@@ -64,6 +71,63 @@ Uart_t UART_Init(GpioPort_t port, uartNum_t uartNum);
  */
 bool UART_isInit(Uart_t uart);
 
+/******************************************************************************
+Baud Rate
+*******************************************************************************/
+
+#ifndef UART_DEFAULT_BAUD_RATE
+#define UART_DEFAULT_BAUD_RATE 115200               ///< baud rate set by UART_Init()
+#endif
+
+/// @brief  Baud rate divisor (BRD) settings.
+typedef struct {
+    uint16_t integer;                               ///< integer part of the BRD (`IBRD`)
+    uint8_t fraction;                               ///< fractional part in 64ths (`FBRD`)
+    bool isHighSpeed;                               ///< `ClkDiv` = 8 instead of 16 (`HSE`)
+} UartBaudDivisor_t;
+
+/**
+ * @brief                       Set the UART's baud rate.
+ *
+ * @details                     The divisor is calculated from the current bus frequency. Any
+ *                              buffered output is sent at the old baud rate first.
+ *
+ * @pre                         Initialize the UART.
+ * @param[in] uart              UART to configure.
+ * @param[in] baudRate          Baud rate in [bits/s]. At 80 [MHz], up to 5 [Mbit/s] (or
+ *                              10 [Mbit/s] in high-speed mode) is possible.
+ * @post                        The UART is briefly disabled while the divisor is changed.
+ *
+ * @see                         UART_calcBaudDivisor(), PLL_getBusFreq_Hz()
+ */
+void UART_setBaudRate(Uart_t uart, uint32_t baudRate);
+
+/**
+ * @brief                       Calculate the baud rate divisor for a baud rate.
+ *
+ * @details                     The divisor is \f$ BRD = f_{bus} / (ClkDiv * BR) \f$, where `IBRD`
+ *                              is its integer part and `FBRD` is its fractional part rounded to
+ *                              64ths. `ClkDiv` = 16 is used if possible since it samples each bit
+ *                              more often; `ClkDiv` = 8 (high-speed mode) is only used if
+ *                              `BRD` would be less than 1 otherwise.
+ *
+ * @param[in] busFreq_Hz        Bus frequency in [Hz].
+ * @param[in] baudRate          Baud rate in [bits/s].
+ * @param[out] divisorPtr       Divisor settings. Unchanged if the baud rate is not possible.
+ * @param[out] true             The baud rate is possible.
+ * @param[out] false            The baud rate is too high or too low for the bus frequency.
+ */
+bool UART_calcBaudDivisor(uint32_t busFreq_Hz, uint32_t baudRate, UartBaudDivisor_t * divisorPtr);
+
+/**
+ * @brief                       Calculate the actual baud rate that a divisor produces.
+ *
+ * @param[in] busFreq_Hz        Bus frequency in [Hz].
+ * @param[in] divisorPtr        Divisor settings.
+ * @param[out] uint32_t         Baud rate in [bits/s] (rounded down).
+ */
+uint32_t UART_calcBaudRate(uint32_t busFreq_Hz, const UartBaudDivisor_t * divisorPtr);
+
 /******************************************************************************
 Reading
 *******************************************************************************/
@@ -96,6 +160,15 @@ void UART_WriteChar(Uart_t uart, unsigned char inputChar);
  */
 void UART_WriteStr(Uart_t uart, void * inputStr);
 
+/**
+ * @brief                       Write an array of bytes (e.g. binary data) to the UART.
+ *
+ * @param[in] uart              UART to write to.
+ * @param[in] bytes             Array of bytes. Unlike `UART_WriteStr()`, zeros are sent too.
+ * @param[in] N                 Number of bytes to send.
+ */
+void UART_WriteBytes(Uart_t uart, const uint8_t bytes[], uint32_t N);
+
 /**
  * @brief                       Write a 32-bit unsigned integer the UART.
  *
@@ -113,6 +186,57 @@ void UART_WriteInt(Uart_t uart, int32_t n);
  */
 void UART_WriteFloat(Uart_t uart, double n, uint8_t numDecimals);
 
+/******************************************************************************
+Buffered Writing
+*******************************************************************************/
+
+/**
+ * @brief                       Send the UART's output via a TX buffer instead of waiting
+ *                              for space in its hardware FIFO.
+ *
+ * @details                     Afterwards, the write functions are non-blocking and can be
+ *                              called from both tasks and ISRs. If the buffer is full, the
+ *                              newest characters are dropped and counted.
+ *
+ * @pre                         Initialize the UART.
+ * @pre                         Call UART_handleTxInterrupt() from the UART's ISR, and
+ *                              enable the ISR.
+ * @param[in] uart              UART to buffer.
+ * @param[in] buffer            Array to use as the TX buffer.
+ * @param[in] N                 Length of `buffer`. Must be a power of 2.
+ *
+ * @see                         UART_Flush(), UART_getNumDropped()
+ */
+void UART_EnableTxBuffer(Uart_t uart, uint8_t buffer[], uint32_t N);
+
+/**
+ * @brief                       Move buffered characters into the UART's hardware FIFO.
+ *
+ * @param[in] uart              UART that raised the interrupt.
+ * @post                        The TX interrupt is cleared, and disabled if the buffer is
+ *                              empty.
+ */
+void UART_handleTxInterrupt(Uart_t uart);
+
+/**
+ * @brief                       Wait until all buffered characters have been sent.
+ *
+ * @details                     This polls the UART, so it also works while interrupts are
+ *                              disabled (e.g. before stopping on a failed assertion).
+ *
+ * @param[in] uart              UART to flush.
+ */
+void UART_Flush(Uart_t uart);
+
+/**
+ * @brief                       Get the num. of characters dropped because the TX buffer was
+ *                              full.
+ *
+ * @param[in] uart              UART to check.
+ * @param[out] uint32_t         Num. of dropped characters since UART_EnableTxBuffer().
+ */
+uint32_t UART_getNumDropped(Uart_t uart);
+
 #endif
 
 /** @} */
@@ -0,0 +1,74 @@
+/**
+ * @addtogroup uart
+ * @{
+ *
+ * @file
+ * @author  Bryan McElvy
+ * @brief   Baud rate divisor calculations for the UART module.
+ *
+ * @details These functions don't access any registers, so they can also be built and tested on
+ *          the host.
+ */
+
+#include "UART.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+enum BAUD_DIVISOR_LIMITS {
+    IBRD_MAX = 0xFFFF,
+    FBRD_BITS = 6,                                  ///< i.e. `FBRD` is in 64ths
+    FBRD_MASK = (1 << FBRD_BITS) - 1,
+    CLK_DIV_NORMAL = 16,
+    CLK_DIV_HIGH_SPEED = 8
+};
+
+static bool calcDivisor(uint32_t busFreq_Hz, uint32_t baudRate, uint32_t clkDiv,
+                        UartBaudDivisor_t * divisorPtr);
+
+bool UART_calcBaudDivisor(uint32_t busFreq_Hz, uint32_t baudRate, UartBaudDivisor_t * divisorPtr) {
+    if(baudRate == 0) {
+        return false;
+    }
+
+    if(calcDivisor(busFreq_Hz, baudRate, CLK_DIV_NORMAL, divisorPtr)) {
+        divisorPtr->isHighSpeed = false;
+        return true;
+    }
+    else if(calcDivisor(busFreq_Hz, baudRate, CLK_DIV_HIGH_SPEED, divisorPtr)) {
+        divisorPtr->isHighSpeed = true;
+        return true;
+    }
+
+    return false;
+}
+
+uint32_t UART_calcBaudRate(uint32_t busFreq_Hz, const UartBaudDivisor_t * divisorPtr) {
+    uint32_t clkDiv = (divisorPtr->isHighSpeed) ? CLK_DIV_HIGH_SPEED : CLK_DIV_NORMAL;
+    uint64_t divisor_64ths = ((uint64_t) divisorPtr->integer << FBRD_BITS) + divisorPtr->fraction;
+
+    // BR = f_bus / (ClkDiv * BRD) = (f_bus * 64) / (ClkDiv * BRD * 64)
+    return (uint32_t) (((uint64_t) busFreq_Hz << FBRD_BITS) / (clkDiv * divisor_64ths));
+}
+
+static bool calcDivisor(uint32_t busFreq_Hz, uint32_t baudRate, uint32_t clkDiv,
+                        UartBaudDivisor_t * divisorPtr) {
+    // BRD * 64, rounded to the nearest integer (which also rounds `FBRD`)
+    uint64_t numerator = (uint64_t) busFreq_Hz << FBRD_BITS;
+    uint64_t denominator = (uint64_t) clkDiv * baudRate;
+    uint64_t divisor_64ths = (numerator + (denominator / 2)) / denominator;
+
+    uint64_t integer = divisor_64ths >> FBRD_BITS;
+    uint64_t fraction = divisor_64ths & FBRD_MASK;
+
+    // the largest divisor is `IBRD_MAX` exactly
+    if((integer < 1) || (integer > IBRD_MAX) || ((integer == IBRD_MAX) && (fraction > 0))) {
+        return false;
+    }
+
+    divisorPtr->integer = (uint16_t) integer;
+    divisorPtr->fraction = (uint8_t) fraction;
+    return true;
+}
+
+/** @} */
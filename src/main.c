@@ -26,6 +26,7 @@ Direct Dependencies
 
 // middleware
 #include "Debug.h"
+#include "Telemetry.h"
 
 // common
 #include "FIFO.h"
@@ -60,11 +61,10 @@ enum ISR_VECTOR_NUMS {
  *
  * @details This ISR has a priority level of 1, is triggered when the ADC has finished capturing
  *          a sample, and also triggers the intermediate processing handler. It reads the 12-bit
- *          ADC output, converts it from an integer to a raw voltage sample, and sends it to the
- *          processing ISR via the @ref DAQ_Fifo.
+ *          ADC output and sends it to the processing ISR via the @ref DAQ_Fifo.
  *
  * @pre     Initialize the DAQ module.
- * @post    The converted sample is placed in the DAQ FIFO, and the processing ISR is triggered.
+ * @post    The raw sample is placed in the DAQ FIFO, and the processing ISR is triggered.
  *
  * @see     DAQ_Init(), Processing_Handler()
  *
@@ -76,12 +76,11 @@ static void DAQ_Handler(void);
  * @brief   ISR for intermediate processing of the input data.
  *
  * @details This ISR has a priority level of 1, is triggered by the DAQ ISR, and triggers the LCD
- *          handler. It removes baseline drift and power line interference (PLI) from a sample, and
- *          then moves it to the @ref QRS_Fifo and the @ref LCD_Fifo. It also notifies the superloop
- *          in @ref main() when the QRS buffer is full.
+ *          handler. It converts a raw sample to a voltage sample, removes baseline drift and power
+ *          line interference (PLI) from a sample, and then places it in the @ref Sample_Fifo,
+ *          which is read by both the LCD ISR and the QRS detector in @ref main().
  *
- * @post    The converted sample is placed in the LCD FIFO, and the LCD ISR is triggered.
- * @post    The converted sample is placed in the QRS FIFO, and the flag is set.
+ * @post    The converted sample is placed in the sample FIFO, and the LCD ISR is triggered.
  *
  * @see     DAQ_Handler(), main(), LCD_Handler()
  *
@@ -109,37 +108,36 @@ static void LCD_Handler(void);
 Variable Declarations
 ******************************************************************************/
 
-enum FIFO_INFO {
-    DAQ_FIFO_CAP = 3,                                   ///< capacity of DAQ's FIFO buffer
-    DAQ_ARRAY_LEN = DAQ_FIFO_CAP + 1,                   ///< actual size of underlying array
-
-    QRS_FIFO_CAP = QRS_NUM_SAMP,                        ///< capacity of QRS detector's FIFO buffer
-    QRS_ARRAY_LEN = QRS_FIFO_CAP + 1,                   ///< actual size of underlying array
+#ifdef USE_FIXED_POINT
+typedef q15_t Sample_t;               // half the size
+#else
+typedef float32_t Sample_t;
+#endif
 
-    LCD_FIFO_1_CAP = DAQ_FIFO_CAP,                      ///< capacity of LCD's waveform FIFO buffer
-    LCD_ARRAY_1_LEN = LCD_FIFO_1_CAP + 1,               ///< actual size of underlying array
-
-    LCD_FIFO_2_CAP = 1,                                ///< capacity of LCD's heart rate FIFO buffer
-    LCD_ARRAY_2_LEN = LCD_FIFO_2_CAP + 1               ///< actual size of underlying array
+// NOTE: each FIFO has one producer and one consumer, so the lock-free ring buffers are used
+enum FIFO_INFO {
+    DAQ_FIFO_LEN = 4,                                   ///< length of DAQ's FIFO (power of 2)
+    SAMPLE_FIFO_LEN = 2 * QRS_NUM_SAMP,                 ///< length of processed sample FIFO
+    LCD_BLOCK_LEN = DAQ_FIFO_LEN,                       ///< max. samples plotted per LCD ISR
+    LCD_FIFO_LEN = 1                                    ///< length of LCD's heart rate FIFO
 };
 
-static volatile Fifo_t DAQ_Fifo = 0;
-static volatile uint32_t DAQ_fifoBuffer[DAQ_ARRAY_LEN] = { 0 };
+static RingFifo16_t DAQ_Fifo = 0;                                    ///< raw 12-bit samples
+static uint16_t DAQ_fifoBuffer[DAQ_FIFO_LEN] = { 0 };
 
-static volatile Fifo_t QRS_Fifo = 0;
-static volatile uint32_t QRS_fifoBuffer[QRS_ARRAY_LEN] = { 0 };
-
-static volatile Fifo_t LCD_Fifo1 = 0;
-static volatile uint32_t LCD_fifoBuffer1[LCD_ARRAY_1_LEN] = { 0 };
-
-static volatile Fifo_t LCD_Fifo2 = 0;
-static volatile uint32_t LCD_fifoBuffer2[LCD_ARRAY_2_LEN] = { 0 };
+/**
+ * @note    Each processed sample is written once to @ref Sample_Fifo, which is read by both the
+ *          QRS detector and the LCD. It holds two blocks of `QRS_NUM_SAMP` samples, so the
+ *          processing ISR fills one while the superloop analyzes the other in place.
+ */
+static BroadcastFifo_t Sample_Fifo = 0;
+static Sample_t Sample_fifoBuffer[SAMPLE_FIFO_LEN] = { 0 };
 
-static volatile bool qrsBufferIsFull = false;                ///< flag for QRS detection to start
-static volatile bool heartRateIsReady = false;               ///< flag for LCD to output heart rate
+static BroadcastReader_t QRS_Reader = 0;                             ///< whole blocks
+static BroadcastReader_t LCD_Reader = 0;                             ///< single samples
 
-// NOTE: using just one processing buffer to avoid running out of RAM
-static float32_t QRS_processingBuffer[QRS_ARRAY_LEN] = { 0 };
+static RingFifoFloat_t LCD_Fifo = 0;
+static float32_t LCD_fifoBuffer[LCD_FIFO_LEN] = { 0 };
 
 enum LCD_INFO {
     LCD_TOP_LINE = (LCD_Y_MAX - 24),               ///< separates wavefrom from text
@@ -153,8 +151,6 @@ enum LCD_INFO {
     LCD_TEXT_COL_NUM = 24               ///< starting col. num. for heart rate
 };
 
-static uint16_t LCD_prevSampleBuffer[LCD_X_MAX] = { 0 };
-
 /******************************************************************************
 Function Definitions
 ******************************************************************************/
@@ -176,6 +172,9 @@ int main(void) {
     // Init. debug module
     portA = GPIO_InitPort(GPIO_PORT_A);
     uart0 = UART_Init(portA, UART0);
+#ifdef DEBUG_DEFERRED
+    Telemetry_Init(uart0);
+#endif
     Debug_Init(uart0);
 
     // Init. vector table and ISRs
@@ -195,10 +194,16 @@ int main(void) {
     ISR_Enable(LCD_VECTOR_NUM);
 
     // Init. FIFOs
-    DAQ_Fifo = Fifo_Init(DAQ_fifoBuffer, DAQ_ARRAY_LEN);
-    QRS_Fifo = Fifo_Init(QRS_fifoBuffer, QRS_ARRAY_LEN);
-    LCD_Fifo1 = Fifo_Init(LCD_fifoBuffer1, LCD_ARRAY_1_LEN);
-    LCD_Fifo2 = Fifo_Init(LCD_fifoBuffer2, LCD_ARRAY_2_LEN);
+    DAQ_Fifo = RingFifo16_Init(DAQ_fifoBuffer, DAQ_FIFO_LEN);
+    LCD_Fifo = RingFifoFloat_Init(LCD_fifoBuffer, LCD_FIFO_LEN);
+
+    Sample_Fifo = BroadcastFifo_Init(Sample_fifoBuffer, SAMPLE_FIFO_LEN, sizeof(Sample_t));
+    QRS_Reader = BroadcastFifo_AddReader(Sample_Fifo);
+    LCD_Reader = BroadcastFifo_AddReader(Sample_Fifo);
+
+    // a full sample FIFO drops the new sample (counted if `FIFO_RING_STATS` is defined),
+    // but only the latest heart rate is worth displaying
+    RingFifoFloat_setOverflowPolicy(LCD_Fifo, RING_FIFO_DROP_OLDEST);
 
     // Init./config. LCD
     LCD_Init();
@@ -225,52 +230,96 @@ int main(void) {
     // Enable interrupts and start
     ISR_GlobalEnable();
     while(1) {
-        if(qrsBufferIsFull) {               // flag set by Processing_Handler()
-            // Transfer samples from FIFO
-            ISR_Disable(PROC_VECTOR_NUM);
-
-            Fifo_FlushFloat(QRS_Fifo, QRS_processingBuffer);
-            qrsBufferIsFull = false;
-
-            ISR_Enable(PROC_VECTOR_NUM);
+        // Wait for a full block that the LCD has already read, since it's modified in place
+        // NOTE: the QRS lag is loaded first, so new samples can only make this check stricter
+        uint32_t qrsLag = BroadcastFifo_getLag(QRS_Reader);
+        bool isBlockReady = (qrsLag >= QRS_NUM_SAMP) &&
+                            ((BroadcastFifo_getLag(LCD_Reader) + QRS_NUM_SAMP) <= qrsLag);
+        if(isBlockReady) {
+            void * span;
+            BroadcastFifo_PeekSpan(QRS_Reader, &span);
+            // NOTE: blocks never wrap, since the FIFO's length is a multiple of `QRS_NUM_SAMP`
+            Sample_t * block = (Sample_t *) span;
 
             // Run QRS detection
-            Debug_SendMsg("Starting QRS detection...\r\n");
-
-            QRS_Preprocess(QRS_processingBuffer, QRS_processingBuffer);
-            float32_t heartRate_bpm = QRS_applyDecisionRules(QRS_processingBuffer);
+            Debug_SendFromList(DEBUG_QRS_START);
+
+#ifdef USE_FIXED_POINT
+            QRS_Preprocess_q15(block, block);
+            float32_t heartRate_bpm = QRS_applyDecisionRules_q15(block);
+#else
+            QRS_Preprocess(block, block);
+            float32_t heartRate_bpm = QRS_applyDecisionRules(block);
+#endif
             Debug_Assert(isfinite(heartRate_bpm));
 
+            // Give the block back before the ISR fills the other one
+            BroadcastFifo_Release(QRS_Reader, QRS_NUM_SAMP);
+
             // Output heart rate to serial port
             Debug_WriteFloat(heartRate_bpm);
 
             // Output heart rate to LCD
-            Fifo_PutFloat(LCD_Fifo2, heartRate_bpm);
-            heartRateIsReady = true;
+            RingFifoFloat_Put(LCD_Fifo, heartRate_bpm);
+
+#ifdef FIFO_RING_STATS
+            // Output FIFO usage to serial port
+            RingFifoStats_t stats;
+            RingFifo16_getStats(DAQ_Fifo, &stats);
+            Debug_WriteFifoStats("DAQ_Fifo", &stats);
+            BroadcastFifo_getStats(Sample_Fifo, &stats);
+            Debug_WriteFifoStats("Sample_Fifo", &stats);
+            BroadcastFifo_getReaderStats(QRS_Reader, &stats);
+            Debug_WriteFifoStats("QRS_Reader", &stats);
+            BroadcastFifo_getReaderStats(LCD_Reader, &stats);
+            Debug_WriteFifoStats("LCD_Reader", &stats);
+            RingFifoFloat_getStats(LCD_Fifo, &stats);
+            Debug_WriteFifoStats("LCD_Fifo", &stats);
+#endif
         }
     }
 }
 
 static void DAQ_Handler(void) {
-    // read sample and convert to `float32_t`
     uint16_t rawSample = DAQ_readSample();
-    volatile float32_t sample = DAQ_convertToMilliVolts(rawSample);
 
     // send to intermediate processing handler
-    Debug_Assert(Fifo_isFull(DAQ_Fifo) == false);
-    Fifo_PutFloat(DAQ_Fifo, sample);
+    RingFifo16_Put(DAQ_Fifo, rawSample);
     ISR_triggerInterrupt(PROC_VECTOR_NUM);
 
     DAQ_acknowledgeInterrupt();
 }
 
 static void Processing_Handler(void) {
+#ifdef USE_FIXED_POINT
+    static int64_t sum = 0;
+#else
     static float32_t sum = 0;
+#endif
     static uint32_t N = 0;
 
-    // NOTE: this `while` is only here in case a sample arrives while the QRS FIFO is being emptied
-    while(Fifo_isEmpty(DAQ_Fifo) == false) {
-        volatile float32_t sample = Fifo_GetFloat(DAQ_Fifo);
+    // NOTE: more than one sample can arrive before this ISR runs
+    uint16_t rawSamples[DAQ_FIFO_LEN];
+    uint32_t numSamples = RingFifo16_GetBlock(DAQ_Fifo, rawSamples, DAQ_FIFO_LEN);
+    for(uint32_t idx = 0; idx < numSamples; idx++) {
+#ifdef USE_FIXED_POINT
+        // convert to `q15_t`
+        q15_t sample = DAQ_convertToQ15(rawSamples[idx]);
+
+        // apply running mean subtraction to remove baseline drift
+        sum += sample;
+        N += 1;
+        int32_t diff = (int32_t) sample - (int32_t) (sum / N);               // can exceed `q15_t`
+        sample = (q15_t) __SSAT(diff, 16);
+
+        // apply 60 [Hz] notch filter to remove power line noise
+        sample = DAQ_NotchFilter_q15(sample);
+
+        // place in sample FIFO for the QRS detector and LCD
+        BroadcastFifo_Put(Sample_Fifo, &sample);
+#else
+        // convert to `float32_t`
+        float32_t sample = DAQ_convertToMilliVolts(rawSamples[idx]);
 
         // apply running mean subtraction to remove baseline drift
         sum += sample;
@@ -280,55 +329,51 @@ static void Processing_Handler(void) {
         // apply 60 [Hz] notch filter to remove power line noise
         sample = DAQ_NotchFilter(sample);
 
-        // place in FIFO buffers
-        Debug_Assert(Fifo_isFull(QRS_Fifo) == false);
-        Fifo_PutFloat(QRS_Fifo, sample);
-
-        Debug_Assert(Fifo_isFull(LCD_Fifo1) == false);
-        Fifo_PutFloat(LCD_Fifo1, sample);
+        // place in sample FIFO for the QRS detector and LCD
+        BroadcastFifo_Put(Sample_Fifo, &sample);
+#endif
     }
 
-    if(Fifo_isFull(QRS_Fifo)) {
-        qrsBufferIsFull = true;
-    }
-    else {
-        // doesn't trigger if QRS detection is ready to start
-        ISR_triggerInterrupt(LCD_VECTOR_NUM);
-    }
+    ISR_triggerInterrupt(LCD_VECTOR_NUM);
 }
 
 static void LCD_Handler(void) {
     static uint16_t x = 0;
+#ifndef USE_FIXED_POINT
     static const float32_t maxVal = DAQ_LOOKUP_MAX * 2;
-
-    Debug_Assert(Fifo_isEmpty(LCD_Fifo1) == false);
-
-    // NOTE: this `while` is only here in case a sample arrives while the QRS FIFO is being emptied
-    while(Fifo_isEmpty(LCD_Fifo1) == false) {
-        // get sample and apply 0.5-40 [Hz] bandpass filter
-        float32_t sample = Fifo_GetFloat(LCD_Fifo1);
+#endif
+
+    // NOTE: this loop is only here in case more than one sample arrives before this ISR runs
+    Sample_t samples[LCD_BLOCK_LEN];
+    uint32_t numSamples = BroadcastFifo_GetBlock(LCD_Reader, samples, LCD_BLOCK_LEN);
+    for(uint32_t idx = 0; idx < numSamples; idx++) {
+        Sample_t sample = samples[idx];
+
+        // apply 0.5-40 [Hz] bandpass filter
+#ifdef USE_FIXED_POINT
+        sample = DAQ_BandpassFilter_q15(sample);
+#else
         sample = DAQ_BandpassFilter(sample);
-
-        // remove previous y-value from LCD
-        uint16_t y = LCD_prevSampleBuffer[x];
-        LCD_plotSample(x, y, LCD_BLACK);
+#endif
 
         // shift/scale `sample` from (est.) range [-11, 11) to [LCD_WAVE_Y_MIN, LCD_WAVE_Y_MAX)
+        uint16_t y;
+#ifdef USE_FIXED_POINT
+        // NOTE: `sample` is in range [-5.5, 5.5), i.e. [-0x8000, 0x8000) in `q15_t`
+        y = LCD_WAVE_Y_MIN + ((uint16_t) ((((int32_t) sample + 0x10000) * LCD_WAVE_Y_MAX) >> 17));
+#else
         y = LCD_WAVE_Y_MIN + ((uint16_t) (((sample + maxVal) / (maxVal * 2)) * LCD_WAVE_Y_MAX));
-        LCD_plotSample(x, y, LCD_RED);
-
-        // store y-value and update x
-        LCD_prevSampleBuffer[x] = y;
+#endif
+        LCD_plotWaveSample(x, y, LCD_RED);               // also erases the old segment
         x = (x + 1) % LCD_X_MAX;
     }
 
-    if(heartRateIsReady) {
-        volatile float32_t heartRate_bpm = Fifo_GetFloat(LCD_Fifo2);
-
+    // NOTE: checking first, since finding it empty here is normal rather than an underflow
+    float32_t heartRate_bpm;
+    if((RingFifoFloat_isEmpty(LCD_Fifo) == false) &&
+       RingFifoFloat_Get(LCD_Fifo, &heartRate_bpm)) {               // set by main()
         LCD_setCursor(LCD_TEXT_LINE_NUM, LCD_TEXT_COL_NUM);
         LCD_writeFloat(heartRate_bpm);
-
-        heartRateIsReady = false;
     }
 }
 
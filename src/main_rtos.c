@@ -11,7 +11,8 @@
 SECTIONS
         Direct Dependencies
         FreeRTOS Task Declarations
-        FreeRTOS Queue Declarations
+        Inter-Task Communication Declarations
+        Run-Time Statistics Declarations
         Other Declarations
         Main Function Definition
         ISR/Task Definitions
@@ -28,17 +29,23 @@ Direct Dependencies
 
 // middleware
 #include "Debug.h"
+#include "Telemetry.h"
+
+// common
+#include "FIFO.h"
 
 // drivers
 #include "GPIO.h"
 #include "ISR.h"
 #include "PLL.h"
+#include "Timer.h"
 #include "UART.h"
 
 // vendor (i.e. external/device) files
 #include "arm_math_types.h"
 #include "FreeRTOS.h"
-#include "queue.h"               // FreeRTOS
+#include "semphr.h"              // FreeRTOS
+#include "stream_buffer.h"       // FreeRTOS
 #include "task.h"                // FreeRTOS
 #include "tm4c123gh6pm.h"
 
@@ -46,64 +53,130 @@ Direct Dependencies
 #include <math.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 
 /******************************************************************************
 FreeRTOS Task Declarations
 ******************************************************************************/
 
-#define STACK_SIZE     ((UBaseType_t) 200)
+/**
+ * @details Each task's stack size (in words) is its deepest call chain as reported by the
+ *          compiler's stack usage info (`-fstack-usage`), plus 51 words for a context switch that
+ *          saves the FPU registers, plus a ~25% margin. The stacks are filled with a known value
+ *          when the tasks are created, so the @ref StatsTask reports each task's peak usage; use
+ *          it to adjust these sizes when the code changes.
+ *
+ *          Task                   | Call chain [B] | Size [words]
+ *          -----------------------|----------------|-------------
+ *          @ref ProcessingTask    | 296            | 160
+ *          @ref QrsDetectionTask  | 284            | 160
+ *          @ref LcdWaveformTask   | 492            | 224
+ *          @ref LcdHeartRateTask  | 668            | 280
+ *          @ref StatsTask         | 408            | 192
+ *
+ *          With `USE_TELEMETRY`, sending a frame adds ~180 [B] to the processing and QRS tasks'
+ *          call chains, so their stacks grow to 224 words. With `DEBUG_DEFERRED`, packing a log
+ *          record adds ~100 [B] to every task that uses the @ref debug module, so the QRS and
+ *          stats tasks' stacks grow to 224 words.
+ *
+ *          Host builds can use a single, larger size for every task by defining
+ *          `STACK_SIZE(size)`.
+ */
+#ifndef STACK_SIZE
+#define STACK_SIZE(size)        ((UBaseType_t) (size))
+#endif
+
+#ifdef USE_TELEMETRY
+#define PROC_STACK_SIZE         STACK_SIZE(224)
+#else
+#define PROC_STACK_SIZE         STACK_SIZE(160)
+#endif
 
-#define Daq_Handler    ADC0_SS3_Handler
-#define DAQ_VECTOR_NUM (INT_ADC0SS3)
+#if defined(USE_TELEMETRY) || defined(DEBUG_DEFERRED)
+#define QRS_STACK_SIZE          STACK_SIZE(224)
+#else
+#define QRS_STACK_SIZE          STACK_SIZE(160)
+#endif
+
+#define LCD_WAVEFORM_STACK_SIZE STACK_SIZE(224)
+#define LCD_HR_STACK_SIZE       STACK_SIZE(280)
+
+#ifdef DEBUG_DEFERRED
+#define STATS_STACK_SIZE        STACK_SIZE(224)
+#else
+#define STATS_STACK_SIZE        STACK_SIZE(192)
+#endif
+
+#define Daq_Handler           ADC0_SS3_Handler
+#define DAQ_VECTOR_NUM        (INT_ADC0SS3)
+
+#define DebugUart_Handler     UART0_Handler
+#define DEBUG_UART_VECTOR_NUM (INT_UART0)
 
 enum TASK_PRIORITIES {
     DAQ_HANDLER_PRI = 1,
+    DEBUG_UART_HANDLER_PRI = 2,                 ///< lower than the DAQ ISR, so it can't delay it
     PROC_TASK_PRI = 3,
     QRS_TASK_PRI = 2,
     LCD_WAVEFORM_TASK_PRI = PROC_TASK_PRI,
     LCD_HR_TASK_PRI = QRS_TASK_PRI,
+    STATS_TASK_PRI = 1,
 };
 
 static TaskHandle_t ProcessingTaskHandle = 0;
-static StackType_t ProcessingStack[STACK_SIZE] = { 0 };
+static StackType_t ProcessingStack[PROC_STACK_SIZE] = { 0 };
 static StaticTask_t ProcessingTaskBuffer = { 0 };
 
 static TaskHandle_t QrsDetectionTaskHandle = 0;
-static StackType_t QrsDetectionStack[STACK_SIZE] = { 0 };
+static StackType_t QrsDetectionStack[QRS_STACK_SIZE] = { 0 };
 static StaticTask_t QrsDetectionTaskBuffer = { 0 };
 
 static TaskHandle_t LcdWaveformTaskHandle = 0;
-static StackType_t LcdWaveformStack[STACK_SIZE] = { 0 };
+static StackType_t LcdWaveformStack[LCD_WAVEFORM_STACK_SIZE] = { 0 };
 static StaticTask_t LcdWaveformTaskBuffer = { 0 };
 
 static TaskHandle_t LcdHeartRateTaskHandle = 0;
-static StackType_t LcdHeartRateStack[STACK_SIZE] = { 0 };
+static StackType_t LcdHeartRateStack[LCD_HR_STACK_SIZE] = { 0 };
 static StaticTask_t LcdHeartRateTaskBuffer = { 0 };
 
+static TaskHandle_t StatsTaskHandle = 0;
+static StackType_t StatsStack[STATS_STACK_SIZE] = { 0 };
+static StaticTask_t StatsTaskBuffer = { 0 };
+
 /**
  * @brief   ISR for the data acquisition system.
  *
  * @details This ISR is triggered when the ADC has finished capturing a sample, and also triggers
- *          the intermediate processing task. It reads the 12-bit ADC output, converts it from an
- *          integer to a raw voltage sample, and sends it to the processing task.
+ *          the intermediate processing task. It reads the 12-bit ADC output and sends it to the
+ *          processing task, which converts it to a raw voltage sample.
  *
  * @pre     Initialize the DAQ module.
- * @post    The converted sample is placed in the @ref Daq2ProcQueue.
- * @post    The processing task is resumed.
+ * @post    The ADC output is placed in the @ref Daq2ProcStream, which wakes the processing task.
  *
  * @see     DAQ_Init(), ProcessingTask()
  */
 void Daq_Handler(void);
 
+/**
+ * @brief   ISR for the debug UART's transmitter.
+ *
+ * @details This ISR is triggered when the UART's hardware FIFO is almost empty. It refills it from
+ *          the @ref DebugTxBuffer.
+ *
+ * @see     UART_EnableTxBuffer(), UART_handleTxInterrupt()
+ */
+void DebugUart_Handler(void);
+
 /**
  * @brief   Task for intermediate processing of the input data.
  *
- * @details This task is triggered by the DAQ handler. It removes baseline drift and power line
- *          interference (PLI) from a sample, and then sends it to the @ref QrsDetectionTask
- *          and @ref LcdWaveformTask.
+ * @details This task blocks until the DAQ handler sends sample(s). It converts each sample to
+ *          [mV], removes baseline drift and power line interference (PLI), and then places it in
+ *          the @ref ProcSampleFifo, which is read by both the @ref QrsDetectionTask and the
+ *          @ref LcdWaveformTask.
  *
- * @post    The converted sample is sent to the @ref QrsDetectionTask.
- * @post    The converted sample is sent to the @ref LcdWaveformTask.
+ * @post    The converted sample is placed in the @ref ProcSampleFifo.
+ * @post    The @ref QrsDetectionTask and @ref LcdWaveformTask are notified.
  *
  * @see     Daq_Handler(), QrsDetectionTask(), LcdWaveformTask()
  */
@@ -112,9 +185,9 @@ static void ProcessingTask(void * params);
 /**
  * @brief   Task for heart rate calculation via QRS detection.
  *
- * @details This task is triggered by the @ref ProcessingTask. It unloads the @ref Proc2QrsQueue
- *          within a critical section, performs QRS detection, and then sends the heart rate
- *          value to the @ref LcdHeartRateTask.
+ * @details This task is notified by the @ref ProcessingTask. It passes each new sample in the
+ *          @ref ProcSampleFifo to the QRS detector, and sends the heart rate value to the
+ *          @ref LcdHeartRateTask whenever a new beat is confirmed.
  *
  * @post    The heart rate value is sent to the @ref LcdHeartRateTask to be plotted on the display.
  *
@@ -125,7 +198,7 @@ static void QrsDetectionTask(void * params);
 /**
  * @brief   Task for plotting the waveform on the LCD.
  *
- * @details This task is triggered by the @ref ProcessingTask. It applies a 0.5-40 [Hz] bandpass
+ * @details This task is notified by the @ref ProcessingTask. It applies a 0.5-40 [Hz] bandpass
  *          filter to the sample and plots it.
  *
  * @pre     Initialize the LCD module.
@@ -138,51 +211,153 @@ static void LcdWaveformTask(void * params);
 /**
  * @brief   Task for outputting the heart rate to the LCD.
  *
- * @details This task is triggered by the @ref QrsDetectionTask. It outputs the heart rate.
+ * @details This task is notified by the @ref QrsDetectionTask, with the new heart rate as the
+ *          notification value. It outputs the heart rate.
  *
  * @pre     Initialize the LCD module.
- * @post    The heart rate is updated after each block is analyzed.
+ * @post    The heart rate is updated after each beat is detected.
  *
  * @see     LCD_Init(), QrsDetectionTask()
  */
 static void LcdHeartRateTask(void * params);
 
+/**
+ * @brief   Task for reporting the CPU load and stack usage.
+ *
+ * @details This task runs every @ref STATS_PERIOD_MS and writes the CPU load of each task, the
+ *          idle task, and the @ref Daq_Handler over the last period to the serial port. It also
+ *          writes each task's peak stack usage so far, from its high water mark.
+ *
+ * @pre     Initialize the Debug module.
+ * @post    A CPU load and stack usage report is written to the serial port.
+ *
+ * @see     vConfigureTimerForRunTimeStats(), Debug_WriteCpuLoad(), Debug_WriteStackUsage()
+ */
+static void StatsTask(void * params);
+
+/// @brief  Return a task's stack size in words (for the @ref StatsTask's stack usage report).
+static uint32_t getStackSize(TaskHandle_t task);
+
 /******************************************************************************
-FreeRTOS Queue Declarations
+Inter-Task Communication Declarations
 ******************************************************************************/
 
-enum QUEUE_INFO {
-    QUEUE_ITEM_SIZE = sizeof(uint32_t),               ///< size in bytes for each queue
+/**
+ * @details Each task blocks until it has something to do, instead of suspending itself and being
+ *          resumed. A notification or stream buffer write that arrives before the task blocks is
+ *          kept, so no wake-up is lost.
+ *
+ *          - DAQ ISR -> processing task: stream buffer of `uint16_t` ADC outputs.
+ *          - Processing task -> QRS/LCD tasks: broadcast ring buffer, plus a notification.
+ *          - QRS task -> LCD heart rate task: notification value (overwritten by newer values).
+ *          - LCD tasks: mutex around each sequence of `LCD_*` calls (see @ref LcdMutex).
+ */
+
+/**
+ * @note    The QRS/LCD tasks are only notified once the processing task has handled everything it
+ *          received from the stream buffer, so @ref PROC_SAMPLE_LEN must be at least
+ *          @ref DAQ_2_PROC_LEN (and a power of 2).
+ *
+ * @details The rest of the @ref ProcSampleFifo covers its readers' latency. The QRS task can be
+ *          held off by the processing and waveform tasks (< 1 [ms] per sample at the default
+ *          SPI bit rate) and by one heart rate update (~5 characters, < 1 [ms]), so it is rarely
+ *          more than one stream buffer read behind. The 10 spare samples (50 [ms] at 200 [Hz])
+ *          leave a wide margin; if they still run out, the newest samples are dropped, and the
+ *          @ref StatsTask reports how many.
+ */
+enum TRANSPORT_INFO {
+    DAQ_2_PROC_LEN = 6,                               ///< num. samples in DAQ-to-Processing stream
+    PROC_SAMPLE_LEN = 16,                             ///< length of processed sample FIFO
+};
 
-    DAQ_2_PROC_LEN = 3,                               ///< length of DAQ-to-Processing task queue
-    PROC_2_QRS_LEN = QRS_NUM_SAMP,                    ///< length of Processing-to-QRS task queue
-    PROC_2_LCD_LEN = DAQ_2_PROC_LEN,                  ///< length of Processing-to-LCD task queue
-    QRS_2_LCD_LEN = 1,                                ///< length of QRS-to-LCD task queue
+/// @note   Index 0 is used internally by stream buffers, so direct notifications use the others.
+enum NOTIFY_INDICES {
+    SAMPLE_NOTIFY_IDX = 1,                            ///< new samples in @ref ProcSampleFifo
+    HEART_RATE_NOTIFY_IDX = 2,                        ///< new heart rate value
 };
 
-static volatile QueueHandle_t Daq2ProcQueue = 0;
-static volatile StaticQueue_t Daq2ProcQueueBuffer = { 0 };
-static volatile uint8_t Daq2ProcQueueStorageArea[DAQ_2_PROC_LEN * QUEUE_ITEM_SIZE] = { 0 };
+static StreamBufferHandle_t Daq2ProcStream = 0;
+static StaticStreamBuffer_t Daq2ProcStreamBuffer = { 0 };
+static uint8_t Daq2ProcStreamStorageArea[(DAQ_2_PROC_LEN * sizeof(uint16_t)) + 1] = { 0 };
+
+/**
+ * @note    The processed samples are written once to a broadcast ring buffer instead of being
+ *          copied to one queue per task. Each reading task has its own read index.
+ */
+static BroadcastFifo_t ProcSampleFifo = 0;
+static float32_t ProcSampleFifoBuffer[PROC_SAMPLE_LEN] = { 0 };
+
+static BroadcastReader_t ProcSampleQrsReader = 0;
+static BroadcastReader_t ProcSampleLcdReader = 0;
+
+/**
+ * @note    The LCD module isn't reentrant (e.g. a pixel stream switches the SPI to 16-bit frames
+ *          until it ends), and the LCD tasks run at different priorities. Each task holds this
+ *          mutex for each of its `LCD_*` call sequences, so the waveform task can't interrupt a
+ *          glyph that the heart rate task is drawing. With priority inheritance, the waveform
+ *          task waits for at most one heart rate update (~5 characters).
+ */
+static SemaphoreHandle_t LcdMutex = 0;
+static StaticSemaphore_t LcdMutexBuffer = { 0 };
+
+/******************************************************************************
+Run-Time Statistics Declarations
+******************************************************************************/
+
+/**
+ * @details The run-time stats clock is a free-running 32-bit timer at the 80 [MHz] system clock,
+ *          so it wraps every ~53 [s]. The kernel only adds up differences between readings, and
+ *          @ref StatsTask only reports differences over one period, so neither is affected.
+ *
+ *          The kernel charges ISR time to the task that was interrupted, so the
+ *          @ref Daq_Handler also times itself. Its load is included in the task loads as well.
+ */
 
-static volatile QueueHandle_t Proc2QrsQueue = 0;
-static volatile StaticQueue_t Proc2QrsQueueBuffer = { 0 };
-static volatile uint8_t Proc2QrsQueueStorageArea[PROC_2_QRS_LEN * QUEUE_ITEM_SIZE] = { 0 };
+#define STATS_TIMER    TIMER5
 
-static volatile QueueHandle_t Proc2LcdQueue = 0;
-static volatile StaticQueue_t Proc2LcdQueueBuffer = { 0 };
-static volatile uint8_t Proc2LcdQueueStorageArea[PROC_2_LCD_LEN * QUEUE_ITEM_SIZE] = { 0 };
+enum RUN_TIME_STATS_INFO {
+    STATS_PERIOD_MS = 5000,                           ///< time between reports [ms]
+    STATS_MAX_TASKS = 8,                              ///< max. num. tasks (incl. idle task)
+};
 
-static volatile QueueHandle_t Qrs2LcdQueue = 0;
-static volatile StaticQueue_t Qrs2LcdQueueBuffer;
-static volatile uint8_t Qrs2LcdQueueStorageArea[QRS_2_LCD_LEN * QUEUE_ITEM_SIZE] = { 0 };
+static Timer_t StatsTimer = 0;
+static volatile uint32_t DaqHandlerRunTime = 0;               ///< total @ref Daq_Handler run time
+static volatile uint32_t NumDroppedSamples = 0;               ///< samples the FIFO had no room for
 
 /******************************************************************************
 Other Declarations
 ******************************************************************************/
 
-/// input buffer for QRS detection
-static float32_t qrsDetectionBuffer[QRS_NUM_SAMP] = { 0 };
+/**
+ * @details The `Debug_*` functions only copy their output into the @ref DebugTxBuffer, so they
+ *          return immediately (instead of taking ~87 [us] per character at 115200 [baud]) and
+ *          can be called from the ISRs. If the buffer fills up, the newest output is dropped; see
+ *          UART_getNumDropped(). A stats report is ~550 characters.
+ */
+enum DEBUG_INFO {
+    DEBUG_TX_BUFFER_LEN = 1024,                       ///< length of TX buffer (power of 2)
+    TELEMETRY_BAUD_RATE = 921600,                     ///< debug UART's baud rate for telemetry
+};
+
+static Uart_t DebugUart = 0;
+static uint8_t DebugTxBuffer[DEBUG_TX_BUFFER_LEN] = { 0 };
 
+/**
+ * @details If `USE_TELEMETRY` is defined, the raw, filtered, and integrated samples, as well as
+ *          each beat and heart rate, are also sent to the debug UART as binary frames (see the
+ *          @ref telemetry module). This takes ~3000 [B/s], so the debug UART is switched from
+ *          115200 to @ref TELEMETRY_BAUD_RATE (~92000 [B/s]), which leaves room for more channels
+ *          or higher sampling rates. Use `/tools/telemetry_decoder` to convert a recording to CSV
+ *          or WFDB files.
+ */
+
+/**
+ * @details If `USE_LCD_SCROLL` is defined, the waveform scrolls to the left with the newest sample
+ *          at the right edge, instead of sweeping from left to right. The display does the
+ *          scrolling (see LCD_startScrolling()), so this takes the same SPI traffic per sample.
+ *          Only the area left of @ref LCD_SCROLL_X_START stays put, so the heart rate is shown
+ *          there instead of along the top.
+ */
 enum LCD_INFO {
     LCD_TOP_LINE = (LCD_Y_MAX - 24),               ///< separates wavefrom from text
 
@@ -192,25 +367,34 @@ enum LCD_INFO {
     LCD_WAVE_Y_MAX = (LCD_WAVE_NUM_Y + LCD_WAVE_X_OFFSET),               ///< waveform's max y-value
 
     LCD_TEXT_LINE_NUM = 28,                                              ///< line num. of text
+#ifdef USE_LCD_SCROLL
+    LCD_SCROLL_X_START = 80,                     ///< left edge of the waveform's scrolling area
+    LCD_TEXT_COL_NUM = 4                         ///< starting col. num. for heart rate
+#else
     LCD_TEXT_COL_NUM = 24               ///< starting col. num. for heart rate
+#endif
 };
 
-static uint16_t LCD_prevSampleBuffer[LCD_X_MAX] = { 0 };
-
 /******************************************************************************
 Main Function Definition
 ******************************************************************************/
 
 int main(void) {
     static GpioPort_t portA = 0;
-    static Uart_t uart0 = 0;
 
     PLL_Init();
 
-    // Init. debug module
+    // Init. debug module; its output is sent once the UART's ISR is enabled
     portA = GPIO_InitPort(GPIO_PORT_A);
-    uart0 = UART_Init(portA, UART0);
-    Debug_Init(uart0);
+    DebugUart = UART_Init(portA, UART0);
+#ifdef USE_TELEMETRY
+    UART_setBaudRate(DebugUart, TELEMETRY_BAUD_RATE);
+#endif
+    UART_EnableTxBuffer(DebugUart, DebugTxBuffer, DEBUG_TX_BUFFER_LEN);
+#if defined(USE_TELEMETRY) || defined(DEBUG_DEFERRED)
+    Telemetry_Init(DebugUart);               // before the Debug module, which may use it
+#endif
+    Debug_Init(DebugUart);
 
     // Init./config. LCD
     LCD_Init();
@@ -219,9 +403,19 @@ int main(void) {
     LCD_setColor(LCD_WHITE);
     LCD_drawHoriLine(LCD_TOP_LINE, 1);
 
+#ifdef USE_LCD_SCROLL
+    LCD_drawVertLine(LCD_SCROLL_X_START - 2, 1);
+
+    LCD_setColor(LCD_RED);
+    LCD_setCursor(LCD_TEXT_LINE_NUM, 0);
+    LCD_writeStr("HR");
+
+    LCD_startScrolling(LCD_SCROLL_X_START);
+#else
     LCD_setColor(LCD_RED);
     LCD_setCursor(LCD_TEXT_LINE_NUM, 0);
     LCD_writeStr("Heart Rate:      bpm");
+#endif
 
     LCD_setOutputMode(true);
 
@@ -234,42 +428,49 @@ int main(void) {
     DAQ_Init();
     Debug_SendFromList(DEBUG_DAQ_INIT);
 
-    // Init. DAQ ISR
+    // Init. stream buffer (before the DAQ ISR can use it); wake the reader for each sample
+    Daq2ProcStream = xStreamBufferCreateStatic(sizeof(Daq2ProcStreamStorageArea) - 1,
+                                               sizeof(uint16_t), Daq2ProcStreamStorageArea,
+                                               &Daq2ProcStreamBuffer);
+
+    // Init. processed sample FIFO and its readers
+    ProcSampleFifo = BroadcastFifo_Init(ProcSampleFifoBuffer, PROC_SAMPLE_LEN, sizeof(float32_t));
+    ProcSampleQrsReader = BroadcastFifo_AddReader(ProcSampleFifo);
+    ProcSampleLcdReader = BroadcastFifo_AddReader(ProcSampleFifo);
+
+    // Init. LCD mutex (the LCD is only used by `main()` until now)
+    LcdMutex = xSemaphoreCreateMutexStatic(&LcdMutexBuffer);
+
+    // Init. run-time stats clock (the DAQ ISR times itself with it)
+    vConfigureTimerForRunTimeStats();
+
+    // Init. DAQ and debug UART ISRs
     ISR_GlobalDisable();
     ISR_setPriority(DAQ_VECTOR_NUM, DAQ_HANDLER_PRI);
     ISR_Enable(DAQ_VECTOR_NUM);
+    ISR_setPriority(DEBUG_UART_VECTOR_NUM, DEBUG_UART_HANDLER_PRI);
+    ISR_Enable(DEBUG_UART_VECTOR_NUM);
     ISR_GlobalEnable();
 
-    // Init. queues and add them to registry for debugging
-    Daq2ProcQueue = xQueueCreateStatic(DAQ_2_PROC_LEN, QUEUE_ITEM_SIZE, Daq2ProcQueueStorageArea,
-                                       &Daq2ProcQueueBuffer);
-    Proc2QrsQueue = xQueueCreateStatic(PROC_2_QRS_LEN, QUEUE_ITEM_SIZE, Proc2QrsQueueStorageArea,
-                                       &Proc2QrsQueueBuffer);
-    Proc2LcdQueue = xQueueCreateStatic(PROC_2_LCD_LEN, QUEUE_ITEM_SIZE, Proc2LcdQueueStorageArea,
-                                       &Proc2LcdQueueBuffer);
-    Qrs2LcdQueue = xQueueCreateStatic(QRS_2_LCD_LEN, QUEUE_ITEM_SIZE, Qrs2LcdQueueStorageArea,
-                                      &Qrs2LcdQueueBuffer);
-
-    // Init. tasks and start scheduler
+    // Init. tasks and start scheduler; each task blocks until it has data
     ProcessingTaskHandle =
-        xTaskCreateStatic(ProcessingTask, "Intermediate Processing", STACK_SIZE, NULL,
+        xTaskCreateStatic(ProcessingTask, "Intermediate Processing", PROC_STACK_SIZE, NULL,
                           PROC_TASK_PRI, ProcessingStack, &ProcessingTaskBuffer);
-    vTaskSuspend(ProcessingTaskHandle);
 
     QrsDetectionTaskHandle =
-        xTaskCreateStatic(QrsDetectionTask, "QRS Detection", STACK_SIZE, NULL, QRS_TASK_PRI,
+        xTaskCreateStatic(QrsDetectionTask, "QRS Detection", QRS_STACK_SIZE, NULL, QRS_TASK_PRI,
                           QrsDetectionStack, &QrsDetectionTaskBuffer);
-    vTaskSuspend(QrsDetectionTaskHandle);
 
     LcdWaveformTaskHandle =
-        xTaskCreateStatic(LcdWaveformTask, "LCD (Waveform)", STACK_SIZE, NULL,
+        xTaskCreateStatic(LcdWaveformTask, "LCD (Waveform)", LCD_WAVEFORM_STACK_SIZE, NULL,
                           LCD_WAVEFORM_TASK_PRI, LcdWaveformStack, &LcdWaveformTaskBuffer);
-    vTaskSuspend(LcdWaveformTaskHandle);
 
     LcdHeartRateTaskHandle =
-        xTaskCreateStatic(LcdHeartRateTask, "LCD (Heart Rate)", STACK_SIZE, NULL, LCD_HR_TASK_PRI,
-                          LcdHeartRateStack, &LcdHeartRateTaskBuffer);
-    vTaskSuspend(LcdHeartRateTaskHandle);
+        xTaskCreateStatic(LcdHeartRateTask, "LCD (Heart Rate)", LCD_HR_STACK_SIZE, NULL,
+                          LCD_HR_TASK_PRI, LcdHeartRateStack, &LcdHeartRateTaskBuffer);
+
+    StatsTaskHandle = xTaskCreateStatic(StatsTask, "Stats", STATS_STACK_SIZE, NULL, STATS_TASK_PRI,
+                                        StatsStack, &StatsTaskBuffer);
 
     vTaskStartScheduler();
     while(1) {}
@@ -284,19 +485,50 @@ void vApplicationTickHook(void) {
     numTicks += 1;
 }
 
+void vApplicationStackOverflowHook(TaskHandle_t xTask, char * pcTaskName) {
+    // the task's stack has overflowed into other memory, so stop here
+    Debug_SendMsg("Stack overflow in task: ");
+    Debug_SendMsg(pcTaskName);
+    Debug_SendMsg("\r\n");
+    Debug_Assert(false);
+}
+
+void vConfigureTimerForRunTimeStats(void) {
+    // also called by `main()`, before the DAQ ISR starts using the timer
+    if(StatsTimer == 0) {
+        StatsTimer = Timer_Init(STATS_TIMER);
+        Timer_setMode(StatsTimer, PERIODIC, UP);
+        Timer_setReloadValue(StatsTimer, 0xFFFFFFFF);
+        Timer_Start(StatsTimer);
+    }
+    return;
+}
+
+uint32_t ulGetRunTimeCounterValue(void) {
+    return Timer_getCurrentValue(StatsTimer);
+}
+
 void Daq_Handler(void) {
-    // read sample and convert to `float32_t`
+    uint32_t startTime = ulGetRunTimeCounterValue();
+
+    // read sample
     uint16_t rawSample = DAQ_readSample();
-    volatile float32_t sample = DAQ_convertToMilliVolts(rawSample);
 
-    // send to intermediate processing task
-    BaseType_t status = xQueueSendToBackFromISR(Daq2ProcQueue, &sample, NULL);
-    Debug_Assert(status == pdTRUE);
+    // send to intermediate processing task, which is woken by the stream buffer
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    size_t numBytes = xStreamBufferSendFromISR(Daq2ProcStream, &rawSample, sizeof(rawSample),
+                                               &xHigherPriorityTaskWoken);
+    Debug_Assert(numBytes == sizeof(rawSample));
 
-    // acknowledge interrupt and unsuspend processing task
+    // acknowledge interrupt and switch to processing task if needed
     DAQ_acknowledgeInterrupt();
-    BaseType_t xYieldRequired = xTaskResumeFromISR(ProcessingTaskHandle);
-    portYIELD_FROM_ISR(xYieldRequired);
+    DaqHandlerRunTime += ulGetRunTimeCounterValue() - startTime;
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+void DebugUart_Handler(void) {
+    UART_handleTxInterrupt(DebugUart);
+    return;
 }
 
 static void ProcessingTask(void * params) {
@@ -304,10 +536,14 @@ static void ProcessingTask(void * params) {
         static float32_t sum = 0;
         static uint32_t N = 0;
 
-        // process sample(s) and place in queues
-        while(uxQueueMessagesWaiting(Daq2ProcQueue) > 0) {
-            volatile float32_t sample;
-            xQueueReceive(Daq2ProcQueue, &sample, 0);
+        // wait for sample(s) from the DAQ ISR
+        uint16_t rawSamples[DAQ_2_PROC_LEN];
+        size_t numBytes =
+            xStreamBufferReceive(Daq2ProcStream, rawSamples, sizeof(rawSamples), portMAX_DELAY);
+
+        // process sample(s) and place in FIFO
+        for(size_t idx = 0; idx < (numBytes / sizeof(uint16_t)); idx++) {
+            float32_t sample = DAQ_convertToMilliVolts(rawSamples[idx]);
 
             // apply running mean subtraction to remove baseline drift
             sum += sample;
@@ -317,89 +553,220 @@ static void ProcessingTask(void * params) {
             // apply 60 [Hz] notch filter to remove power line noise
             sample = DAQ_NotchFilter(sample);
 
-            // place in queues
-            BaseType_t status;
-
-            status = xQueueSendToBack(Proc2QrsQueue, &sample, 0);
-            Debug_Assert(status == pdTRUE);
-
-            status = xQueueSendToBack(Proc2LcdQueue, &sample, 0);
-            Debug_Assert(status == pdTRUE);
+#ifdef USE_TELEMETRY
+            // `N - 1` is the sample num., counting from 0
+            Telemetry_AddRawSample(N - 1, rawSamples[idx]);
+            Telemetry_AddSample(TELEMETRY_MSG_FILTERED, N - 1, sample);
+#endif
+
+            // place in FIFO for the QRS and LCD tasks; if a reader is too far behind, the sample
+            // is dropped (and counted) instead of stopping the device
+            bool isPut = BroadcastFifo_Put(ProcSampleFifo, &sample);
+            if(isPut == false) {
+                NumDroppedSamples += 1;
+            }
         }
 
-        // activate next task(s) and suspend itself
-        if(uxQueueSpacesAvailable(Proc2QrsQueue) == pdFALSE) {
-            vTaskResume(QrsDetectionTaskHandle);
-        }
-        vTaskResume(LcdWaveformTaskHandle);
-        vTaskSuspend(NULL);
+        // notify next task(s)
+        xTaskNotifyGiveIndexed(QrsDetectionTaskHandle, SAMPLE_NOTIFY_IDX);
+        xTaskNotifyGiveIndexed(LcdWaveformTaskHandle, SAMPLE_NOTIFY_IDX);
     }
 }
 
 static void QrsDetectionTask(void * params) {
     while(1) {
-        // flush queue into QRS detection buffer
-        vPortEnterCritical();
-        for(uint16_t idx = 0; idx < QRS_NUM_SAMP; idx++) {
-            xQueueReceive(Proc2QrsQueue, &qrsDetectionBuffer[idx], 0);
-        }
-        vPortExitCritical();
-
-        // Run QRS detection
-        Debug_SendMsg("Starting QRS detection...\r\n");
-
-        QRS_Preprocess(qrsDetectionBuffer, qrsDetectionBuffer);
-        float32_t heartRate_bpm = QRS_applyDecisionRules(qrsDetectionBuffer);
-        Debug_Assert(isfinite(heartRate_bpm));
-
-        // Output heart rate to serial port
-        Debug_WriteFloat(heartRate_bpm);
+        // wait for new sample(s)
+        ulTaskNotifyTakeIndexed(SAMPLE_NOTIFY_IDX, pdTRUE, portMAX_DELAY);
 
-        // Output heart rate to LCD
-        xQueueSendToBack(Qrs2LcdQueue, &heartRate_bpm, 0);
-        vTaskResume(LcdHeartRateTaskHandle);
+        while(BroadcastFifo_getLag(ProcSampleQrsReader) > 0) {
+            static uint32_t sampleNum = 0;               // same as the processing task's
 
-        vTaskSuspend(NULL);
+            float32_t sample;
+            BroadcastFifo_Get(ProcSampleQrsReader, &sample);
+
+            // Run QRS detection
+            float32_t heartRate_bpm;
+            bool isNewBeat = QRS_ProcessSample(sample, &heartRate_bpm);
+
+#ifdef USE_TELEMETRY
+            Telemetry_AddSample(TELEMETRY_MSG_INTEGRATED, sampleNum, QRS_getIntegratedSample());
+            if(isNewBeat) {
+                Telemetry_SendBeat(QRS_getBeatSampleNum());
+                Telemetry_SendHeartRate(sampleNum, heartRate_bpm);
+            }
+#endif
+            sampleNum += 1;
+
+            if(isNewBeat) {
+                Debug_Assert(isfinite(heartRate_bpm));
+
+                // Output heart rate to serial port
+                Debug_WriteFloat(heartRate_bpm);
+
+                // Output heart rate to LCD; an older value that wasn't displayed yet is replaced
+                uint32_t heartRateBits;
+                memcpy(&heartRateBits, &heartRate_bpm, sizeof(heartRateBits));
+                xTaskNotifyIndexed(LcdHeartRateTaskHandle, HEART_RATE_NOTIFY_IDX, heartRateBits,
+                                   eSetValueWithOverwrite);
+            }
+        }
     }
 }
 
 static void LcdWaveformTask(void * params) {
     while(1) {
+#ifndef USE_LCD_SCROLL
         static uint16_t x = 0;
+#endif
         static const float32_t maxVal = DAQ_LOOKUP_MAX * 2;
 
-        while(uxQueueMessagesWaiting(Proc2LcdQueue) > 0) {
+        // wait for new sample(s)
+        ulTaskNotifyTakeIndexed(SAMPLE_NOTIFY_IDX, pdTRUE, portMAX_DELAY);
+
+        while(BroadcastFifo_getLag(ProcSampleLcdReader) > 0) {
             float32_t sample;
-            xQueueReceive(Proc2LcdQueue, &sample, 0);
+            BroadcastFifo_Get(ProcSampleLcdReader, &sample);
             sample = DAQ_BandpassFilter(sample);
 
-            // remove previous y-value from LCD
-            uint16_t y = LCD_prevSampleBuffer[x];
-            LCD_plotSample(x, y, LCD_BLACK);
-
             // shift/scale `sample` from (est.) range [-11, 11) to [LCD_WAVE_Y_MIN, LCD_WAVE_Y_MAX)
-            y = LCD_WAVE_Y_MIN + ((uint16_t) (((sample + maxVal) / (maxVal * 2)) * LCD_WAVE_Y_MAX));
-            LCD_plotSample(x, y, LCD_RED);
-
-            // store y-value and update x
-            LCD_prevSampleBuffer[x] = y;
+            uint16_t y = LCD_WAVE_Y_MIN +
+                         ((uint16_t) (((sample + maxVal) / (maxVal * 2)) * LCD_WAVE_Y_MAX));
+            xSemaphoreTake(LcdMutex, portMAX_DELAY);
+#ifdef USE_LCD_SCROLL
+            LCD_scrollWaveSample(y, LCD_RED);
+#else
+            LCD_plotWaveSample(x, y, LCD_RED);               // also erases the old segment
             x = (x + 1) % LCD_X_MAX;
+#endif
+            xSemaphoreGive(LcdMutex);
         }
-
-        vTaskSuspend(NULL);
     }
 }
 
 static void LcdHeartRateTask(void * params) {
     while(1) {
-        volatile float32_t heartRate_bpm;
-        xQueueReceive(Qrs2LcdQueue, &heartRate_bpm, 0);
+        // wait for a new heart rate value
+        uint32_t heartRateBits;
+        xTaskNotifyWaitIndexed(HEART_RATE_NOTIFY_IDX, 0, 0, &heartRateBits, portMAX_DELAY);
+
+        float32_t heartRate_bpm;
+        memcpy(&heartRate_bpm, &heartRateBits, sizeof(heartRate_bpm));
 
+        xSemaphoreTake(LcdMutex, portMAX_DELAY);
         LCD_setCursor(LCD_TEXT_LINE_NUM, LCD_TEXT_COL_NUM);
         LCD_writeFloat(heartRate_bpm);
+        xSemaphoreGive(LcdMutex);
+    }
+}
+
+static void StatsTask(void * params) {
+    static TaskStatus_t taskStatusArray[STATS_MAX_TASKS];
+    static uint32_t prevTaskRunTime[STATS_MAX_TASKS + 1] = { 0 };               // by task number
+    static uint32_t prevTotalRunTime = 0;
+    static uint32_t prevDaqHandlerRunTime = 0;
+
+    while(1) {
+        vTaskDelay(pdMS_TO_TICKS(STATS_PERIOD_MS));
+
+        uint32_t totalRunTime;
+        UBaseType_t numTasks =
+            uxTaskGetSystemState(taskStatusArray, STATS_MAX_TASKS, &totalRunTime);
+        Debug_Assert(numTasks > 0);
+        uint32_t daqHandlerRunTime = DaqHandlerRunTime;
+
+        // everything below is relative to the last period, so counter overflow doesn't matter
+        float32_t period = (float32_t) (totalRunTime - prevTotalRunTime);
+        prevTotalRunTime = totalRunTime;
+
+        /**
+         * Each line is written with the scheduler suspended so that other tasks' serial output
+         * can't split it. The line is only copied into the @ref DebugTxBuffer, so this is short.
+         */
+        vTaskSuspendAll();
+        Debug_SendFromList(DEBUG_CPU_LOAD_START);
+        xTaskResumeAll();
+
+        for(UBaseType_t idx = 0; idx < numTasks; idx++) {
+            UBaseType_t taskNum = taskStatusArray[idx].xTaskNumber;
+            Debug_Assert(taskNum <= STATS_MAX_TASKS);
+
+            uint32_t taskRunTime = taskStatusArray[idx].ulRunTimeCounter;
+            float32_t load_pct = ((taskRunTime - prevTaskRunTime[taskNum]) * 100.0f) / period;
+            prevTaskRunTime[taskNum] = taskRunTime;
+
+            vTaskSuspendAll();
+            Debug_WriteCpuLoad(taskStatusArray[idx].pcTaskName, load_pct);
+            xTaskResumeAll();
+        }
+
+        float32_t isrLoad_pct = ((daqHandlerRunTime - prevDaqHandlerRunTime) * 100.0f) / period;
+        prevDaqHandlerRunTime = daqHandlerRunTime;
 
-        vTaskSuspend(NULL);
+        vTaskSuspendAll();
+        Debug_WriteCpuLoad("ISR (DAQ)", isrLoad_pct);
+        xTaskResumeAll();
+
+        // peak stack usage of each task since it was created
+        vTaskSuspendAll();
+        Debug_SendFromList(DEBUG_STACK_USAGE_START);
+        xTaskResumeAll();
+
+        for(UBaseType_t idx = 0; idx < numTasks; idx++) {
+            uint32_t size = getStackSize(taskStatusArray[idx].xHandle);
+            uint32_t used = size - taskStatusArray[idx].usStackHighWaterMark;
+
+            vTaskSuspendAll();
+            Debug_WriteStackUsage(taskStatusArray[idx].pcTaskName, used, size);
+            xTaskResumeAll();
+        }
+
+#ifdef FIFO_RING_STATS
+        // peak lag of each reader, i.e. how far it fell behind the processing task
+        RingFifoStats_t fifoStats;
+
+        vTaskSuspendAll();
+        BroadcastFifo_getStats(ProcSampleFifo, &fifoStats);
+        Debug_WriteFifoStats("ProcSampleFifo", &fifoStats);
+        xTaskResumeAll();
+
+        vTaskSuspendAll();
+        BroadcastFifo_getReaderStats(ProcSampleQrsReader, &fifoStats);
+        Debug_WriteFifoStats("QRS reader", &fifoStats);
+        xTaskResumeAll();
+
+        vTaskSuspendAll();
+        BroadcastFifo_getReaderStats(ProcSampleLcdReader, &fifoStats);
+        Debug_WriteFifoStats("LCD reader", &fifoStats);
+        xTaskResumeAll();
+#else
+        // the FIFO stats would include this count
+        vTaskSuspendAll();
+        Debug_WriteDropCount("ProcSampleFifo", NumDroppedSamples);
+        xTaskResumeAll();
+#endif
+    }
+}
+
+static uint32_t getStackSize(TaskHandle_t task) {
+    uint32_t size = configMINIMAL_STACK_SIZE;               // idle task
+
+    if(task == ProcessingTaskHandle) {
+        size = PROC_STACK_SIZE;
+    }
+    else if(task == QrsDetectionTaskHandle) {
+        size = QRS_STACK_SIZE;
+    }
+    else if(task == LcdWaveformTaskHandle) {
+        size = LCD_WAVEFORM_STACK_SIZE;
     }
+    else if(task == LcdHeartRateTaskHandle) {
+        size = LCD_HR_STACK_SIZE;
+    }
+    else if(task == StatsTaskHandle) {
+        size = STATS_STACK_SIZE;
+    }
+
+    return size;
 }
 
 /** @} */               // rtos_impl
@@ -9,14 +9,50 @@
 
 #include "Debug.h"
 
+#include "Debug_msgs.h"
+#include "Fifo.h"
 #include "UART.h"
 
+#ifdef DEBUG_DEFERRED
+#include "Telemetry.h"
+#endif
+
 #include "NewAssert.h"
 
+#include <stdarg.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
 
 static Uart_t debugUart = 0;
 
+#ifdef DEBUG_DEFERRED
+
+/// @brief  Arguments of a log record, packed as described in @ref Debug_msgs.h.
+typedef struct {
+    uint8_t bytes[TELEMETRY_MAX_LOG_ARGS_SIZE];
+    uint8_t size;
+} LogArgs_t;
+
+/// max. length of a name, which leaves room for up to 4 more arguments (e.g. FIFO stats)
+#define STRING_ARG_MAX_LENGTH (TELEMETRY_MAX_LOG_ARGS_SIZE - 1 - (4 * sizeof(uint32_t)))
+
+static void putString(LogArgs_t * args, const char * str, uint8_t maxLength);
+static void putUint(LogArgs_t * args, uint32_t value);
+static void putFloat(LogArgs_t * args, float value);
+
+#else
+
+#define DEBUG_MSG_FORMAT(id, argTypes, format) format,
+static const char * const MSG_FORMATS[DEBUG_NUM_MSGS] = { DEBUG_MSG_TABLE(DEBUG_MSG_FORMAT) };
+
+#define DEBUG_MSG_ARG_TYPES(id, argTypes, format) argTypes,
+static const char * const MSG_ARG_TYPES[DEBUG_NUM_MSGS] = { DEBUG_MSG_TABLE(DEBUG_MSG_ARG_TYPES) };
+
+static void writeFormatted(Msg_t msg, ...);
+
+#endif
+
 /******************************************************************************
 Initialization
 *******************************************************************************/
@@ -26,8 +62,8 @@ void Debug_Init(Uart_t uart) {
 
     debugUart = uart;
 
-    Debug_SendMsg((void *) "Starting transmission...\r\n");
-    Debug_SendMsg((void *) "Debug module initialized.\r\n");
+    Debug_SendFromList(DEBUG_START);
+    Debug_SendFromList(DEBUG_INIT);
     return;
 }
 
@@ -36,43 +72,194 @@ Serial Output
 *******************************************************************************/
 
 void Debug_SendMsg(void * message) {
-    UART_WriteStr(debugUart, message);
+#ifdef DEBUG_DEFERRED
+    // long messages are split into several records
+    const char * str = message;
+    do {
+        LogArgs_t args = { { 0 }, 0 };
+        putString(&args, str, TELEMETRY_MAX_LOG_ARGS_SIZE - 1);
+        Telemetry_SendLog(DEBUG_STRING, args.bytes, args.size);
+        str += args.bytes[0];
+    } while(*str != '\0');
+#else
+    writeFormatted(DEBUG_STRING, message);
+#endif
     return;
 }
 
 void Debug_SendFromList(Msg_t msg) {
-    switch(msg) {
-        case DEBUG_DAQ_INIT:
-            Debug_SendMsg("Data acquisition module initialized.\r\n");
-            break;
-        case DEBUG_QRS_INIT:
-            Debug_SendMsg("QRS detection module initialized.\r\n");
-            break;
-        case DEBUG_LCD_INIT:
-            Debug_SendMsg("LCD module initialized.\r\n");
-            break;
-        case DEBUG_QRS_START:
-            Debug_SendMsg("Starting QRS detection...\r\n");
-            break;
-        default:
-            assert(false);
-    }
+    assert(msg < DEBUG_NUM_MSGS);
+
+#ifdef DEBUG_DEFERRED
+    Telemetry_SendLog(msg, NULL, 0);
+#else
+    assert(MSG_ARG_TYPES[msg][0] == '\0');
+    writeFormatted(msg);
+#endif
     return;
 }
 
 void Debug_WriteFloat(double value) {
-    UART_WriteFloat(debugUart, value, 1);
-    UART_WriteStr(debugUart, "\r\n");
+#ifdef DEBUG_DEFERRED
+    LogArgs_t args = { { 0 }, 0 };
+    putFloat(&args, (float) value);
+    Telemetry_SendLog(DEBUG_FLOAT, args.bytes, args.size);
+#else
+    writeFormatted(DEBUG_FLOAT, value);
+#endif
+    return;
+}
+
+void Debug_WriteFifoStats(const char * name, const RingFifoStats_t * statsPtr) {
+#ifdef DEBUG_DEFERRED
+    LogArgs_t args = { { 0 }, 0 };
+    putString(&args, name, STRING_ARG_MAX_LENGTH);
+    putUint(&args, statsPtr->peakSize);
+    putUint(&args, statsPtr->N);
+    putUint(&args, statsPtr->numDropped);
+    putUint(&args, statsPtr->numUnderflows);
+    Telemetry_SendLog(DEBUG_FIFO_STATS, args.bytes, args.size);
+#else
+    writeFormatted(DEBUG_FIFO_STATS, name, statsPtr->peakSize, statsPtr->N, statsPtr->numDropped,
+                   statsPtr->numUnderflows);
+#endif
+    return;
+}
+
+void Debug_WriteCpuLoad(const char * name, double load_pct) {
+#ifdef DEBUG_DEFERRED
+    LogArgs_t args = { { 0 }, 0 };
+    putString(&args, name, STRING_ARG_MAX_LENGTH);
+    putFloat(&args, (float) load_pct);
+    Telemetry_SendLog(DEBUG_CPU_LOAD, args.bytes, args.size);
+#else
+    writeFormatted(DEBUG_CPU_LOAD, name, load_pct);
+#endif
+    return;
+}
+
+void Debug_WriteStackUsage(const char * name, uint32_t used, uint32_t size) {
+#ifdef DEBUG_DEFERRED
+    LogArgs_t args = { { 0 }, 0 };
+    putString(&args, name, STRING_ARG_MAX_LENGTH);
+    putUint(&args, used);
+    putUint(&args, size);
+    Telemetry_SendLog(DEBUG_STACK_USAGE, args.bytes, args.size);
+#else
+    writeFormatted(DEBUG_STACK_USAGE, name, used, size);
+#endif
+    return;
+}
+
+void Debug_WriteDropCount(const char * name, uint32_t numDropped) {
+#ifdef DEBUG_DEFERRED
+    LogArgs_t args = { { 0 }, 0 };
+    putString(&args, name, STRING_ARG_MAX_LENGTH);
+    putUint(&args, numDropped);
+    Telemetry_SendLog(DEBUG_DROP_COUNT, args.bytes, args.size);
+#else
+    writeFormatted(DEBUG_DROP_COUNT, name, numDropped);
+#endif
+    return;
+}
+
+#ifdef DEBUG_DEFERRED
+
+/// @brief  Add a string, truncated to `maxLength` characters.
+static void putString(LogArgs_t * args, const char * str, uint8_t maxLength) {
+    assert((args->size + 1 + maxLength) <= TELEMETRY_MAX_LOG_ARGS_SIZE);
+
+    uint32_t length = strlen(str);
+    length = (length > maxLength) ? maxLength : length;
+
+    args->bytes[args->size] = (uint8_t) length;
+    memcpy(&args->bytes[args->size + 1], str, length);
+    args->size += length + 1;
+    return;
+}
+
+static void putUint(LogArgs_t * args, uint32_t value) {
+    assert((args->size + sizeof(value)) <= TELEMETRY_MAX_LOG_ARGS_SIZE);
+
+    for(uint8_t idx = 0; idx < sizeof(value); idx++) {
+        args->bytes[args->size + idx] = (uint8_t) (value >> (8 * idx));
+    }
+    args->size += sizeof(value);
+    return;
+}
+
+static void putFloat(LogArgs_t * args, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    putUint(args, bits);
+    return;
+}
+
+#else
+
+/**
+ * @brief           Write a message from @ref Debug_msgs.h, filling in its arguments.
+ *
+ * @details         Only the conversions used by the table are supported: `%s`, `%u`, `%.<N>f`,
+ *                  and `%%`. The arguments are read according to the message's `argTypes`, so
+ *                  `u` arguments are passed as `uint32_t` and `f` arguments as `double`.
+ */
+static void writeFormatted(Msg_t msg, ...) {
+    const char * format = MSG_FORMATS[msg];
+    const char * argType = MSG_ARG_TYPES[msg];
+
+    va_list args;
+    va_start(args, msg);
+    for(; *format != '\0'; format++) {
+        if(*format != '%') {
+            UART_WriteChar(debugUart, (unsigned char) *format);
+            continue;
+        }
+
+        format++;
+        if(*format == '%') {
+            UART_WriteChar(debugUart, '%');
+            continue;
+        }
+
+        uint8_t numDecimals = 0;
+        if(*format == '.') {
+            for(format++; (*format >= '0') && (*format <= '9'); format++) {
+                numDecimals = (uint8_t) ((numDecimals * 10) + (*format - '0'));
+            }
+        }
+
+        assert(*argType == *format);
+        switch(*argType++) {
+            case 's':
+                UART_WriteStr(debugUart, va_arg(args, char *));
+                break;
+            case 'u':
+                UART_WriteInt(debugUart, (int32_t) va_arg(args, uint32_t));
+                break;
+            case 'f':
+                UART_WriteFloat(debugUart, va_arg(args, double), numDecimals);
+                break;
+            default:
+                assert(false);
+                break;
+        }
+    }
+    va_end(args);
+
     return;
 }
 
+#endif
+
 /******************************************************************************
 Assertions
 *******************************************************************************/
 
 void Debug_Assert(bool condition) {
     if(condition == false) {
-        Debug_SendMsg((void *) "Assertion failed. Entering infinite loop.\r\n.");
+        Debug_SendFromList(DEBUG_ASSERT_FAILED);
+        UART_Flush(debugUart);               // in case the UART's TX buffer is enabled
         assert(false);
     }
     return;
@@ -5,11 +5,20 @@
  * @file
  * @author  Bryan McElvy
  * @brief   Header file for Debug module.
+ *
+ * @details By default, the serial output is formatted as text on the MCU. If `DEBUG_DEFERRED`
+ *          is defined (i.e. `OPT_DEFERRED_LOG`), each output is instead sent as a log record
+ *          holding a message ID from @ref Debug_msgs.h and the raw bytes of its arguments (see
+ *          Telemetry_SendLog()). This skips the decimal conversion and shrinks fixed messages to
+ *          a few bytes, so the output can be left on in production builds. Use
+ *          `/tools/telemetry_decoder` to turn a recording back into text.
  */
 
 #ifndef DEBUG_H
 #define DEBUG_H
 
+#include "Debug_msgs.h"
+#include "Fifo.h"
 #include "UART.h"
 
 #include <stdbool.h>
@@ -29,11 +38,15 @@ Initialization
 /**
  * @brief               Initialize the Debug module.
  *
- * @pre                 Initialize the UART.
+ * @details             If the UART's TX buffer is enabled, the serial output functions
+ *                      return immediately and can be called from ISRs.
+ *
+ * @pre                 Initialize the UART. If `DEBUG_DEFERRED` is defined, also initialize
+ *                      the Telemetry module with the same UART.
  * @param[in] uart      UART to use for serial output.
  * @post                An initialization message is sent to the serial port.
  *
- * @see                 UART_Init()
+ * @see                 UART_Init(), UART_EnableTxBuffer(), Telemetry_Init()
  */
 void Debug_Init(Uart_t uart);
 
@@ -56,18 +69,19 @@ Serial Output
  */
 void Debug_SendMsg(void * message);
 
+#define DEBUG_MSG_ID(id, argTypes, format) id,
+
+/// @brief  Message IDs, in the same order as @ref DEBUG_MSG_TABLE.
 typedef enum {
-    DEBUG_DAQ_INIT,
-    DEBUG_QRS_INIT,
-    DEBUG_LCD_INIT,
-    DEBUG_QRS_START
+    DEBUG_MSG_TABLE(DEBUG_MSG_ID)
+    DEBUG_NUM_MSGS
 } Msg_t;
 
 /**
  * @brief               Send a message from the message list.
  *
  * @pre                 Initialize the Debug module.
- * @param[in] msg       An entry from the enumeration.
+ * @param[in] msg       An entry from the enumeration without any arguments.
  * @post                The corresponding message is sent to the serial port.
  *
  * @see                 Debug_SendMsg()
@@ -85,6 +99,50 @@ void Debug_SendFromList(Msg_t msg);
  */
 void Debug_WriteFloat(double value);
 
+/**
+ * @brief               Write a ring buffer's statistics to the serial port.
+ *
+ * @pre                 Initialize the Debug module.
+ * @param[in] name      Name of the ring buffer.
+ * @param[in] statsPtr  Pointer to the ring buffer's statistics.
+ * @post                A line like `DAQ_Fifo: peak 3/4, 0 dropped, 0 underflows` is written to
+ *                      the serial port.
+ *
+ * @see                 RingFifo_getStats()
+ */
+void Debug_WriteFifoStats(const char * name, const RingFifoStats_t * statsPtr);
+
+/**
+ * @brief               Write a CPU load percentage to the serial port.
+ *
+ * @pre                 Initialize the Debug module.
+ * @param[in] name      Name of the task (or other source of CPU load).
+ * @param[in] load_pct  CPU load in [%].
+ * @post                A line like `QRS Detection: 12.3%` is written to the serial port.
+ */
+void Debug_WriteCpuLoad(const char * name, double load_pct);
+
+/**
+ * @brief               Write a task's peak stack usage to the serial port.
+ *
+ * @pre                 Initialize the Debug module.
+ * @param[in] name      Name of the task.
+ * @param[in] used      Peak num. of words used, i.e. the stack size minus its high water mark.
+ * @param[in] size      Stack size in words.
+ * @post                A line like `QRS Detection: 98/160 words` is written to the serial port.
+ */
+void Debug_WriteStackUsage(const char * name, uint32_t used, uint32_t size);
+
+/**
+ * @brief               Write the number of values that a buffer has dropped to the serial port.
+ *
+ * @pre                 Initialize the Debug module.
+ * @param[in] name      Name of the buffer.
+ * @param[in] numDropped Num. of values dropped so far.
+ * @post                A line like `ProcSampleFifo: 0 dropped` is written to the serial port.
+ */
+void Debug_WriteDropCount(const char * name, uint32_t numDropped);
+
 /** @} */               // Serial Output
 
 /******************************************************************************
@@ -100,7 +158,7 @@ Assertions
  * @param[in] condition Conditional statement to evaluate.
  * @post                If `condition == true`, the program continues normally.
  *                      If `condition == false`, a message is sent and a breakpoint
- *                      is activated.
+ *                      is activated. Any buffered serial output is sent first.
  */
 void Debug_Assert(bool condition);
 
@@ -0,0 +1,52 @@
+/**
+ * @addtogroup debug
+ * @{
+ *
+ * @file
+ * @author  Bryan McElvy
+ * @brief   Table of the Debug module's messages.
+ *
+ * @details Each entry is `X(id, argTypes, format)`, where `argTypes` has one character per
+ *          conversion in `format`:
+ *
+ *          Type | Argument                  | Bytes in a log record
+ *          -----|---------------------------|------------------------------------------------
+ *          `s`  | string                    | length (1), then the characters (not terminated)
+ *          `u`  | unsigned integer          | `uint32_t`, little-endian (4)
+ *          `f`  | floating-point value      | `float`, little-endian (4)
+ *
+ *          By default, the Debug module writes each message by filling in its `format`, so this
+ *          table is the only place the text is defined. If `DEBUG_DEFERRED` is defined, the
+ *          firmware only sends the ID and the arguments (see Telemetry_SendLog()), and none of
+ *          these strings are compiled into it. The host tool `/tools/telemetry_decoder` is built
+ *          from this same table, so it always matches the firmware and can rebuild the original
+ *          text.
+ *
+ * @note    Only add entries to the end of the table, so that IDs in old recordings stay valid.
+ */
+
+#ifndef DEBUG_MSGS_H
+#define DEBUG_MSGS_H
+
+// clang-format off
+#define DEBUG_MSG_TABLE(X)                                                                         \
+    X(DEBUG_DAQ_INIT,           "",         "Data acquisition module initialized.\r\n")            \
+    X(DEBUG_QRS_INIT,           "",         "QRS detection module initialized.\r\n")               \
+    X(DEBUG_LCD_INIT,           "",         "LCD module initialized.\r\n")                         \
+    X(DEBUG_QRS_START,          "",         "Starting QRS detection...\r\n")                       \
+    X(DEBUG_START,              "",         "Starting transmission...\r\n")                        \
+    X(DEBUG_INIT,               "",         "Debug module initialized.\r\n")                       \
+    X(DEBUG_ASSERT_FAILED,      "",         "Assertion failed. Entering infinite loop.\r\n")       \
+    X(DEBUG_CPU_LOAD_START,     "",         "CPU load:\r\n")                                       \
+    X(DEBUG_STACK_USAGE_START,  "",         "Stack usage:\r\n")                                    \
+    X(DEBUG_STRING,             "s",        "%s")                                                  \
+    X(DEBUG_FLOAT,              "f",        "%.1f\r\n")                                            \
+    X(DEBUG_FIFO_STATS,         "suuuu",    "%s: peak %u/%u, %u dropped, %u underflows\r\n")       \
+    X(DEBUG_CPU_LOAD,           "sf",       "%s: %.1f%%\r\n")                                      \
+    X(DEBUG_STACK_USAGE,        "suu",      "%s: %u/%u words\r\n")                                 \
+    X(DEBUG_DROP_COUNT,         "su",       "%s: %u dropped\r\n")
+// clang-format on
+
+#endif                  // DEBUG_MSGS_H
+
+/** @} */               // debug
@@ -34,8 +34,19 @@ static void ILI9341_setMode(uint8_t param);
 static void ILI9341_setAddress(uint16_t start_address, uint16_t end_address, bool is_row);
 static void ILI9341_sendParams(Cmd_t cmd);
 
-static uint32_t ILI9341_Buffer[8];
-static Fifo_t ILI9341_Fifo;
+enum {
+    ILI9341_FIFO_LEN = 8               ///< length of parameter FIFO (power of 2)
+};
+
+static uint32_t ILI9341_Buffer[ILI9341_FIFO_LEN];
+static RingFifo_t ILI9341_Fifo;
+
+/// @brief  Start/end address last sent via `CASET` or `PASET`.
+typedef struct {
+    uint16_t start;
+    uint16_t end;
+    bool isValid;                   ///< `false` if unknown (e.g. after a reset)
+} AddressRange_t;
 
 static struct {
     sleepMode_t sleepMode;
@@ -49,9 +60,14 @@ static struct {
     GpioPin_t resetPin;
 
     Spi_t spi;
+    AddressRange_t rowAddress;
+    AddressRange_t colAddress;
+    uint32_t numSkippedCmds;        ///< `CASET`/`PASET` commands skipped since the address matched
+
+    bool isStreaming;               ///< `true` between ILI9341_start/endPixelStream()
     bool isInit;
-} ili9341 = { SLEEP_ON,         NORMAL_AREA, FULL_COLORS, INVERT_OFF, OUTPUT_ON,
-              COLORDEPTH_16BIT, 0,           0,           0,          false };
+} ili9341 = { SLEEP_ON, NORMAL_AREA, FULL_COLORS, INVERT_OFF, OUTPUT_ON, COLORDEPTH_16BIT, 0, 0, 0,
+              { 0, 0, false }, { 0, 0, false }, 0, false, false };
 
 /******************************************************************************
 Initialization/Reset
@@ -63,7 +79,7 @@ void ILI9341_Init(GpioPort_t resetPinPort, GpioPin_t resetPin, Spi_t spi, Timer_
     assert(SPI_isInit(spi));
     assert(Timer_isInit(timer));
 
-    ILI9341_Fifo = Fifo_Init(ILI9341_Buffer, 8);
+    ILI9341_Fifo = RingFifo_Init(ILI9341_Buffer, ILI9341_FIFO_LEN);
 
     GPIO_DisableDigital(resetPinPort, resetPin);
     GPIO_configDirection(resetPinPort, resetPin, GPIO_OUTPUT);
@@ -133,6 +149,9 @@ void ILI9341_resetHard(Timer_t timer) {
     Timer_Wait1ms(timer, 1);
     *ili9341.resetPinDataRegister |= ili9341.resetPin;
     Timer_Wait1ms(timer, 5);
+
+    ili9341.rowAddress.isValid = false;
+    ili9341.colAddress.isValid = false;
     return;
 }
 
@@ -142,6 +161,9 @@ void ILI9341_resetSoft(Timer_t timer) {
 
     SPI_WriteCmd(ili9341.spi, SWRESET);
     Timer_Wait1ms(timer, 5);               /// the driver needs 5 [ms] before another command
+
+    ili9341.rowAddress.isValid = false;
+    ili9341.colAddress.isValid = false;
     return;
 }
 
@@ -185,6 +207,7 @@ static void ILI9341_setMode(uint8_t param) {
         case(COLORDEPTH_18BIT):
             SPI_WriteCmd(ili9341.spi, PIXSET);
             SPI_WriteData(ili9341.spi, param);
+            ili9341.colorDepth = param;
             break;
         default:
             assert(false);
@@ -206,12 +229,14 @@ static void ILI9341_sendParams(Cmd_t cmd) {
         SPI_WriteCmd(ili9341.spi, cmd);
     }
 
-    uint8_t numParams = Fifo_getCurrSize(ILI9341_Fifo);
-    while(numParams > 0) {
-        uint8_t data = Fifo_Get(ILI9341_Fifo);
-        SPI_WriteData(ili9341.spi, data);
-
-        numParams -= 1;
+    // send directly from the FIFO (takes two spans if the params wrap around)
+    uint32_t * params;
+    uint32_t numParams;
+    while((numParams = RingFifo_PeekSpan(ILI9341_Fifo, &params)) > 0) {
+        for(uint32_t idx = 0; idx < numParams; idx++) {
+            SPI_WriteData(ili9341.spi, (uint8_t) params[idx]);
+        }
+        RingFifo_Release(ILI9341_Fifo, numParams);
     }
 
     return;
@@ -257,15 +282,48 @@ void ILI9341_setPartialArea(uint16_t rowStart, uint16_t rowEnd) {
     rowStart = (rowStart < rowEnd) ? rowStart : rowEnd;
 
     // configure and send command sequence
-    Fifo_Put(ILI9341_Fifo, ((rowStart & 0xFF00) >> 8));
-    Fifo_Put(ILI9341_Fifo, (rowStart & 0x00FF));
-    Fifo_Put(ILI9341_Fifo, ((rowEnd & 0xFF00) >> 8));
-    Fifo_Put(ILI9341_Fifo, (rowEnd & 0x00FF));
+    const uint32_t params[4] = { ((rowStart & 0xFF00) >> 8), (rowStart & 0x00FF),
+                                 ((rowEnd & 0xFF00) >> 8), (rowEnd & 0x00FF) };
+    RingFifo_PutBlock(ILI9341_Fifo, params, 4);
     ILI9341_sendParams(PLTAR);
 
     return;
 }
 
+void ILI9341_setScrollArea(uint16_t topFixedRows, uint16_t bottomFixedRows) {
+    /**
+     *  This function implements the "Vertical Scrolling Definition" (`VSCRDEF`)
+     *  command from the ILI9341 datasheet. The top fixed area, scrolling area,
+     *  and bottom fixed area must add up to the number of rows.
+     */
+    assert(ili9341.isInit);
+    assert((topFixedRows + bottomFixedRows) < ILI9341_NUM_ROWS);
+
+    uint16_t numScrollRows = ILI9341_NUM_ROWS - (topFixedRows + bottomFixedRows);
+    const uint32_t params[6] = { ((topFixedRows & 0xFF00) >> 8),    (topFixedRows & 0x00FF),
+                                 ((numScrollRows & 0xFF00) >> 8),   (numScrollRows & 0x00FF),
+                                 ((bottomFixedRows & 0xFF00) >> 8), (bottomFixedRows & 0x00FF) };
+    RingFifo_PutBlock(ILI9341_Fifo, params, 6);
+    ILI9341_sendParams(VSCRDEF);
+
+    return;
+}
+
+void ILI9341_setScrollStart(uint16_t startRow) {
+    /**
+     *  This function implements the "Vertical Scrolling Start Address"
+     *  (`VSCRSADD`) command from the ILI9341 datasheet.
+     */
+    assert(ili9341.isInit);
+    assert(startRow < ILI9341_NUM_ROWS);
+
+    const uint32_t params[2] = { ((startRow & 0xFF00) >> 8), (startRow & 0x00FF) };
+    RingFifo_PutBlock(ILI9341_Fifo, params, 2);
+    ILI9341_sendParams(VSCRSADD);
+
+    return;
+}
+
 void ILI9341_setDispInversion(invertMode_t invertMode) {
     assert(ili9341.isInit);
     ILI9341_setMode(invertMode);
@@ -357,23 +415,40 @@ static void ILI9341_setAddress(uint16_t startAddress, uint16_t endAddress, bool
 
     To work correctly, `startAddress` must be no greater than `endAddress`,
     and `endAddress` cannot be greater than the max number of rows/columns.
+
+    The driver keeps the addresses until they're set again or it's reset, so
+    the command is skipped if it wouldn't change anything. This is common when
+    drawing text or the waveform, where usually only one axis moves at a time.
     */
 
     uint8_t cmd = (is_row) ? PASET : CASET;
     uint16_t max_num = (is_row) ? ILI9341_NUM_ROWS : ILI9341_NUM_COLS;
+    AddressRange_t * currAddress = (is_row) ? &ili9341.rowAddress : &ili9341.colAddress;
 
     // ensure `startAddress` and `endAddress` meet restrictions
     assert(endAddress < max_num);
     assert(startAddress <= endAddress);
 
+    if(currAddress->isValid && (currAddress->start == startAddress) &&
+       (currAddress->end == endAddress)) {
+        ili9341.numSkippedCmds += 1;
+        return;
+    }
+
+    // the cache is invalid until the command has been sent, so an interrupted command isn't
+    // mistaken for a match later
+    currAddress->isValid = false;
+
     // configure and send command sequence
-    Fifo_Put(ILI9341_Fifo, ((startAddress & 0xFF00) >> 8));
-    Fifo_Put(ILI9341_Fifo, (startAddress & 0x00FF));
-    Fifo_Put(ILI9341_Fifo, ((endAddress & 0xFF00) >> 8));
-    Fifo_Put(ILI9341_Fifo, (endAddress & 0x00FF));
+    const uint32_t params[4] = { ((startAddress & 0xFF00) >> 8), (startAddress & 0x00FF),
+                                 ((endAddress & 0xFF00) >> 8), (endAddress & 0x00FF) };
+    RingFifo_PutBlock(ILI9341_Fifo, params, 4);
 
     ILI9341_sendParams(cmd);
 
+    currAddress->start = startAddress;
+    currAddress->end = endAddress;
+    currAddress->isValid = true;
     return;
 }
 
@@ -397,6 +472,10 @@ void ILI9341_setColAddress(uint16_t startCol, uint16_t endCol) {
     return;
 }
 
+uint32_t ILI9341_getNumSkippedCmds(void) {
+    return ili9341.numSkippedCmds;
+}
+
 void ILI9341_writeMemCmd(void) {
     SPI_WriteCmd(ili9341.spi, RAMWR);
     return;
@@ -428,15 +507,16 @@ void ILI9341_writePixel(uint8_t red, uint8_t green, uint8_t blue) {
     // clang-format on
 
     if(ili9341.colorDepth == COLORDEPTH_16BIT) {
-        Fifo_Put(ILI9341_Fifo, ((red & 0x1F) << 3) | ((green & 0x38) >> 3));
-        Fifo_Put(ILI9341_Fifo, ((green & 0x07) << 5) | (blue & 0x1F));
+        const uint32_t params[2] = { ((red & 0x1F) << 3) | ((green & 0x38) >> 3),
+                                     ((green & 0x07) << 5) | (blue & 0x1F) };
+        RingFifo_PutBlock(ILI9341_Fifo, params, 2);
     }
     else {
         // bits 1 and 0 are set to prevent the TM4C from
         // attempting to right-justify the RGB data
-        Fifo_Put(ILI9341_Fifo, ((red & 0x3F) << 2) + 0x03);
-        Fifo_Put(ILI9341_Fifo, ((green & 0x3F) << 2) + 0x03);
-        Fifo_Put(ILI9341_Fifo, ((blue & 0x3F) << 2) + 0x03);
+        const uint32_t params[3] = { ((red & 0x3F) << 2) + 0x03, ((green & 0x3F) << 2) + 0x03,
+                                     ((blue & 0x3F) << 2) + 0x03 };
+        RingFifo_PutBlock(ILI9341_Fifo, params, 3);
     }
 
     ILI9341_sendParams(NOP);
@@ -444,4 +524,48 @@ void ILI9341_writePixel(uint8_t red, uint8_t green, uint8_t blue) {
     return;
 }
 
+uint16_t ILI9341_encodePixel(uint8_t red, uint8_t green, uint8_t blue) {
+    // same bit layout as in ILI9341_writePixel(), but as one 16-bit frame
+    return (uint16_t) (((red & 0x1F) << 11) | ((green & 0x3F) << 5) | (blue & 0x1F));
+}
+
+void ILI9341_startPixelStream(void) {
+    assert(ili9341.isInit);
+    assert(ili9341.isStreaming == false);
+    assert(ili9341.colorDepth == COLORDEPTH_16BIT);
+
+    SPI_WriteCmd(ili9341.spi, RAMWR);
+
+    // one frame per pixel halves the number of writes to the SPI's FIFO
+    SPI_Disable(ili9341.spi);
+    SPI_setDataSize(ili9341.spi, 16);
+    SPI_Enable(ili9341.spi);
+
+    ili9341.isStreaming = true;
+    return;
+}
+
+void ILI9341_streamPixels(uint16_t pixel, uint32_t numPixels) {
+    assert(ili9341.isStreaming);
+    SPI_WriteRepeat16(ili9341.spi, pixel, numPixels);
+    return;
+}
+
+void ILI9341_streamPixelBuffer(const uint16_t pixels[], uint32_t numPixels) {
+    assert(ili9341.isStreaming);
+    SPI_WriteBuffer16(ili9341.spi, pixels, numPixels);
+    return;
+}
+
+void ILI9341_endPixelStream(void) {
+    assert(ili9341.isStreaming);
+
+    SPI_Disable(ili9341.spi);
+    SPI_setDataSize(ili9341.spi, 8);
+    SPI_Enable(ili9341.spi);
+
+    ili9341.isStreaming = false;
+    return;
+}
+
 /** @} */
@@ -164,10 +164,45 @@ typedef enum {
  *
  * @param[in] displayArea   `NORMAL_AREA` or `PARTIAL_AREA`
  *
+ * @post                    Vertical scrolling (if any) is stopped.
+ *
  * @see                     ILI9341_setPartialArea()
  */
 void ILI9341_setDisplayArea(displayArea_t displayArea);
 
+/**
+ * @brief                   Define the area that is shifted by vertical scrolling.
+ *
+ * @details                 The rows (i.e. pages) are split into a top fixed area, the scrolling
+ *                          area, and a bottom fixed area. Only the scrolling area moves, so the
+ *                          fixed areas can hold anything that should stay put (e.g. text).
+ *
+ * @param[in] topFixedRows      Number of rows in the top fixed area.
+ * @param[in] bottomFixedRows   Number of rows in the bottom fixed area. The scrolling area gets
+ *                              the remaining `NUM_ROWS - topFixedRows - bottomFixedRows` rows.
+ *
+ * @post                    Scrolling starts once ILI9341_setScrollStart() is called, and stops
+ *                          when ILI9341_setDisplayArea() is called.
+ *
+ * @see                     ILI9341_setScrollStart()
+ */
+void ILI9341_setScrollArea(uint16_t topFixedRows, uint16_t bottomFixedRows);
+
+/**
+ * @brief                   Set the row of frame memory shown at the top of the scrolling area.
+ *
+ * @details                 The rows after `startRow` follow it, and wrap around to the top of the
+ *                          scrolling area. Changing this shifts the whole area without rewriting
+ *                          any frame memory.
+ *
+ * @pre                     Define the scrolling area.
+ *
+ * @param[in] startRow      Row in range `[topFixedRows, topFixedRows + numScrollRows)`.
+ *
+ * @see                     ILI9341_setScrollArea()
+ */
+void ILI9341_setScrollStart(uint16_t startRow);
+
 /**
  * @brief                   Set the display area for partial mode.
  *                          Call before activating partial mode.
@@ -289,6 +324,18 @@ void ILI9341_setRowAddress(uint16_t startRow, uint16_t endRow);
  */
 void ILI9341_setColAddress(uint16_t startCol, uint16_t endCol);
 
+/**
+ * @brief               Get the number of address commands that were skipped.
+ *
+ * @details             ILI9341_setRowAddress() and ILI9341_setColAddress() don't send anything if
+ *                      the driver already has the requested addresses, since each command takes
+ *                      5 transfers. The last addresses sent are only valid if one task at a time
+ *                      uses the display (see ILI9341_startPixelStream()).
+ *
+ * @param[out] uint32_t Number of `CASET`/`PASET` commands skipped since initialization.
+ */
+uint32_t ILI9341_getNumSkippedCmds(void);
+
 /**
  * @brief               Signal to the driver that pixel data is incoming and
  *                      should be written to memory.
@@ -314,6 +361,69 @@ void ILI9341_writeMemCmd(void);
  */
 void ILI9341_writePixel(uint8_t red, uint8_t green, uint8_t blue);
 
+/**
+ * @brief               Encode a color as a 16-bit (`RGB565`) pixel value.
+ *
+ * @param[in] red       5-bit `R` value
+ * @param[in] green     6-bit `G` value
+ * @param[in] blue      5-bit `B` value
+ * @param[out] uint16_t Pixel value for ILI9341_streamPixels() or ILI9341_streamPixelBuffer().
+ */
+uint16_t ILI9341_encodePixel(uint8_t red, uint8_t green, uint8_t blue);
+
+/**
+ * @brief               Start writing a stream of pixels to the current address window.
+ *
+ * @details             This is a faster alternative to calling ILI9341_writePixel() for each pixel.
+ *                      The pixels bypass the parameter FIFO and go straight to the SPI in bursts,
+ *                      as 16-bit frames.
+ *
+ * @pre                 Set the row and column addresses.
+ * @pre                 Set the color depth to `COLORDEPTH_16BIT`.
+ * @post                The LCD driver is ready to accept pixel data.
+ *
+ * @warning             Until ILI9341_endPixelStream() is called, the SPI sends 16-bit frames, so
+ *                      no other ILI9341 function may be called in between. With several tasks,
+ *                      only one at a time should use the display.
+ *
+ * @see                 ILI9341_streamPixels(), ILI9341_endPixelStream()
+ */
+void ILI9341_startPixelStream(void);
+
+/**
+ * @brief               Write the same pixel value to frame memory repeatedly.
+ *
+ * @pre                 Start the pixel stream.
+ *
+ * @param[in] pixel     Pixel value from ILI9341_encodePixel().
+ * @param[in] numPixels Number of pixels to write.
+ *
+ * @see                 ILI9341_startPixelStream(), ILI9341_streamPixelBuffer()
+ */
+void ILI9341_streamPixels(uint16_t pixel, uint32_t numPixels);
+
+/**
+ * @brief               Write a buffer of pixel values to frame memory.
+ *
+ * @pre                 Start the pixel stream.
+ *
+ * @param[in] pixels    Pixel values from ILI9341_encodePixel(), in the order the current address
+ *                      window is filled (i.e. column by column within each row).
+ * @param[in] numPixels Number of pixels to write.
+ *
+ * @see                 ILI9341_startPixelStream(), ILI9341_streamPixels()
+ */
+void ILI9341_streamPixelBuffer(const uint16_t pixels[], uint32_t numPixels);
+
+/**
+ * @brief               Stop writing a stream of pixels.
+ *
+ * @post                The SPI is back to 8-bit frames, so commands can be sent again.
+ *
+ * @see                 ILI9341_startPixelStream()
+ */
+void ILI9341_endPixelStream(void);
+
 #endif               // ILI9341_H
 
 /** @} */
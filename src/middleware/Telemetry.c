@@ -0,0 +1,317 @@
+/**
+ * @addtogroup telemetry
+ * @{
+ *
+ * @file
+ * @author  Bryan McElvy
+ * @brief   Source code for Telemetry module.
+ */
+
+#include "Telemetry.h"
+
+/******************************************************************************
+SECTIONS
+        Declarations
+        Initialization
+        Sending
+        Framing
+*******************************************************************************/
+
+#include "UART.h"
+
+#include "NewAssert.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+/******************************************************************************
+Declarations
+*******************************************************************************/
+
+enum MSG_OFFSETS {
+    TYPE_OFFSET = 0,
+    SEQ_OFFSET = 1,
+    BODY_OFFSET = TELEMETRY_HEADER_SIZE,
+    COUNT_OFFSET = BODY_OFFSET + 4,                               ///< sample messages only
+    SAMPLES_OFFSET = BODY_OFFSET + TELEMETRY_SAMPLE_HEADER_SIZE,  ///< sample messages only
+};
+
+/// @brief  Sample message that is being filled.
+typedef struct {
+    uint8_t msg[TELEMETRY_MAX_MSG_SIZE];
+    uint32_t firstSampleNum;
+    uint8_t count;                                                ///< num. samples in `msg`
+    uint8_t sampleSize;                                           ///< size of each sample [B]
+} SampleMsg_t;
+
+static Uart_t telemetryUart = 0;
+static uint16_t seqArray[TELEMETRY_NUM_MSG_TYPES + 1] = { 0 };   ///< next seq. num. of each type
+
+static SampleMsg_t rawMsg = { { 0 }, 0, 0, sizeof(uint16_t) };
+static SampleMsg_t filteredMsg = { { 0 }, 0, 0, sizeof(float) };
+static SampleMsg_t integratedMsg = { { 0 }, 0, 0, sizeof(float) };
+
+static void addSample(SampleMsg_t * sampleMsg, TelemetryMsgType_t type, uint32_t sampleNum,
+                      uint32_t value);
+static void sendSampleMsg(SampleMsg_t * sampleMsg, TelemetryMsgType_t type);
+static void sendMsg(uint8_t msg[], uint16_t msgSize, TelemetryMsgType_t type);
+static void writeLittleEndian(uint8_t bytes[], uint32_t value, uint8_t N);
+static uint32_t floatToBits(float value);
+
+/******************************************************************************
+Initialization
+*******************************************************************************/
+
+void Telemetry_Init(Uart_t uart) {
+    assert(UART_isInit(uart));
+
+    telemetryUart = uart;
+    memset(seqArray, 0, sizeof(seqArray));
+    rawMsg.count = 0;
+    filteredMsg.count = 0;
+    integratedMsg.count = 0;
+    return;
+}
+
+/******************************************************************************
+Sending
+*******************************************************************************/
+
+void Telemetry_AddRawSample(uint32_t sampleNum, uint16_t adcCode) {
+    addSample(&rawMsg, TELEMETRY_MSG_RAW, sampleNum, adcCode);
+    return;
+}
+
+void Telemetry_AddSample(TelemetryMsgType_t type, uint32_t sampleNum, float value) {
+    assert((type == TELEMETRY_MSG_FILTERED) || (type == TELEMETRY_MSG_INTEGRATED));
+
+    SampleMsg_t * sampleMsg = (type == TELEMETRY_MSG_FILTERED) ? &filteredMsg : &integratedMsg;
+    addSample(sampleMsg, type, sampleNum, floatToBits(value));
+    return;
+}
+
+void Telemetry_SendBeat(uint32_t sampleNum) {
+    uint8_t msg[BODY_OFFSET + 4];
+    writeLittleEndian(&msg[BODY_OFFSET], sampleNum, 4);
+    sendMsg(msg, sizeof(msg), TELEMETRY_MSG_BEAT);
+    return;
+}
+
+void Telemetry_SendHeartRate(uint32_t sampleNum, float heartRate_bpm) {
+    uint8_t msg[BODY_OFFSET + 8];
+    writeLittleEndian(&msg[BODY_OFFSET], sampleNum, 4);
+    writeLittleEndian(&msg[BODY_OFFSET + 4], floatToBits(heartRate_bpm), 4);
+    sendMsg(msg, sizeof(msg), TELEMETRY_MSG_HEART_RATE);
+    return;
+}
+
+static void addSample(SampleMsg_t * sampleMsg, TelemetryMsgType_t type, uint32_t sampleNum,
+                      uint32_t value) {
+    // a message only holds consecutive samples
+    if((sampleMsg->count > 0) && (sampleNum != (sampleMsg->firstSampleNum + sampleMsg->count))) {
+        sendSampleMsg(sampleMsg, type);
+    }
+
+    if(sampleMsg->count == 0) {
+        sampleMsg->firstSampleNum = sampleNum;
+    }
+
+    uint16_t offset = SAMPLES_OFFSET + (sampleMsg->count * sampleMsg->sampleSize);
+    writeLittleEndian(&sampleMsg->msg[offset], value, sampleMsg->sampleSize);
+    sampleMsg->count += 1;
+
+    if(sampleMsg->count == TELEMETRY_SAMPLES_PER_MSG) {
+        sendSampleMsg(sampleMsg, type);
+    }
+    return;
+}
+
+static void sendSampleMsg(SampleMsg_t * sampleMsg, TelemetryMsgType_t type) {
+    writeLittleEndian(&sampleMsg->msg[BODY_OFFSET], sampleMsg->firstSampleNum, 4);
+    sampleMsg->msg[COUNT_OFFSET] = sampleMsg->count;
+
+    sendMsg(sampleMsg->msg, SAMPLES_OFFSET + (sampleMsg->count * sampleMsg->sampleSize), type);
+    sampleMsg->count = 0;
+    return;
+}
+
+/// @brief  Fill in the message's header, then encode it and send it to the UART.
+static void sendMsg(uint8_t msg[], uint16_t msgSize, TelemetryMsgType_t type) {
+    assert(telemetryUart != 0);
+
+    msg[TYPE_OFFSET] = (uint8_t) type;
+    writeLittleEndian(&msg[SEQ_OFFSET], seqArray[type], 2);
+    seqArray[type] += 1;
+
+    uint8_t frame[TELEMETRY_FRAME_SIZE(TELEMETRY_MAX_MSG_SIZE)];
+    uint16_t frameSize = Telemetry_EncodeFrame(msg, msgSize, frame);
+    UART_WriteBytes(telemetryUart, frame, frameSize);
+    return;
+}
+
+static void writeLittleEndian(uint8_t bytes[], uint32_t value, uint8_t N) {
+    for(uint8_t idx = 0; idx < N; idx++) {
+        bytes[idx] = (uint8_t) (value >> (8 * idx));
+    }
+    return;
+}
+
+static uint32_t floatToBits(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+/******************************************************************************
+Framing
+*******************************************************************************/
+
+/**
+ * @details COBS replaces each zero with the distance to the next zero. The data is split into
+ *          blocks that each start with a "code" byte, which is 1 more than the num. of non-zero
+ *          bytes that follow it. A block implies a zero after it, except for the last block and
+ *          a full block (i.e. code `0xFF`) of 254 non-zero bytes.
+ */
+typedef struct {
+    uint8_t * output;
+    uint16_t idx;                                        ///< idx of next output byte
+    uint16_t codeIdx;                                    ///< idx of current block's code
+    uint8_t code;
+} CobsEncoder_t;
+
+static void cobsStartFrame(CobsEncoder_t * encoder, uint8_t frame[]);
+static void cobsStartBlock(CobsEncoder_t * encoder);
+static void cobsPut(CobsEncoder_t * encoder, uint8_t byte);
+static void cobsPutArray(CobsEncoder_t * encoder, const uint8_t bytes[], uint16_t N);
+static uint16_t cobsEndFrame(CobsEncoder_t * encoder);
+
+uint16_t Telemetry_Crc16(const uint8_t data[], uint32_t N) {
+    uint16_t crc = 0xFFFF;
+    for(uint32_t idx = 0; idx < N; idx++) {
+        crc ^= (uint16_t) (data[idx] << 8);
+        for(uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (uint16_t) ((crc << 1) ^ 0x1021) : (uint16_t) (crc << 1);
+        }
+    }
+    return crc;
+}
+
+uint16_t Telemetry_EncodeFrame(const uint8_t msg[], uint16_t msgSize, uint8_t frame[]) {
+    uint16_t crc = Telemetry_Crc16(msg, msgSize);
+    const uint8_t crcBytes[TELEMETRY_CRC_SIZE] = { (uint8_t) crc, (uint8_t) (crc >> 8) };
+
+    CobsEncoder_t encoder;
+    cobsStartFrame(&encoder, frame);
+    cobsPutArray(&encoder, msg, msgSize);
+    cobsPutArray(&encoder, crcBytes, TELEMETRY_CRC_SIZE);
+    return cobsEndFrame(&encoder);
+}
+
+void Telemetry_SendLog(uint8_t msgId, const uint8_t args[], uint8_t argsSize) {
+    assert(telemetryUart != 0);
+    assert(msgId < TELEMETRY_LOG_FLAG);
+    assert(argsSize <= TELEMETRY_MAX_LOG_ARGS_SIZE);
+
+    uint8_t frame[TELEMETRY_FRAME_SIZE(1 + TELEMETRY_MAX_LOG_ARGS_SIZE)];
+    CobsEncoder_t encoder;
+    cobsStartFrame(&encoder, frame);
+    cobsPut(&encoder, TELEMETRY_LOG_FLAG | msgId);
+    cobsPutArray(&encoder, args, argsSize);
+
+    uint16_t frameSize = cobsEndFrame(&encoder);
+    UART_WriteBytes(telemetryUart, frame, frameSize);
+    return;
+}
+
+bool Telemetry_DecodeFrame(const uint8_t encoded[], uint16_t encodedSize, uint8_t msg[],
+                           uint16_t * msgSizePtr) {
+    uint16_t inIdx = 0;
+    uint16_t outIdx = 0;
+
+    while(inIdx < encodedSize) {
+        uint8_t code = encoded[inIdx++];
+        if((code == 0) || ((inIdx + code - 1) > encodedSize)) {
+            return false;
+        }
+
+        for(uint8_t count = 1; count < code; count++) {
+            if(encoded[inIdx] == 0) {
+                return false;
+            }
+            msg[outIdx++] = encoded[inIdx++];
+        }
+
+        if((code != 0xFF) && (inIdx < encodedSize)) {
+            msg[outIdx++] = 0;
+        }
+    }
+
+    // log records have no CRC
+    if((outIdx > 0) && (msg[0] & TELEMETRY_LOG_FLAG)) {
+        *msgSizePtr = outIdx;
+        return true;
+    }
+
+    if(outIdx < (TELEMETRY_HEADER_SIZE + TELEMETRY_CRC_SIZE)) {
+        return false;
+    }
+
+    uint16_t msgSize = outIdx - TELEMETRY_CRC_SIZE;
+    uint16_t crc = (uint16_t) (msg[msgSize] | (msg[msgSize + 1] << 8));
+    if(crc != Telemetry_Crc16(msg, msgSize)) {
+        return false;
+    }
+
+    *msgSizePtr = msgSize;
+    return true;
+}
+
+static void cobsStartFrame(CobsEncoder_t * encoder, uint8_t frame[]) {
+    frame[0] = 0;
+    encoder->output = frame;
+    encoder->idx = 1;
+    cobsStartBlock(encoder);
+    return;
+}
+
+static void cobsStartBlock(CobsEncoder_t * encoder) {
+    encoder->codeIdx = encoder->idx;
+    encoder->idx += 1;
+    encoder->code = 1;
+    return;
+}
+
+static void cobsPut(CobsEncoder_t * encoder, uint8_t byte) {
+    if(byte == 0) {
+        encoder->output[encoder->codeIdx] = encoder->code;
+        cobsStartBlock(encoder);
+    }
+    else {
+        encoder->output[encoder->idx] = byte;
+        encoder->idx += 1;
+        encoder->code += 1;
+
+        if(encoder->code == 0xFF) {
+            encoder->output[encoder->codeIdx] = encoder->code;
+            cobsStartBlock(encoder);
+        }
+    }
+    return;
+}
+
+static void cobsPutArray(CobsEncoder_t * encoder, const uint8_t bytes[], uint16_t N) {
+    for(uint16_t idx = 0; idx < N; idx++) {
+        cobsPut(encoder, bytes[idx]);
+    }
+    return;
+}
+
+/// @brief  Finish the last block and add the trailing zero. Returns the size of the frame.
+static uint16_t cobsEndFrame(CobsEncoder_t * encoder) {
+    encoder->output[encoder->codeIdx] = encoder->code;
+    encoder->output[encoder->idx] = 0;
+    return encoder->idx + 1;
+}
+
+/** @} */
@@ -0,0 +1,219 @@
+/**
+ * @addtogroup telemetry
+ * @{
+ *
+ * @file
+ * @author  Bryan McElvy
+ * @brief   Header file for Telemetry module.
+ *
+ * @details Each message is sent over the UART as one frame:
+ *
+ *              0x00 | COBS( type | seq | body | CRC ) | 0x00
+ *
+ *          Field  | Size [B] | Description
+ *          -------|----------|--------------------------------------------------------------------
+ *          `type` | 1        | one of @ref TelemetryMsgType_t
+ *          `seq`  | 2        | sequence number, counted separately for each type
+ *          `body` | varies   | see below
+ *          `CRC`  | 2        | CRC-16/CCITT-FALSE of `type`, `seq`, and `body`
+ *
+ *          Message type                  | Body (field sizes in [B])
+ *          ------------------------------|---------------------------------------------------------
+ *          @ref TELEMETRY_MSG_RAW        | first sample num. (4), count (1), ADC codes (2 each)
+ *          @ref TELEMETRY_MSG_FILTERED   | first sample num. (4), count (1), samples [mV] (4 each)
+ *          @ref TELEMETRY_MSG_INTEGRATED | first sample num. (4), count (1), samples (4 each)
+ *          @ref TELEMETRY_MSG_BEAT       | sample num. of the beat (4)
+ *          @ref TELEMETRY_MSG_HEART_RATE | sample num. (4), heart rate [bpm] (4)
+ *
+ *          Multi-byte fields are little-endian, and non-integer values are IEEE-754 `float`s.
+ *          Sample numbers count from the first sample after reset at @ref QRS_SAMP_FREQ.
+ *
+ *          Log records from the @ref debug module (if `DEBUG_DEFERRED` is defined) are sent as
+ *          shorter frames without `seq` or `CRC`, so that logging costs only a few bytes:
+ *
+ *              0x00 | COBS( 0x80 + message ID | arguments ) | 0x00
+ *
+ *          Consistent overhead byte stuffing (COBS) removes every zero from the frame, so the
+ *          zeros only mark frame boundaries. The leading zero separates a frame from anything sent
+ *          before it (e.g. text from the @ref debug module, or a frame that was cut short when
+ *          the UART's TX buffer was full). A gap in a type's sequence numbers means messages were
+ *          lost.
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include "UART.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+SECTIONS
+        Protocol
+        Initialization
+        Sending
+        Framing
+********************************************************************************/
+
+/******************************************************************************
+Protocol
+*******************************************************************************/
+/** @name Protocol */               /// @{
+
+typedef enum {
+    TELEMETRY_MSG_RAW = 1,                              ///< 12-bit ADC codes
+    TELEMETRY_MSG_FILTERED,                             ///< samples after the notch filter
+    TELEMETRY_MSG_INTEGRATED,                           ///< output of the QRS detector's filters
+    TELEMETRY_MSG_BEAT,                                 ///< QRS complex in the integrated signal
+    TELEMETRY_MSG_HEART_RATE,                           ///< new heart rate value
+    TELEMETRY_NUM_MSG_TYPES = TELEMETRY_MSG_HEART_RATE,
+
+    TELEMETRY_LOG_FLAG = 0x80                           ///< first byte of a log record
+} TelemetryMsgType_t;
+
+enum TELEMETRY_SIZES {
+    TELEMETRY_HEADER_SIZE = 3,                          ///< `type` and `seq`
+    TELEMETRY_CRC_SIZE = 2,
+    TELEMETRY_SAMPLE_HEADER_SIZE = 5,                   ///< first sample num. and count
+    TELEMETRY_SAMPLES_PER_MSG = 8,                      ///< max. count of a sample message
+    TELEMETRY_MAX_LOG_ARGS_SIZE = 32,                   ///< max. size of a log record's arguments
+
+    /// max. size of `type`, `seq`, and `body`
+    TELEMETRY_MAX_MSG_SIZE = TELEMETRY_HEADER_SIZE + TELEMETRY_SAMPLE_HEADER_SIZE +
+                             (TELEMETRY_SAMPLES_PER_MSG * sizeof(float)),
+};
+
+/// @brief  Max. size of a frame holding a message of `msgSize` bytes, incl. the CRC and zeros.
+#define TELEMETRY_FRAME_SIZE(msgSize)                                                              \
+    ((msgSize) + TELEMETRY_CRC_SIZE + (((msgSize) + TELEMETRY_CRC_SIZE) / 254) + 1 + 2)
+
+/** @} */               // Protocol
+
+/******************************************************************************
+Initialization
+*******************************************************************************/
+/** @name Initialization */               /// @{
+
+/**
+ * @brief               Initialize the Telemetry module.
+ *
+ * @pre                 Initialize the UART. Enable its TX buffer so that sending doesn't block.
+ * @param[in] uart      UART to send the frames to.
+ * @post                All sequence numbers and partially filled sample messages are reset.
+ *
+ * @see                 UART_Init(), UART_EnableTxBuffer()
+ */
+void Telemetry_Init(Uart_t uart);
+
+/** @} */               // Initialization
+
+/******************************************************************************
+Sending
+*******************************************************************************/
+/** @name Sending */               /// @{
+
+/**
+ * @brief                   Add an ADC code to the current @ref TELEMETRY_MSG_RAW message.
+ *
+ * @details                 Samples are collected until the message holds
+ *                          @ref TELEMETRY_SAMPLES_PER_MSG of them, and then it is sent. If the
+ *                          sample num. doesn't follow the previous one, the samples collected
+ *                          so far are sent first.
+ *
+ * @pre                     Initialize the Telemetry module.
+ * @param[in] sampleNum     Sample number.
+ * @param[in] adcCode       12-bit ADC code.
+ *
+ * @note                    Each message type should only be sent from one task/ISR.
+ */
+void Telemetry_AddRawSample(uint32_t sampleNum, uint16_t adcCode);
+
+/**
+ * @brief                   Same as Telemetry_AddRawSample(), but for floating-point samples.
+ *
+ * @param[in] type          Either @ref TELEMETRY_MSG_FILTERED or @ref TELEMETRY_MSG_INTEGRATED.
+ * @param[in] sampleNum     Sample number.
+ * @param[in] value         Sample value.
+ */
+void Telemetry_AddSample(TelemetryMsgType_t type, uint32_t sampleNum, float value);
+
+/**
+ * @brief                   Send a @ref TELEMETRY_MSG_BEAT message.
+ *
+ * @pre                     Initialize the Telemetry module.
+ * @param[in] sampleNum     Sample num. of the QRS complex (in the integrated signal).
+ */
+void Telemetry_SendBeat(uint32_t sampleNum);
+
+/**
+ * @brief                   Send a @ref TELEMETRY_MSG_HEART_RATE message.
+ *
+ * @pre                     Initialize the Telemetry module.
+ * @param[in] sampleNum     Sample num. when the heart rate was updated.
+ * @param[in] heartRate_bpm Heart rate in [bpm].
+ */
+void Telemetry_SendHeartRate(uint32_t sampleNum, float heartRate_bpm);
+
+/**
+ * @brief                   Send a log record.
+ *
+ * @pre                     Initialize the Telemetry module.
+ * @param[in] msgId         Message ID (less than @ref TELEMETRY_LOG_FLAG).
+ * @param[in] args          Arguments of the message, already packed into bytes.
+ * @param[in] argsSize      Num. of bytes in `args` (up to @ref TELEMETRY_MAX_LOG_ARGS_SIZE).
+ *
+ * @note                    Log records have no sequence number, so they can be sent from any
+ *                          task. Each record is written to the UART at once.
+ *
+ * @see                     Debug_Init()
+ */
+void Telemetry_SendLog(uint8_t msgId, const uint8_t args[], uint8_t argsSize);
+
+/** @} */               // Sending
+
+/******************************************************************************
+Framing
+*******************************************************************************/
+/** @name Framing */               /// @{
+
+/**
+ * @brief                   Calculate the CRC-16/CCITT-FALSE of an array of bytes.
+ *
+ * @param[in] data          Array of bytes.
+ * @param[in] N             Number of bytes.
+ * @param[out] uint16_t     CRC (polynomial `0x1021`, initial value `0xFFFF`).
+ */
+uint16_t Telemetry_Crc16(const uint8_t data[], uint32_t N);
+
+/**
+ * @brief                   Append the CRC to a message and encode it as a frame.
+ *
+ * @param[in] msg           Message (i.e. `type`, `seq`, and `body`).
+ * @param[in] msgSize       Size of `msg` in bytes.
+ * @param[out] frame        Array of at least `TELEMETRY_FRAME_SIZE(msgSize)` bytes.
+ * @param[out] uint16_t     Size of the frame in bytes, incl. both zeros.
+ */
+uint16_t Telemetry_EncodeFrame(const uint8_t msg[], uint16_t msgSize, uint8_t frame[]);
+
+/**
+ * @brief                   Decode a frame and check its CRC.
+ *
+ * @details                 A log record (i.e. `msg[0]` includes @ref TELEMETRY_LOG_FLAG) has no
+ *                          CRC, so it is only checked for valid COBS.
+ *
+ * @param[in] encoded       Bytes between two zeros (i.e. without them).
+ * @param[in] encodedSize   Number of bytes in `encoded`.
+ * @param[out] msg          Array of at least `encodedSize` bytes for the decoded message.
+ * @param[out] msgSizePtr   Size of the message in bytes (without the CRC).
+ * @param[out] true         The frame is valid.
+ * @param[out] false        The frame is malformed, too short, or fails the CRC.
+ */
+bool Telemetry_DecodeFrame(const uint8_t encoded[], uint16_t encodedSize, uint8_t msg[],
+                           uint16_t * msgSizePtr);
+
+/** @} */               // Framing
+
+#endif                  // TELEMETRY_H
+
+/** @} */               // telemetry
@@ -7,6 +7,8 @@
 extern "C" {
 #include "FIFO.h"
 
+#include <pthread.h>
+#include <sched.h>
 #include <stdlib.h>
 }
 
@@ -23,6 +25,11 @@ SECTIONS
         After Peek
         After Reaching Capacity
         Float
+        Lock-Free Ring Buffer
+        Lock-Free Ring Buffer (Any Type)
+        Lock-Free Ring Buffer (Instrumentation)
+        Broadcast Ring Buffer
+        Lock-Free Ring Buffer (Threads)
 *******************************************************************************/
 
 /******************************************************************************
@@ -341,4 +348,639 @@ TEST(Group_FIFO_Float, AfterPeekAll_OutputHasCorrectFloatVals) {
     }
 }
 
+/******************************************************************************
+Lock-Free Ring Buffer
+*******************************************************************************/
+
+#define RING_BUFFER_SIZE    8
+
+TEST_GROUP(Group_RingFifo) {
+    RingFifo_t ring;
+    uint32_t ringBuffer[RING_BUFFER_SIZE] = { 0 };
+    uint32_t inputArray[RING_BUFFER_SIZE + 2] = {29, 81, 73, 79, 2, 40, 21, 60, 93, 17};
+    uint32_t outputArray[RING_BUFFER_SIZE + 2] = { 0 };
+
+    void setup() {
+        ring = RingFifo_Init(ringBuffer, RING_BUFFER_SIZE);
+    }
+
+    void teardown() {}
+};
+
+TEST(Group_RingFifo, AfterInit_isEmpty) {
+    CHECK_TRUE(RingFifo_isEmpty(ring));
+    CHECK_FALSE(RingFifo_isFull(ring));
+    CHECK_FALSE(RingFifo_Get(ring, &outputArray[0]));
+}
+
+TEST(Group_RingFifo, AllElementsAreUsable) {
+    for(uint8_t n = 0; n < RING_BUFFER_SIZE; n++) {
+        CHECK_TRUE(RingFifo_Put(ring, inputArray[n]));
+    }
+
+    CHECK_TRUE(RingFifo_isFull(ring));
+    CHECK_EQUAL(RING_BUFFER_SIZE, RingFifo_getCurrSize(ring));
+    CHECK_FALSE(RingFifo_Put(ring, inputArray[RING_BUFFER_SIZE]));
+}
+
+TEST(Group_RingFifo, GetReturnsValsInOrder) {
+    for(uint8_t n = 0; n < 5; n++) {
+        RingFifo_Put(ring, inputArray[n]);
+    }
+
+    for(uint8_t n = 0; n < 5; n++) {
+        uint32_t val;
+        CHECK_TRUE(RingFifo_Get(ring, &val));
+        CHECK_EQUAL(inputArray[n], val);
+    }
+    CHECK_TRUE(RingFifo_isEmpty(ring));
+}
+
+TEST(Group_RingFifo, PutBlockIsLimitedByFreeSpace) {
+    RingFifo_Put(ring, inputArray[0]);
+    CHECK_EQUAL(RING_BUFFER_SIZE - 1, RingFifo_PutBlock(ring, &inputArray[1], RING_BUFFER_SIZE + 1));
+    CHECK_TRUE(RingFifo_isFull(ring));
+}
+
+TEST(Group_RingFifo, GetBlockIsLimitedByCurrSize) {
+    RingFifo_PutBlock(ring, inputArray, 3);
+    CHECK_EQUAL(3, RingFifo_GetBlock(ring, outputArray, RING_BUFFER_SIZE));
+    MEMCMP_EQUAL(inputArray, outputArray, 3 * sizeof(inputArray[0]));
+    CHECK_EQUAL(0, RingFifo_GetBlock(ring, outputArray, RING_BUFFER_SIZE));
+}
+
+TEST(Group_RingFifo, BlocksWrapAroundEndOfBuffer) {
+    // move the front/back indices to the middle of the buffer
+    RingFifo_PutBlock(ring, inputArray, 6);
+    RingFifo_GetBlock(ring, outputArray, 6);
+
+    // both spans are used for the next put and get
+    CHECK_EQUAL(RING_BUFFER_SIZE, RingFifo_PutBlock(ring, inputArray, RING_BUFFER_SIZE));
+    CHECK_EQUAL(RING_BUFFER_SIZE, RingFifo_GetBlock(ring, outputArray, RING_BUFFER_SIZE));
+    MEMCMP_EQUAL(inputArray, outputArray, RING_BUFFER_SIZE * sizeof(inputArray[0]));
+}
+
+TEST(Group_RingFifo, AfterReset_isEmpty) {
+    RingFifo_PutBlock(ring, inputArray, 5);
+    RingFifo_Reset(ring);
+    CHECK_TRUE(RingFifo_isEmpty(ring));
+    CHECK_EQUAL(0, RingFifo_getCurrSize(ring));
+}
+
+
+TEST(Group_RingFifo, ReservedValsAreHiddenUntilCommit) {
+    uint32_t * span;
+    CHECK_EQUAL(3, RingFifo_ReserveWrite(ring, &span, 3));
+    span[0] = inputArray[0];
+    span[1] = inputArray[1];
+    span[2] = inputArray[2];
+    CHECK_TRUE(RingFifo_isEmpty(ring));
+
+    RingFifo_CommitWrite(ring, 3);
+    CHECK_EQUAL(3, RingFifo_GetBlock(ring, outputArray, RING_BUFFER_SIZE));
+    MEMCMP_EQUAL(inputArray, outputArray, 3 * sizeof(inputArray[0]));
+}
+
+TEST(Group_RingFifo, SpansStopAtEndOfBuffer) {
+    uint32_t * span;
+
+    // move the front/back indices to the middle of the buffer
+    RingFifo_PutBlock(ring, inputArray, 6);
+    RingFifo_GetBlock(ring, outputArray, 6);
+
+    CHECK_EQUAL(RING_BUFFER_SIZE - 6, RingFifo_ReserveWrite(ring, &span, RING_BUFFER_SIZE));
+    POINTERS_EQUAL(&ringBuffer[6], span);
+    RingFifo_CommitWrite(ring, RING_BUFFER_SIZE - 6);
+
+    CHECK_EQUAL(6, RingFifo_ReserveWrite(ring, &span, RING_BUFFER_SIZE));
+    POINTERS_EQUAL(&ringBuffer[0], span);
+    RingFifo_CommitWrite(ring, 6);
+
+    CHECK_TRUE(RingFifo_isFull(ring));
+    CHECK_EQUAL(RING_BUFFER_SIZE - 6, RingFifo_PeekSpan(ring, &span));
+    POINTERS_EQUAL(&ringBuffer[6], span);
+}
+
+TEST(Group_RingFifo, PeekedValsCanBeModifiedInPlace) {
+    uint32_t * span;
+    RingFifo_PutBlock(ring, inputArray, 4);
+
+    uint32_t numVals = RingFifo_PeekSpan(ring, &span);
+    CHECK_EQUAL(4, numVals);
+    for(uint32_t n = 0; n < numVals; n++) {
+        span[n] *= 2;
+    }
+    CHECK_EQUAL(4, RingFifo_getCurrSize(ring));
+
+    RingFifo_Release(ring, 1);
+    CHECK_EQUAL(3, RingFifo_GetBlock(ring, outputArray, RING_BUFFER_SIZE));
+    for(uint32_t n = 0; n < 3; n++) {
+        CHECK_EQUAL(inputArray[n + 1] * 2, outputArray[n]);
+    }
+}
+
+TEST(Group_RingFifo, PeekSpanOfEmptyRingIsEmpty) {
+    uint32_t * span;
+    CHECK_EQUAL(0, RingFifo_PeekSpan(ring, &span));
+}
+
+/******************************************************************************
+Lock-Free Ring Buffer (Any Type)
+*******************************************************************************/
+
+typedef struct {
+    uint32_t timestamp;
+    uint16_t sample;
+} TimedSample_t;
+
+RING_FIFO_DEFINE_TYPE(TimedSampleFifo, TimedSample_t)
+
+TEST_GROUP(Group_RingFifo_AnyType) {
+    void setup() {}
+    void teardown() {}
+};
+
+TEST(Group_RingFifo_AnyType, Uint16ValsArePacked) {
+    uint16_t buffer[RING_BUFFER_SIZE] = { 0 };
+    RingFifo16_t fifo = RingFifo16_Init(buffer, RING_BUFFER_SIZE);
+
+    RingFifo16_Put(fifo, 0xABC);
+    RingFifo16_Put(fifo, 0x123);
+    CHECK_EQUAL(0xABC, buffer[0]);
+    CHECK_EQUAL(0x123, buffer[1]);
+
+    uint16_t val;
+    CHECK_TRUE(RingFifo16_Get(fifo, &val));
+    CHECK_EQUAL(0xABC, val);
+    CHECK_EQUAL(1, RingFifo16_getCurrSize(fifo));
+}
+
+TEST(Group_RingFifo_AnyType, FloatValsAreUnchanged) {
+    float32_t buffer[RING_BUFFER_SIZE] = { 0 };
+    RingFifoFloat_t fifo = RingFifoFloat_Init(buffer, RING_BUFFER_SIZE);
+
+    float32_t val = 0;
+    RingFifoFloat_Put(fifo, 64.17631782f);
+    CHECK_TRUE(RingFifoFloat_Get(fifo, &val));
+    CHECK_EQUAL(64.17631782f, val);
+}
+
+TEST(Group_RingFifo_AnyType, StructBlocksWrapAroundEndOfBuffer) {
+    TimedSample_t buffer[RING_BUFFER_SIZE];
+    TimedSample_t input[RING_BUFFER_SIZE];
+    TimedSample_t output[RING_BUFFER_SIZE];
+    TimedSampleFifo_t fifo = TimedSampleFifo_Init(buffer, RING_BUFFER_SIZE);
+
+    for(uint32_t n = 0; n < RING_BUFFER_SIZE; n++) {
+        input[n].timestamp = 1000 + n;
+        input[n].sample = (uint16_t) (0x800 + n);
+    }
+
+    // move the front/back indices to the middle of the buffer
+    TimedSampleFifo_PutBlock(fifo, input, 5);
+    TimedSampleFifo_GetBlock(fifo, output, 5);
+
+    CHECK_EQUAL(RING_BUFFER_SIZE, TimedSampleFifo_PutBlock(fifo, input, RING_BUFFER_SIZE));
+    CHECK_TRUE(TimedSampleFifo_isFull(fifo));
+    CHECK_EQUAL(RING_BUFFER_SIZE, TimedSampleFifo_GetBlock(fifo, output, RING_BUFFER_SIZE));
+    for(uint32_t n = 0; n < RING_BUFFER_SIZE; n++) {
+        CHECK_EQUAL(input[n].timestamp, output[n].timestamp);
+        CHECK_EQUAL(input[n].sample, output[n].sample);
+    }
+}
+
+TEST(Group_RingFifo_AnyType, StructSpansPointIntoBuffer) {
+    TimedSample_t buffer[RING_BUFFER_SIZE];
+    TimedSampleFifo_t fifo = TimedSampleFifo_Init(buffer, RING_BUFFER_SIZE);
+
+    TimedSample_t * span;
+    CHECK_EQUAL(2, TimedSampleFifo_ReserveWrite(fifo, &span, 2));
+    POINTERS_EQUAL(&buffer[0], span);
+    span[0].timestamp = 7;
+    span[1].timestamp = 8;
+    TimedSampleFifo_CommitWrite(fifo, 2);
+
+    TimedSampleFifo_Release(fifo, TimedSampleFifo_PeekSpan(fifo, &span) - 1);
+    CHECK_EQUAL(1, TimedSampleFifo_PeekSpan(fifo, &span));
+    POINTERS_EQUAL(&buffer[1], span);
+    CHECK_EQUAL(8, span[0].timestamp);
+}
+
+/******************************************************************************
+Lock-Free Ring Buffer (Instrumentation)
+*******************************************************************************/
+
+TEST_GROUP(Group_RingFifo_Instrumentation) {
+    RingFifo_t ring;
+    RingFifoStats_t stats;
+    uint32_t ringBuffer[RING_BUFFER_SIZE] = { 0 };
+    uint32_t inputArray[RING_BUFFER_SIZE + 4] = {29, 81, 73, 79, 2, 40, 21, 60, 93, 17, 55, 8};
+    uint32_t outputArray[RING_BUFFER_SIZE + 4] = { 0 };
+
+    void setup() {
+        ring = RingFifo_Init(ringBuffer, RING_BUFFER_SIZE);
+    }
+
+    void teardown() {}
+};
+
+TEST(Group_RingFifo_Instrumentation, PeakSizeIsHighWaterMark) {
+    RingFifo_PutBlock(ring, inputArray, 5);
+    RingFifo_GetBlock(ring, outputArray, 5);
+    RingFifo_PutBlock(ring, inputArray, 2);
+
+    RingFifo_getStats(ring, &stats);
+    CHECK_EQUAL(RING_BUFFER_SIZE, stats.N);
+    CHECK_EQUAL(5, stats.peakSize);
+}
+
+TEST(Group_RingFifo_Instrumentation, DropNewest_KeepsOldestVals) {
+    CHECK_EQUAL(RING_BUFFER_SIZE, RingFifo_PutBlock(ring, inputArray, RING_BUFFER_SIZE + 2));
+    CHECK_FALSE(RingFifo_Put(ring, inputArray[RING_BUFFER_SIZE + 2]));
+
+    RingFifo_getStats(ring, &stats);
+    CHECK_EQUAL(RING_BUFFER_SIZE, stats.peakSize);
+    CHECK_EQUAL(3, stats.numDropped);
+
+    RingFifo_GetBlock(ring, outputArray, RING_BUFFER_SIZE);
+    MEMCMP_EQUAL(inputArray, outputArray, RING_BUFFER_SIZE * sizeof(uint32_t));
+}
+
+TEST(Group_RingFifo_Instrumentation, DropOldest_KeepsNewestVals) {
+    RingFifo_setOverflowPolicy(ring, RING_FIFO_DROP_OLDEST);
+    for(uint32_t n = 0; n < (RING_BUFFER_SIZE + 2); n++) {
+        CHECK_TRUE(RingFifo_Put(ring, inputArray[n]));
+    }
+
+    RingFifo_getStats(ring, &stats);
+    CHECK_EQUAL(RING_BUFFER_SIZE, stats.peakSize);
+    CHECK_EQUAL(2, stats.numDropped);
+
+    CHECK_EQUAL(RING_BUFFER_SIZE, RingFifo_GetBlock(ring, outputArray, RING_BUFFER_SIZE));
+    MEMCMP_EQUAL(&inputArray[2], outputArray, RING_BUFFER_SIZE * sizeof(uint32_t));
+}
+
+TEST(Group_RingFifo_Instrumentation, DropOldest_BlockLargerThanRingKeepsNewestVals) {
+    RingFifo_setOverflowPolicy(ring, RING_FIFO_DROP_OLDEST);
+    RingFifo_Put(ring, 1234);
+
+    CHECK_EQUAL(RING_BUFFER_SIZE, RingFifo_PutBlock(ring, inputArray, RING_BUFFER_SIZE + 4));
+    RingFifo_getStats(ring, &stats);
+    CHECK_EQUAL(5, stats.numDropped);
+
+    CHECK_EQUAL(RING_BUFFER_SIZE, RingFifo_GetBlock(ring, outputArray, RING_BUFFER_SIZE + 4));
+    MEMCMP_EQUAL(&inputArray[4], outputArray, RING_BUFFER_SIZE * sizeof(uint32_t));
+}
+
+TEST(Group_RingFifo_Instrumentation, UnderflowIsCountedWhenEmpty) {
+    uint32_t val;
+    CHECK_FALSE(RingFifo_Get(ring, &val));
+    CHECK_EQUAL(0, RingFifo_GetBlock(ring, outputArray, 4));
+
+    // partial reads are not underflows
+    RingFifo_Put(ring, inputArray[0]);
+    CHECK_EQUAL(1, RingFifo_GetBlock(ring, outputArray, 4));
+
+    RingFifo_getStats(ring, &stats);
+    CHECK_EQUAL(2, stats.numUnderflows);
+}
+
+TEST(Group_RingFifo_Instrumentation, ResetStatsClearsCounters) {
+    uint32_t val;
+    RingFifo_PutBlock(ring, inputArray, RING_BUFFER_SIZE + 2);
+    RingFifo_GetBlock(ring, outputArray, RING_BUFFER_SIZE);
+    RingFifo_Get(ring, &val);
+
+    RingFifo_resetStats(ring);
+    RingFifo_getStats(ring, &stats);
+    CHECK_EQUAL(RING_BUFFER_SIZE, stats.N);
+    CHECK_EQUAL(0, stats.peakSize);
+    CHECK_EQUAL(0, stats.numDropped);
+    CHECK_EQUAL(0, stats.numUnderflows);
+}
+
+/******************************************************************************
+Broadcast Ring Buffer
+*******************************************************************************/
+
+TEST_GROUP(Group_BroadcastFifo) {
+    BroadcastFifo_t fifo;
+    BroadcastReader_t readerA, readerB;
+    uint32_t ringBuffer[RING_BUFFER_SIZE] = { 0 };
+    uint32_t inputArray[RING_BUFFER_SIZE + 2] = {29, 81, 73, 79, 2, 40, 21, 60, 93, 17};
+    uint32_t outputArray[RING_BUFFER_SIZE + 2] = { 0 };
+
+    void setup() {
+        fifo = BroadcastFifo_Init(ringBuffer, RING_BUFFER_SIZE, sizeof(uint32_t));
+        readerA = BroadcastFifo_AddReader(fifo);
+        readerB = BroadcastFifo_AddReader(fifo);
+    }
+
+    void teardown() {}
+};
+
+TEST(Group_BroadcastFifo, EveryReaderSeesEveryVal) {
+    for(uint32_t n = 0; n < 5; n++) {
+        CHECK_TRUE(BroadcastFifo_Put(fifo, &inputArray[n]));
+    }
+
+    uint32_t val;
+    for(uint32_t n = 0; n < 5; n++) {
+        CHECK_TRUE(BroadcastFifo_Get(readerA, &val));
+        CHECK_EQUAL(inputArray[n], val);
+    }
+    CHECK_FALSE(BroadcastFifo_Get(readerA, &val));
+
+    CHECK_EQUAL(5, BroadcastFifo_GetBlock(readerB, outputArray, RING_BUFFER_SIZE));
+    MEMCMP_EQUAL(inputArray, outputArray, 5 * sizeof(uint32_t));
+}
+
+TEST(Group_BroadcastFifo, ValsAreStoredOnce) {
+    BroadcastFifo_PutBlock(fifo, inputArray, 3);
+
+    void * spanA;
+    void * spanB;
+    CHECK_EQUAL(3, BroadcastFifo_PeekSpan(readerA, &spanA));
+    CHECK_EQUAL(3, BroadcastFifo_PeekSpan(readerB, &spanB));
+    POINTERS_EQUAL(&ringBuffer[0], spanA);
+    POINTERS_EQUAL(spanA, spanB);
+}
+
+TEST(Group_BroadcastFifo, SlowestReaderLimitsProducer) {
+    CHECK_EQUAL(RING_BUFFER_SIZE, BroadcastFifo_PutBlock(fifo, inputArray, RING_BUFFER_SIZE + 2));
+
+    // reader A catching up isn't enough
+    BroadcastFifo_GetBlock(readerA, outputArray, RING_BUFFER_SIZE);
+    CHECK_FALSE(BroadcastFifo_Put(fifo, &inputArray[0]));
+
+    BroadcastFifo_GetBlock(readerB, outputArray, 2);
+    CHECK_EQUAL(2, BroadcastFifo_PutBlock(fifo, &inputArray[RING_BUFFER_SIZE], 2));
+    CHECK_EQUAL(2, BroadcastFifo_getLag(readerA));
+    CHECK_EQUAL(RING_BUFFER_SIZE, BroadcastFifo_getLag(readerB));
+
+    RingFifoStats_t stats;
+    BroadcastFifo_getStats(fifo, &stats);
+    CHECK_EQUAL(RING_BUFFER_SIZE, stats.peakSize);
+    CHECK_EQUAL(3, stats.numDropped);
+}
+
+TEST(Group_BroadcastFifo, BlocksWrapAroundEndOfBuffer) {
+    BroadcastFifo_PutBlock(fifo, inputArray, 5);
+    BroadcastFifo_GetBlock(readerA, outputArray, 5);
+    BroadcastFifo_GetBlock(readerB, outputArray, 5);
+
+    CHECK_EQUAL(RING_BUFFER_SIZE, BroadcastFifo_PutBlock(fifo, inputArray, RING_BUFFER_SIZE));
+    CHECK_EQUAL(RING_BUFFER_SIZE, BroadcastFifo_GetBlock(readerA, outputArray, RING_BUFFER_SIZE));
+    MEMCMP_EQUAL(inputArray, outputArray, RING_BUFFER_SIZE * sizeof(uint32_t));
+}
+
+TEST(Group_BroadcastFifo, ReaderStatsAreIndependent) {
+    uint32_t val;
+    BroadcastFifo_PutBlock(fifo, inputArray, 4);
+    BroadcastFifo_GetBlock(readerA, outputArray, 4);
+    BroadcastFifo_Get(readerA, &val);
+    BroadcastFifo_Get(readerA, &val);
+    BroadcastFifo_Get(readerB, &val);
+
+    RingFifoStats_t stats;
+    BroadcastFifo_getReaderStats(readerA, &stats);
+    CHECK_EQUAL(RING_BUFFER_SIZE, stats.N);
+    CHECK_EQUAL(4, stats.peakSize);
+    CHECK_EQUAL(2, stats.numUnderflows);
+
+    BroadcastFifo_getReaderStats(readerB, &stats);
+    CHECK_EQUAL(4, stats.peakSize);
+    CHECK_EQUAL(0, stats.numUnderflows);
+}
+
+TEST(Group_BroadcastFifo, NewReaderStartsEmpty) {
+    BroadcastFifo_PutBlock(fifo, inputArray, 3);
+    BroadcastReader_t readerC = BroadcastFifo_AddReader(fifo);
+    CHECK_EQUAL(0, BroadcastFifo_getLag(readerC));
+
+    BroadcastFifo_Put(fifo, &inputArray[3]);
+    uint32_t val;
+    CHECK_TRUE(BroadcastFifo_Get(readerC, &val));
+    CHECK_EQUAL(inputArray[3], val);
+}
+
+/******************************************************************************
+Lock-Free Ring Buffer (Threads)
+*******************************************************************************/
+
+#define RING_STRESS_BUFFER_SIZE     64
+#define RING_STRESS_NUM_VALS        2000000
+#define RING_STRESS_MAX_BLOCK       (RING_STRESS_BUFFER_SIZE + 3)
+
+/**
+ * @brief   Producer thread for the stress test. It sends the sequence `1, 2, 3, ...` using a mix
+ *          of single puts, block puts, and reserve/commit writes of varying sizes, retrying
+ *          whenever the ring is full.
+ *
+ * @note    Both threads yield when they can't make progress, so the test also finishes quickly
+ *          on a single-core host.
+ */
+static void * ringProducer(void * arg) {
+    RingFifo_t ring = (RingFifo_t) arg;
+    uint32_t block[RING_STRESS_MAX_BLOCK];
+    uint32_t nextVal = 1;
+
+    while(nextVal <= RING_STRESS_NUM_VALS) {
+        uint32_t numVals = 1 + (nextVal % RING_STRESS_MAX_BLOCK);
+        if(numVals > (RING_STRESS_NUM_VALS - nextVal + 1)) {
+            numVals = RING_STRESS_NUM_VALS - nextVal + 1;
+        }
+
+        uint32_t numPut;
+        if(numVals == 1) {
+            numPut = RingFifo_Put(ring, nextVal) ? 1 : 0;
+        }
+        else if((nextVal % 3) == 0) {
+            uint32_t * span;
+            numPut = RingFifo_ReserveWrite(ring, &span, numVals);
+            for(uint32_t n = 0; n < numPut; n++) {
+                span[n] = nextVal + n;
+            }
+            RingFifo_CommitWrite(ring, numPut);
+        }
+        else {
+            for(uint32_t n = 0; n < numVals; n++) {
+                block[n] = nextVal + n;
+            }
+            numPut = RingFifo_PutBlock(ring, block, numVals);
+        }
+
+        nextVal += numPut;
+        if(numPut == 0) {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+TEST_GROUP(Group_RingFifo_Threads) {
+    RingFifo_t ring;
+    uint32_t ringBuffer[RING_STRESS_BUFFER_SIZE] = { 0 };
+
+    void setup() {
+        ring = RingFifo_Init(ringBuffer, RING_STRESS_BUFFER_SIZE);
+    }
+
+    void teardown() {}
+};
+
+TEST(Group_RingFifo_Threads, ConsumerSeesEveryValInOrder) {
+    pthread_t producer;
+    CHECK_EQUAL(0, pthread_create(&producer, NULL, ringProducer, (void *) ring));
+
+    uint32_t block[RING_STRESS_MAX_BLOCK];
+    uint32_t expectedVal = 1;
+    uint32_t numErrors = 0;
+    uint32_t numReads = 0;
+
+    while(expectedVal <= RING_STRESS_NUM_VALS) {
+        uint32_t numVals;
+        uint32_t * vals = block;
+        switch(numReads++ % 3) {
+            case 0:
+                numVals = RingFifo_Get(ring, &block[0]) ? 1 : 0;
+                break;
+            case 1:
+                numVals = RingFifo_GetBlock(ring, block, 1 + (numReads % RING_STRESS_MAX_BLOCK));
+                break;
+            default:
+                numVals = RingFifo_PeekSpan(ring, &vals);
+                break;
+        }
+
+        for(uint32_t n = 0; n < numVals; n++) {
+            numErrors += (vals[n] != expectedVal) ? 1 : 0;
+            expectedVal += 1;
+        }
+
+        if(vals != block) {
+            RingFifo_Release(ring, numVals);
+        }
+
+        if(numVals == 0) {
+            sched_yield();
+        }
+    }
+
+    pthread_join(producer, NULL);
+
+    CHECK_EQUAL(0, numErrors);
+    CHECK_TRUE(RingFifo_isEmpty(ring));
+}
+
+/// @brief  Reader thread for the broadcast stress test.
+typedef struct {
+    BroadcastReader_t reader;
+    uint32_t numErrors;
+} BroadcastStressReader_t;
+
+/**
+ * @brief   Producer thread for the broadcast stress test. It sends the sequence `1, 2, 3, ...`
+ *          using a mix of single puts and block puts, retrying whenever the slowest reader is too
+ *          far behind.
+ */
+static void * broadcastProducer(void * arg) {
+    BroadcastFifo_t fifo = (BroadcastFifo_t) arg;
+    uint32_t block[RING_STRESS_MAX_BLOCK];
+    uint32_t nextVal = 1;
+
+    while(nextVal <= RING_STRESS_NUM_VALS) {
+        uint32_t numVals = 1 + (nextVal % RING_STRESS_MAX_BLOCK);
+        if(numVals > (RING_STRESS_NUM_VALS - nextVal + 1)) {
+            numVals = RING_STRESS_NUM_VALS - nextVal + 1;
+        }
+
+        uint32_t numPut;
+        if(numVals == 1) {
+            numPut = BroadcastFifo_Put(fifo, &nextVal) ? 1 : 0;
+        }
+        else {
+            for(uint32_t n = 0; n < numVals; n++) {
+                block[n] = nextVal + n;
+            }
+            numPut = BroadcastFifo_PutBlock(fifo, block, numVals);
+        }
+
+        nextVal += numPut;
+        if(numPut == 0) {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/// @brief  Reader thread for the broadcast stress test. Alternates between block reads and spans.
+static void * broadcastReader(void * arg) {
+    BroadcastStressReader_t * stressReader = (BroadcastStressReader_t *) arg;
+    uint32_t block[RING_STRESS_MAX_BLOCK];
+    uint32_t expectedVal = 1;
+    uint32_t numReads = 0;
+
+    while(expectedVal <= RING_STRESS_NUM_VALS) {
+        uint32_t numVals;
+        void * span = block;
+        if((numReads++ % 2) == 0) {
+            numVals = BroadcastFifo_GetBlock(stressReader->reader, block,
+                                             1 + (numReads % RING_STRESS_MAX_BLOCK));
+        }
+        else {
+            numVals = BroadcastFifo_PeekSpan(stressReader->reader, &span);
+        }
+
+        uint32_t * vals = (uint32_t *) span;
+        for(uint32_t n = 0; n < numVals; n++) {
+            stressReader->numErrors += (vals[n] != expectedVal) ? 1 : 0;
+            expectedVal += 1;
+        }
+
+        if(vals != block) {
+            BroadcastFifo_Release(stressReader->reader, numVals);
+        }
+
+        if(numVals == 0) {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+TEST_GROUP(Group_BroadcastFifo_Threads) {
+    BroadcastFifo_t fifo;
+    uint32_t ringBuffer[RING_STRESS_BUFFER_SIZE] = { 0 };
+    BroadcastStressReader_t readers[2];
+
+    void setup() {
+        fifo = BroadcastFifo_Init(ringBuffer, RING_STRESS_BUFFER_SIZE, sizeof(uint32_t));
+        for(uint8_t idx = 0; idx < 2; idx++) {
+            readers[idx].reader = BroadcastFifo_AddReader(fifo);
+            readers[idx].numErrors = 0;
+        }
+    }
+
+    void teardown() {}
+};
+
+TEST(Group_BroadcastFifo_Threads, EveryReaderSeesEveryValInOrder) {
+    pthread_t producer, readerThreads[2];
+    for(uint8_t idx = 0; idx < 2; idx++) {
+        CHECK_EQUAL(0, pthread_create(&readerThreads[idx], NULL, broadcastReader, &readers[idx]));
+    }
+    CHECK_EQUAL(0, pthread_create(&producer, NULL, broadcastProducer, (void *) fifo));
+
+    pthread_join(producer, NULL);
+    for(uint8_t idx = 0; idx < 2; idx++) {
+        pthread_join(readerThreads[idx], NULL);
+        CHECK_EQUAL(0, readers[idx].numErrors);
+        CHECK_EQUAL(0, BroadcastFifo_getLag(readers[idx].reader));
+    }
+}
+
 // NOLINTEND
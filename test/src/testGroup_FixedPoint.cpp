@@ -0,0 +1,230 @@
+// clang-format off
+// NOLINTBEGIN
+
+#include "CppUTest/TestHarness.h"
+
+extern "C" {
+#include "DAQ.h"
+#include "QRS.h"
+
+#include <math.h>
+#include <stdint.h>
+}
+
+/******************************************************************************
+SECTIONS
+        Helper Functions
+        Sample Conversion
+        Fixed-Point vs. Floating-Point Pipeline
+        Detector Instances
+*******************************************************************************/
+
+/******************************************************************************
+Helper Functions
+*******************************************************************************/
+
+#define FS                  200                         // sampling frequency [Hz]
+#define BEAT_PERIOD         160                         // 75 [bpm] @ fs = 200 [Hz]
+#define NUM_BLOCKS          4                           // num. blocks of `QRS_NUM_SAMP` samples
+
+#define Q15_TO_MV(X)        (((float) (X)) * (DAQ_Q15_FULL_SCALE / 32768.0f))
+
+/**
+ * @brief   Generate a synthetic ECG sample as a 12-bit ADC value.
+ *
+ * @details The signal has a narrow QRS complex and a wider T wave every `BEAT_PERIOD` samples,
+ *          along with baseline wander and 60 [Hz] power line interference.
+ */
+static uint16_t syntheticEcg(uint32_t n) {
+    float t = (float) (n % BEAT_PERIOD);
+
+    float mV = 1.2f * expf(-0.5f * powf((t - 40.0f) / 2.5f, 2));                // QRS complex
+    mV += 0.3f * expf(-0.5f * powf((t - 100.0f) / 12.0f, 2));                   // T wave
+    mV += 0.2f * sinf(2 * PI * 0.3f * n / FS);                                  // baseline wander
+    mV += 0.05f * sinf(2 * PI * 60.0f * n / FS);                                // power line
+
+    int32_t sample = 2048 + (int32_t) lrintf(mV * (2048 / DAQ_LOOKUP_MAX));
+    return (uint16_t) ((sample < 0) ? 0 : ((sample > 0xFFF) ? 0xFFF : sample));
+}
+
+/// @brief  Signal-to-noise ratio [dB] of an approximation, using the difference as the noise.
+static double snr_dB(double signalEnergy, double errorEnergy) {
+    return 10 * log10(signalEnergy / errorEnergy);
+}
+
+/******************************************************************************
+Sample Conversion
+*******************************************************************************/
+
+TEST_GROUP(Group_FixedPoint_Conversion) {
+    void setup() {}
+    void teardown() {}
+};
+
+TEST(Group_FixedPoint_Conversion, ConvertToQ15_MatchesLookupTable) {
+    for(uint16_t sample = 0; sample <= 0xFFF; sample++) {
+        float expected = DAQ_convertToMilliVolts(sample);
+        float actual = Q15_TO_MV(DAQ_convertToQ15(sample));
+        DOUBLES_EQUAL(expected, actual, (DAQ_Q15_FULL_SCALE / 32768.0f) + 1e-5);
+    }
+}
+
+TEST(Group_FixedPoint_Conversion, ConvertToQ15_EndpointsAreFullScale) {
+    CHECK_EQUAL(-32768, DAQ_convertToQ15(0x000));
+    CHECK_EQUAL(32767, DAQ_convertToQ15(0xFFF));
+}
+
+/******************************************************************************
+Fixed-Point vs. Floating-Point Pipeline
+*******************************************************************************/
+
+/**
+ * @note    The DAQ filters and QRS detector keep their state between calls, so both versions are
+ *          always fed the same samples in the same order within a single test.
+ */
+TEST_GROUP(Group_FixedPoint_Pipeline) {
+    float32_t buffer_f32[QRS_NUM_SAMP];
+    q15_t buffer_q15[QRS_NUM_SAMP];
+
+    void setup() {}
+    void teardown() {}
+};
+
+TEST(Group_FixedPoint_Pipeline, FixedPointMatchesFloatingPoint) {
+    double notchEnergy = 0, notchError = 0;
+    double bandpassEnergy = 0, bandpassError = 0;
+    double qrsEnergy = 0, qrsError = 0;
+
+    // `q15_t` output of QRS_Preprocess_q15() relative to `float32_t` output of QRS_Preprocess()
+    const double qrsScale = (1 << QRS_Q15_SQUARE_GAIN_SHIFT) /
+                            (DAQ_Q15_FULL_SCALE * DAQ_Q15_FULL_SCALE) * 32768.0;
+
+    float32_t sum_f32 = 0;
+    int64_t sum_q15 = 0;
+    uint32_t N = 0;
+
+    float32_t heartRate_f32 = 0;
+    float32_t heartRate_q15 = 0;
+
+    for(uint8_t block = 0; block < NUM_BLOCKS; block++) {
+        for(uint16_t n = 0; n < QRS_NUM_SAMP; n++) {
+            uint16_t rawSample = syntheticEcg(N);
+            float32_t x_f32 = DAQ_convertToMilliVolts(rawSample);
+            q15_t x_q15 = DAQ_convertToQ15(rawSample);
+
+            // running mean subtraction, as in `main.c`
+            N += 1;
+            sum_f32 += x_f32;
+            sum_q15 += x_q15;
+            x_f32 -= sum_f32 / N;
+            x_q15 -= (q15_t) (sum_q15 / N);
+
+            x_f32 = DAQ_NotchFilter(x_f32);
+            x_q15 = DAQ_NotchFilter_q15(x_q15);
+            notchEnergy += x_f32 * x_f32;
+            notchError += pow(x_f32 - Q15_TO_MV(x_q15), 2);
+
+            float32_t y_f32 = DAQ_BandpassFilter(x_f32);
+            q15_t y_q15 = DAQ_BandpassFilter_q15(x_q15);
+            bandpassEnergy += y_f32 * y_f32;
+            bandpassError += pow(y_f32 - Q15_TO_MV(y_q15), 2);
+
+            buffer_f32[n] = x_f32;
+            buffer_q15[n] = x_q15;
+        }
+
+        QRS_Preprocess(buffer_f32, buffer_f32);
+        QRS_Preprocess_q15(buffer_q15, buffer_q15);
+        for(uint16_t n = 0; n < QRS_NUM_SAMP; n++) {
+            double expected = buffer_f32[n] * qrsScale;
+            qrsEnergy += expected * expected;
+            qrsError += pow(expected - buffer_q15[n], 2);
+        }
+
+        heartRate_f32 = QRS_applyDecisionRules(buffer_f32);
+        heartRate_q15 = QRS_applyDecisionRules_q15(buffer_q15);
+        if(block > 0) {               // first block includes calibration
+            DOUBLES_EQUAL(heartRate_f32, heartRate_q15, 0.5);
+        }
+    }
+
+    CHECK(snr_dB(notchEnergy, notchError) > 50);
+    CHECK(snr_dB(bandpassEnergy, bandpassError) > 50);
+    CHECK(snr_dB(qrsEnergy, qrsError) > 40);
+
+    DOUBLES_EQUAL(75, heartRate_q15, 1);
+}
+
+/******************************************************************************
+Detector Instances
+*******************************************************************************/
+
+/**
+ * @note    Detector `A` and detector `B` are fed different signals in an interleaved order, and
+ *          `A` must still give exactly the same output as detector `ref`, which runs alone.
+ */
+TEST_GROUP(Group_QRS_Detector) {
+    QrsDetectorStruct_t refStruct, aStruct, bStruct;
+    QrsDetector_t ref, A, B;
+
+    float32_t buffer_ref[QRS_NUM_SAMP];
+    float32_t buffer_A[QRS_NUM_SAMP];
+    float32_t buffer_B[QRS_NUM_SAMP];
+
+    void setup() {
+        ref = QRS_DetectorInit(&refStruct);
+        A = QRS_DetectorInit(&aStruct);
+        B = QRS_DetectorInit(&bStruct);
+    }
+    void teardown() {}
+};
+
+TEST(Group_QRS_Detector, BlockDetectorsAreIndependent) {
+    uint32_t N = 0;
+    for(uint8_t block = 0; block < NUM_BLOCKS; block++) {
+        for(uint16_t n = 0; n < QRS_NUM_SAMP; n++) {
+            buffer_ref[n] = DAQ_convertToMilliVolts(syntheticEcg(N));
+            buffer_A[n] = buffer_ref[n];
+            buffer_B[n] = DAQ_convertToMilliVolts(syntheticEcg(2 * N));               // 150 [bpm]
+            N += 1;
+        }
+
+        QRS_DetectorPreprocess(ref, buffer_ref, buffer_ref);
+        QRS_DetectorPreprocess(A, buffer_A, buffer_A);
+        QRS_DetectorPreprocess(B, buffer_B, buffer_B);
+        MEMCMP_EQUAL(buffer_ref, buffer_A, sizeof(buffer_ref));
+
+        float32_t heartRate_B = QRS_DetectorApplyDecisionRules(B, buffer_B);
+        float32_t heartRate_A = QRS_DetectorApplyDecisionRules(A, buffer_A);
+        float32_t heartRate_ref = QRS_DetectorApplyDecisionRules(ref, buffer_ref);
+        CHECK_EQUAL(heartRate_ref, heartRate_A);
+
+        if(block > 0) {               // first block includes calibration
+            DOUBLES_EQUAL(75, heartRate_A, 1);
+            DOUBLES_EQUAL(150, heartRate_B, 2);
+        }
+    }
+}
+
+TEST(Group_QRS_Detector, StreamingDetectorsAreIndependent) {
+    float32_t heartRate_ref = 0, heartRate_A = 0, heartRate_B = 0;
+    uint32_t numBeats = 0;
+
+    for(uint32_t N = 0; N < (NUM_BLOCKS * QRS_NUM_SAMP); N++) {
+        float32_t x = DAQ_convertToMilliVolts(syntheticEcg(N));
+
+        bool isBeat_A = QRS_DetectorProcessSample(A, x, &heartRate_A);
+        QRS_DetectorProcessSample(B, DAQ_convertToMilliVolts(syntheticEcg(2 * N)), &heartRate_B);
+        bool isBeat_ref = QRS_DetectorProcessSample(ref, x, &heartRate_ref);
+
+        CHECK_EQUAL(isBeat_ref, isBeat_A);
+        CHECK_EQUAL(heartRate_ref, heartRate_A);
+        numBeats += (isBeat_A) ? 1 : 0;
+    }
+
+    CHECK(numBeats > 0);
+    DOUBLES_EQUAL(75, heartRate_A, 1);
+    DOUBLES_EQUAL(150, heartRate_B, 2);
+}
+
+// NOLINTEND
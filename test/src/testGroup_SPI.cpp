@@ -0,0 +1,90 @@
+// clang-format off
+// NOLINTBEGIN
+
+#include "CppUTest/TestHarness.h"
+
+extern "C" {
+#include "SPI.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+}
+
+/******************************************************************************
+SECTIONS
+        Clock Divisor
+*******************************************************************************/
+
+/******************************************************************************
+Clock Divisor
+*******************************************************************************/
+
+#define F_BUS               80000000                    // bus frequency after PLL_Init() [Hz]
+#define F_RESET             16000000                    // bus frequency before PLL_Init() [Hz]
+
+TEST_GROUP(Group_SPI_BitRate) {
+    SpiClockDivisor_t divisor;
+
+    void setup() {
+        divisor = { 0xAA, 0xAA };
+    }
+    void teardown() {}
+
+    void checkDivisor(uint8_t prescale, uint8_t serialClockRate) {
+        CHECK_EQUAL(prescale, divisor.prescale);
+        CHECK_EQUAL(serialClockRate, divisor.serialClockRate);
+    }
+};
+
+TEST(Group_SPI_BitRate, Default_IsExact) {
+    // 80e6 / (2 * (1 + 3)) = 10e6; (4, 1) is just as fast, but the smaller `CPSDVSR` wins
+    CHECK_TRUE(SPI_calcClockDivisor(F_BUS, 10000000, &divisor));
+    checkDivisor(2, 3);
+    CHECK_EQUAL(10000000, SPI_calcBitRate(F_BUS, &divisor));
+
+    // 80e6 / (4 * (1 + 199)) = 100e3, since `SCR` can't go past 255 with `CPSDVSR` = 2
+    CHECK_TRUE(SPI_calcClockDivisor(F_BUS, 100000, &divisor));
+    checkDivisor(4, 199);
+}
+
+TEST(Group_SPI_BitRate, NotExact_RoundsDown) {
+    // 80e6 / 3e6 = 26.67, and `CPSDVSR * (1 + SCR)` is even, so 28 is the smallest divisor
+    CHECK_TRUE(SPI_calcClockDivisor(F_BUS, 3000000, &divisor));
+    checkDivisor(2, 13);
+    CHECK_EQUAL(2857142, SPI_calcBitRate(F_BUS, &divisor));
+
+    // fastest rate is half the bus frequency
+    CHECK_TRUE(SPI_calcClockDivisor(F_RESET, 10000000, &divisor));
+    checkDivisor(2, 0);
+    CHECK_EQUAL(8000000, SPI_calcBitRate(F_RESET, &divisor));
+
+    // 80e6 / 25e6 = 3.2 -> 4
+    CHECK_TRUE(SPI_calcClockDivisor(F_BUS, SPI_MAX_BIT_RATE, &divisor));
+    checkDivisor(2, 1);
+
+    // capped at the controller limit
+    CHECK_TRUE(SPI_calcClockDivisor(F_BUS, SPI_MAX_BIT_RATE + 1, &divisor));
+    checkDivisor(2, 1);
+    CHECK_TRUE(SPI_calcClockDivisor(F_BUS, 40000000, &divisor));
+    checkDivisor(2, 1);
+    CHECK_EQUAL(20000000, SPI_calcBitRate(F_BUS, &divisor));
+}
+
+TEST(Group_SPI_BitRate, ImpossibleRates_LeaveDivisorUnchanged) {
+    CHECK_FALSE(SPI_calcClockDivisor(F_BUS, 1230, &divisor));          // 80e6 / 65024 = 1230.3
+    CHECK_FALSE(SPI_calcClockDivisor(F_BUS, 0, &divisor));
+    checkDivisor(0xAA, 0xAA);
+
+    // slowest rate
+    CHECK_TRUE(SPI_calcClockDivisor(F_BUS, 1231, &divisor));
+    checkDivisor(254, 255);
+    CHECK_EQUAL(1230, SPI_calcBitRate(F_BUS, &divisor));
+}
+
+TEST(Group_SPI_BitRate, ActualRate_NeverAboveRequested) {
+    for(uint32_t bitRate = 1231; bitRate <= SPI_MAX_BIT_RATE; bitRate += 99991) {
+        CHECK_TRUE(SPI_calcClockDivisor(F_BUS, bitRate, &divisor));
+        CHECK(SPI_calcBitRate(F_BUS, &divisor) <= bitRate);
+        CHECK((divisor.prescale % 2) == 0);
+    }
+}
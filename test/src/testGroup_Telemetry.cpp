@@ -0,0 +1,238 @@
+// clang-format off
+// NOLINTBEGIN
+
+#include "CppUTest/TestHarness.h"
+
+extern "C" {
+#include "Telemetry.h"
+#include "UART.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+}
+
+/******************************************************************************
+SECTIONS
+        UART Fake
+        Framing
+        Sending
+*******************************************************************************/
+
+/******************************************************************************
+UART Fake
+*******************************************************************************/
+
+#define CAPTURE_SIZE        2048
+
+static uint8_t capturedBytes[CAPTURE_SIZE];
+static uint32_t numCapturedBytes = 0;
+static Uart_t fakeUart = reinterpret_cast<Uart_t>(capturedBytes);   // only compared to `0`
+
+extern "C" {
+bool UART_isInit(Uart_t /* uart */) {
+    return true;
+}
+
+void UART_WriteBytes(Uart_t /* uart */, const uint8_t bytes[], uint32_t N) {
+    memcpy(&capturedBytes[numCapturedBytes], bytes, N);
+    numCapturedBytes += N;
+}
+}
+
+/// @brief  Decode the `idx`th frame that was written to the fake UART.
+static bool getCapturedMsg(uint8_t idx, uint8_t msg[], uint16_t * msgSizePtr) {
+    uint32_t start = 0;
+    for(uint32_t byteIdx = 0; byteIdx < numCapturedBytes; byteIdx++) {
+        if(capturedBytes[byteIdx] != 0) {
+            continue;
+        }
+
+        if(byteIdx > start) {
+            if(idx == 0) {
+                uint16_t encodedSize = byteIdx - start;
+                return Telemetry_DecodeFrame(&capturedBytes[start], encodedSize, msg, msgSizePtr);
+            }
+            idx--;
+        }
+        start = byteIdx + 1;
+    }
+    return false;
+}
+
+static uint32_t readLittleEndian(const uint8_t bytes[], uint8_t N) {
+    uint32_t value = 0;
+    for(uint8_t idx = 0; idx < N; idx++) {
+        value |= (uint32_t) bytes[idx] << (8 * idx);
+    }
+    return value;
+}
+
+/******************************************************************************
+Framing
+*******************************************************************************/
+
+TEST_GROUP(Group_Telemetry_Framing) {
+    uint8_t msg[600];
+    uint8_t frame[TELEMETRY_FRAME_SIZE(600)];
+    uint8_t decoded[TELEMETRY_FRAME_SIZE(600)];
+    uint16_t decodedSize;
+
+    void setup() {}
+    void teardown() {}
+
+    /// @brief  Encode `msgSize` bytes of `msg`, then check the frame and decode it again.
+    void checkRoundTrip(uint16_t msgSize) {
+        uint16_t frameSize = Telemetry_EncodeFrame(msg, msgSize, frame);
+        CHECK(frameSize <= TELEMETRY_FRAME_SIZE(msgSize));
+
+        BYTES_EQUAL(0, frame[0]);
+        BYTES_EQUAL(0, frame[frameSize - 1]);
+        for(uint16_t idx = 1; idx < (frameSize - 1); idx++) {
+            CHECK(frame[idx] != 0);
+        }
+
+        CHECK_TRUE(Telemetry_DecodeFrame(&frame[1], frameSize - 2, decoded, &decodedSize));
+        CHECK_EQUAL(msgSize, decodedSize);
+        MEMCMP_EQUAL(msg, decoded, msgSize);
+    }
+};
+
+TEST(Group_Telemetry_Framing, Crc16_MatchesCheckValue) {
+    const uint8_t data[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    CHECK_EQUAL(0x29B1, Telemetry_Crc16(data, sizeof(data)));
+}
+
+TEST(Group_Telemetry_Framing, EncodeFrame_RoundTripWithZeros) {
+    for(uint16_t idx = 0; idx < 40; idx++) {
+        msg[idx] = (idx % 3 == 0) ? 0 : (uint8_t) idx;
+    }
+    checkRoundTrip(40);
+
+    memset(msg, 0, 10);
+    checkRoundTrip(10);
+}
+
+TEST(Group_Telemetry_Framing, EncodeFrame_RoundTripLongerThanBlock) {
+    for(uint16_t idx = 0; idx < 600; idx++) {
+        msg[idx] = (uint8_t) ((idx % 255) + 1);           // no zeros, so the blocks are full
+    }
+    checkRoundTrip(254);
+    checkRoundTrip(255);
+    checkRoundTrip(600);
+}
+
+TEST(Group_Telemetry_Framing, DecodeFrame_RejectsCorruption) {
+    for(uint16_t idx = 0; idx < 20; idx++) {
+        msg[idx] = (uint8_t) idx;
+    }
+    uint16_t frameSize = Telemetry_EncodeFrame(msg, 20, frame);
+
+    for(uint16_t idx = 1; idx < (frameSize - 1); idx++) {
+        frame[idx] ^= 0x10;
+        CHECK_FALSE(Telemetry_DecodeFrame(&frame[1], frameSize - 2, decoded, &decodedSize));
+        frame[idx] ^= 0x10;
+    }
+
+    // cut short
+    CHECK_FALSE(Telemetry_DecodeFrame(&frame[1], frameSize - 3, decoded, &decodedSize));
+    CHECK_FALSE(Telemetry_DecodeFrame(&frame[1], 2, decoded, &decodedSize));
+}
+
+/******************************************************************************
+Sending
+*******************************************************************************/
+
+TEST_GROUP(Group_Telemetry_Sending) {
+    uint8_t msg[TELEMETRY_FRAME_SIZE(TELEMETRY_MAX_MSG_SIZE)];
+    uint16_t msgSize;
+
+    void setup() {
+        numCapturedBytes = 0;
+        Telemetry_Init(fakeUart);
+    }
+    void teardown() {}
+};
+
+TEST(Group_Telemetry_Sending, AddRawSample_SendsFullMessage) {
+    for(uint32_t n = 0; n < (TELEMETRY_SAMPLES_PER_MSG - 1); n++) {
+        Telemetry_AddRawSample(100 + n, (uint16_t) (0x800 + n));
+    }
+    CHECK_EQUAL(0, numCapturedBytes);
+
+    Telemetry_AddRawSample(100 + TELEMETRY_SAMPLES_PER_MSG - 1, 0x000);
+    CHECK_TRUE(getCapturedMsg(0, msg, &msgSize));
+    uint16_t expectedSize = TELEMETRY_HEADER_SIZE + TELEMETRY_SAMPLE_HEADER_SIZE +
+                            (sizeof(uint16_t) * TELEMETRY_SAMPLES_PER_MSG);
+    CHECK_EQUAL(expectedSize, msgSize);
+
+    BYTES_EQUAL(TELEMETRY_MSG_RAW, msg[0]);
+    CHECK_EQUAL(0, readLittleEndian(&msg[1], 2));
+    CHECK_EQUAL(100, readLittleEndian(&msg[3], 4));
+    BYTES_EQUAL(TELEMETRY_SAMPLES_PER_MSG, msg[7]);
+    CHECK_EQUAL(0x800, readLittleEndian(&msg[8], 2));
+    CHECK_EQUAL(0x000, readLittleEndian(&msg[8 + (2 * (TELEMETRY_SAMPLES_PER_MSG - 1))], 2));
+}
+
+TEST(Group_Telemetry_Sending, AddSample_GapSendsPartialMessage) {
+    Telemetry_AddSample(TELEMETRY_MSG_FILTERED, 10, 1.5f);
+    Telemetry_AddSample(TELEMETRY_MSG_FILTERED, 11, -0.25f);
+    Telemetry_AddSample(TELEMETRY_MSG_FILTERED, 20, 0.0f);    // not consecutive
+
+    CHECK_TRUE(getCapturedMsg(0, msg, &msgSize));
+    uint16_t expectedSize = TELEMETRY_HEADER_SIZE + TELEMETRY_SAMPLE_HEADER_SIZE +
+                            (2 * sizeof(float));
+    CHECK_EQUAL(expectedSize, msgSize);
+    BYTES_EQUAL(TELEMETRY_MSG_FILTERED, msg[0]);
+    CHECK_EQUAL(10, readLittleEndian(&msg[3], 4));
+    BYTES_EQUAL(2, msg[7]);
+
+    float value;
+    memcpy(&value, &msg[12], sizeof(value));
+    DOUBLES_EQUAL(-0.25, value, 0);
+
+    CHECK_FALSE(getCapturedMsg(1, msg, &msgSize));
+}
+
+TEST(Group_Telemetry_Sending, SeqNums_CountedPerType) {
+    Telemetry_SendBeat(500);
+    Telemetry_SendHeartRate(510, 72.5f);
+    Telemetry_SendBeat(660);
+
+    CHECK_TRUE(getCapturedMsg(0, msg, &msgSize));
+    BYTES_EQUAL(TELEMETRY_MSG_BEAT, msg[0]);
+    CHECK_EQUAL(0, readLittleEndian(&msg[1], 2));
+    CHECK_EQUAL(500, readLittleEndian(&msg[3], 4));
+
+    CHECK_TRUE(getCapturedMsg(1, msg, &msgSize));
+    BYTES_EQUAL(TELEMETRY_MSG_HEART_RATE, msg[0]);
+    CHECK_EQUAL(0, readLittleEndian(&msg[1], 2));
+    CHECK_EQUAL(510, readLittleEndian(&msg[3], 4));
+
+    CHECK_TRUE(getCapturedMsg(2, msg, &msgSize));
+    BYTES_EQUAL(TELEMETRY_MSG_BEAT, msg[0]);
+    CHECK_EQUAL(1, readLittleEndian(&msg[1], 2));
+    CHECK_EQUAL(660, readLittleEndian(&msg[3], 4));
+}
+
+TEST(Group_Telemetry_Sending, SendLog_SendsShortFrameWithoutCrc) {
+    const uint8_t args[] = { 3, 'Q', 'R', 'S', 0x00, 0x01 };
+    Telemetry_SendLog(5, args, sizeof(args));
+
+    // 2 zeros, 2 COBS codes (one replaces the zero in `args`), ID, other arguments
+    CHECK_EQUAL(2 + 2 + 1 + (sizeof(args) - 1), numCapturedBytes);
+
+    CHECK_TRUE(getCapturedMsg(0, msg, &msgSize));
+    CHECK_EQUAL(1 + sizeof(args), msgSize);
+    BYTES_EQUAL(TELEMETRY_LOG_FLAG | 5, msg[0]);
+    MEMCMP_EQUAL(args, &msg[1], sizeof(args));
+}
+
+TEST(Group_Telemetry_Sending, SendLog_NoArguments) {
+    Telemetry_SendLog(0, NULL, 0);
+    CHECK_EQUAL(4, numCapturedBytes);
+
+    CHECK_TRUE(getCapturedMsg(0, msg, &msgSize));
+    CHECK_EQUAL(1, msgSize);
+    BYTES_EQUAL(TELEMETRY_LOG_FLAG, msg[0]);
+}
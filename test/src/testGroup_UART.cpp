@@ -0,0 +1,113 @@
+// clang-format off
+// NOLINTBEGIN
+
+#include "CppUTest/TestHarness.h"
+
+extern "C" {
+#include "UART.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+}
+
+/******************************************************************************
+SECTIONS
+        Baud Rate Divisor
+*******************************************************************************/
+
+/******************************************************************************
+Baud Rate Divisor
+*******************************************************************************/
+
+#define F_BUS               80000000                    // bus frequency after PLL_Init() [Hz]
+#define F_RESET             16000000                    // bus frequency before PLL_Init() [Hz]
+
+TEST_GROUP(Group_UART_BaudRate) {
+    UartBaudDivisor_t divisor;
+
+    void setup() {
+        divisor = { 0xAAAA, 0xAA, true };
+    }
+    void teardown() {}
+
+    void checkDivisor(uint16_t integer, uint8_t fraction, bool isHighSpeed) {
+        CHECK_EQUAL(integer, divisor.integer);
+        CHECK_EQUAL(fraction, divisor.fraction);
+        CHECK_EQUAL(isHighSpeed, divisor.isHighSpeed);
+    }
+};
+
+TEST(Group_UART_BaudRate, Default_MatchesDatasheetValues) {
+    // BRD = 80e6 / (16 * 115200) = 43.4028 -> IBRD = 43, FBRD = int(0.4028 * 64 + 0.5) = 26
+    CHECK_TRUE(UART_calcBaudDivisor(F_BUS, 115200, &divisor));
+    checkDivisor(43, 26, false);
+}
+
+TEST(Group_UART_BaudRate, OtherBusFrequency) {
+    // BRD = 16e6 / (16 * 115200) = 8.6806 -> FBRD = int(0.6806 * 64 + 0.5) = 44
+    CHECK_TRUE(UART_calcBaudDivisor(F_RESET, 115200, &divisor));
+    checkDivisor(8, 44, false);
+
+    // BRD = 80e6 / (16 * 9600) = 520.8333 -> FBRD = int(0.8333 * 64 + 0.5) = 53
+    CHECK_TRUE(UART_calcBaudDivisor(F_BUS, 9600, &divisor));
+    checkDivisor(520, 53, false);
+}
+
+TEST(Group_UART_BaudRate, FractionRoundsUpToNextInteger) {
+    // BRD = 80e6 / (16 * 50005) = 99.9900 -> FBRD = int(0.9900 * 64 + 0.5) = 63
+    CHECK_TRUE(UART_calcBaudDivisor(F_BUS, 50005, &divisor));
+    checkDivisor(99, 63, false);
+
+    // BRD = 80e6 / (16 * 50002) = 99.9960 -> FBRD would be 64, so IBRD is rounded up instead
+    CHECK_TRUE(UART_calcBaudDivisor(F_BUS, 50002, &divisor));
+    checkDivisor(100, 0, false);
+}
+
+TEST(Group_UART_BaudRate, MultiMegabaud) {
+    CHECK_TRUE(UART_calcBaudDivisor(F_BUS, 1000000, &divisor));
+    checkDivisor(5, 0, false);
+
+    // fastest rate with ClkDiv = 16
+    CHECK_TRUE(UART_calcBaudDivisor(F_BUS, 5000000, &divisor));
+    checkDivisor(1, 0, false);
+
+    // BRD = 80e6 / (8 * 6e6) = 1.6667 -> FBRD = int(0.6667 * 64 + 0.5) = 43
+    CHECK_TRUE(UART_calcBaudDivisor(F_BUS, 6000000, &divisor));
+    checkDivisor(1, 43, true);
+
+    // fastest rate with ClkDiv = 8
+    CHECK_TRUE(UART_calcBaudDivisor(F_BUS, 10000000, &divisor));
+    checkDivisor(1, 0, true);
+}
+
+TEST(Group_UART_BaudRate, ImpossibleRates_LeaveDivisorUnchanged) {
+    CHECK_FALSE(UART_calcBaudDivisor(F_BUS, 11000000, &divisor));       // too fast
+    CHECK_FALSE(UART_calcBaudDivisor(F_BUS, 76, &divisor));             // BRD = 65789.47
+    CHECK_FALSE(UART_calcBaudDivisor(F_BUS, 0, &divisor));
+    checkDivisor(0xAAAA, 0xAA, true);
+
+    // slowest rate: BRD = 80e6 / (16 * 77) = 64935.06
+    CHECK_TRUE(UART_calcBaudDivisor(F_BUS, 77, &divisor));
+    checkDivisor(64935, 4, false);
+}
+
+TEST(Group_UART_BaudRate, ActualRate_WithinTolerance) {
+    const uint32_t BAUD_RATES[] = { 9600,   19200,  38400,   57600,   115200,  230400,
+                                    460800, 921600, 1000000, 2000000, 3000000, 4000000 };
+
+    for(uint8_t idx = 0; idx < (sizeof(BAUD_RATES) / sizeof(BAUD_RATES[0])); idx++) {
+        CHECK_TRUE(UART_calcBaudDivisor(F_BUS, BAUD_RATES[idx], &divisor));
+
+        // both ends of the link can each be off by ~2%, so stay well within that
+        double actual = UART_calcBaudRate(F_BUS, &divisor);
+        DOUBLES_EQUAL(1.0, actual / BAUD_RATES[idx], 0.005);
+    }
+}
+
+TEST(Group_UART_BaudRate, ActualRate_ExactDivisors) {
+    divisor = { 43, 26, false };
+    CHECK_EQUAL(115190, UART_calcBaudRate(F_BUS, &divisor));               // 80e6 / (16 * 43.40625)
+
+    divisor = { 1, 0, true };
+    CHECK_EQUAL(10000000, UART_calcBaudRate(F_BUS, &divisor));
+}
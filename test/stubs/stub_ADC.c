@@ -0,0 +1,31 @@
+/**
+ * @file
+ * @author  Bryan McElvy
+ * @brief   Stub functions for ADC module.
+ */
+
+// NOLINTBEGIN
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ADC.h"
+
+void ADC_Init(void) {
+    return;
+}
+
+uint16_t ADC_readSample(void) {
+    return 0;
+}
+
+void ADC_acknowledgeInterrupt(void) {
+    return;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+// NOLINTEND
@@ -0,0 +1,66 @@
+/**
+ * @file
+ * @author  Bryan McElvy
+ * @brief   Stub functions for Timer module.
+ */
+
+// NOLINTBEGIN
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "Timer.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/******************************************************************************
+Initialization
+*******************************************************************************/
+
+Timer_t Timer_Init(timerName_t timerName) {
+    return 0;
+}
+
+void Timer_Deinit(Timer_t timer) {
+    return;
+}
+
+/******************************************************************************
+Configuration
+*******************************************************************************/
+
+void Timer_setMode(Timer_t timer, timerMode_t timerMode, timerDirection_t timerDirection) {
+    return;
+}
+
+void Timer_enableAdcTrigger(Timer_t timer) {
+    return;
+}
+
+void Timer_setInterval_ms(Timer_t timer, uint32_t time_ms) {
+    return;
+}
+
+/******************************************************************************
+Basic Operations
+*******************************************************************************/
+
+void Timer_Start(Timer_t timer) {
+    return;
+}
+
+void Timer_Stop(Timer_t timer) {
+    return;
+}
+
+bool Timer_isCounting(Timer_t timer) {
+    return false;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+// NOLINTEND
@@ -0,0 +1,42 @@
+/**
+ * @file
+ * @author  Bryan McElvy
+ * @brief   Stub functions for UART module.
+ */
+
+// NOLINTBEGIN
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "UART.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/******************************************************************************
+Initialization
+*******************************************************************************/
+
+Uart_t UART_Init(GpioPort_t port, uartNum_t uartNum) {
+    return 0;
+}
+
+bool UART_isInit(Uart_t uart) {
+    return true;
+}
+
+/******************************************************************************
+Writing
+*******************************************************************************/
+
+void UART_WriteBytes(Uart_t uart, const uint8_t bytes[], uint32_t N) {
+    return;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+// NOLINTEND
@@ -0,0 +1,293 @@
+/**
+ * @file
+ * @author  Bryan McElvy
+ * @brief   Host microbenchmark that compares @ref Fifo_t with the lock-free @ref RingFifo_t.
+ *
+ * @details Each case moves the same values through both FIFO types using the access pattern of
+ *          one of the FIFOs in the firmware, and reports the average time per value.
+ *
+ *          - `isr chain`: 1 value in, 1 value out (e.g. `DAQ_Fifo` in `main.c`).
+ *          - `cmd params`: 4 values in, then 4 values out (e.g. `ILI9341_Fifo`).
+ *          - `bulk`: 1024 values in, then all of them out at once.
+ *          - `fan-out x2`: 1 value in, then 1 value out for each of 2 consumers (e.g. the
+ *            processed samples in `main.c`). The `Fifo` column uses one @ref Fifo_t per consumer,
+ *            and the `Ring` column uses one @ref BroadcastFifo_t with a reader per consumer.
+ *
+ *          The results are only meant for comparing the two implementations on the same machine;
+ *          the relative difference on the TM4C123 will be larger, since `%` needs a hardware
+ *          divide there.
+ *
+ *          Usage: `bench_fifo [num. values per case]`
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+/******************************************************************************
+SECTIONS
+        Declarations
+        Main Function
+        Benchmark Cases
+*******************************************************************************/
+
+#include "Fifo.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define DEFAULT_NUM_VALS   (1UL << 26)
+#define BULK_LEN           1024
+
+/******************************************************************************
+Declarations
+*******************************************************************************/
+
+typedef double (*BenchFunc_t)(uint32_t numVals, uint32_t * checksumPtr);
+
+/// @brief  One access pattern, run once with each FIFO type.
+typedef struct {
+    const char * name;
+    BenchFunc_t runFifo;
+    BenchFunc_t runRing;
+} BenchCase_t;
+
+static double benchIsrChain_Fifo(uint32_t numVals, uint32_t * checksumPtr);
+static double benchIsrChain_Ring(uint32_t numVals, uint32_t * checksumPtr);
+static double benchCmdParams_Fifo(uint32_t numVals, uint32_t * checksumPtr);
+static double benchCmdParams_Ring(uint32_t numVals, uint32_t * checksumPtr);
+static double benchBulk_Fifo(uint32_t numVals, uint32_t * checksumPtr);
+static double benchBulk_Ring(uint32_t numVals, uint32_t * checksumPtr);
+static double benchFanOut_Fifo(uint32_t numVals, uint32_t * checksumPtr);
+static double benchFanOut_Ring(uint32_t numVals, uint32_t * checksumPtr);
+
+static double getTime_sec(void);
+
+/******************************************************************************
+Main Function
+*******************************************************************************/
+
+int main(int argc, char ** argv) {
+    const BenchCase_t cases[] = {
+        { "isr chain", benchIsrChain_Fifo, benchIsrChain_Ring },
+        { "cmd params", benchCmdParams_Fifo, benchCmdParams_Ring },
+        { "bulk", benchBulk_Fifo, benchBulk_Ring },
+        { "fan-out x2", benchFanOut_Fifo, benchFanOut_Ring },
+    };
+
+    uint32_t numVals = (argc > 1) ? (uint32_t) strtoul(argv[1], NULL, 10) : DEFAULT_NUM_VALS;
+    numVals -= numVals % BULK_LEN;               // every case moves a whole number of blocks
+    if(numVals == 0) {
+        fprintf(stderr, "Number of values must be at least %d.\n", BULK_LEN);
+        return EXIT_FAILURE;
+    }
+
+    printf("%-12s %14s %14s %9s\n", "Case", "Fifo [ns/val]", "Ring [ns/val]", "Speedup");
+    printf("--------------------------------------------------------\n");
+
+    int exitCode = EXIT_SUCCESS;
+    for(uint8_t idx = 0; idx < (sizeof(cases) / sizeof(cases[0])); idx++) {
+        uint32_t checksumFifo = 0;
+        uint32_t checksumRing = 0;
+
+        double time_Fifo = cases[idx].runFifo(numVals, &checksumFifo);
+        double time_Ring = cases[idx].runRing(numVals, &checksumRing);
+
+        printf("%-12s %14.2f %14.2f %8.2fx\n", cases[idx].name, (time_Fifo * 1e9) / numVals,
+               (time_Ring * 1e9) / numVals, time_Fifo / time_Ring);
+
+        // both FIFOs must have output the same values
+        if(checksumFifo != checksumRing) {
+            fprintf(stderr, "Checksum mismatch in case \"%s\".\n", cases[idx].name);
+            exitCode = EXIT_FAILURE;
+        }
+    }
+
+    return exitCode;
+}
+
+/******************************************************************************
+Benchmark Cases
+*******************************************************************************/
+
+static double benchIsrChain_Fifo(uint32_t numVals, uint32_t * checksumPtr) {
+    static volatile uint32_t buffer[4];
+    Fifo_t fifo = Fifo_Init(buffer, 4);
+    uint32_t checksum = 0;
+
+    double startTime = getTime_sec();
+    for(uint32_t n = 0; n < numVals; n++) {
+        Fifo_Put(fifo, n);
+        checksum += Fifo_Get(fifo);
+    }
+    double time_sec = getTime_sec() - startTime;
+
+    *checksumPtr = checksum;
+    return time_sec;
+}
+
+static double benchIsrChain_Ring(uint32_t numVals, uint32_t * checksumPtr) {
+    static uint32_t buffer[4];
+    RingFifo_t ring = RingFifo_Init(buffer, 4);
+    uint32_t checksum = 0;
+
+    double startTime = getTime_sec();
+    for(uint32_t n = 0; n < numVals; n++) {
+        uint32_t val;
+        RingFifo_Put(ring, n);
+        RingFifo_Get(ring, &val);
+        checksum += val;
+    }
+    double time_sec = getTime_sec() - startTime;
+
+    *checksumPtr = checksum;
+    return time_sec;
+}
+
+static double benchCmdParams_Fifo(uint32_t numVals, uint32_t * checksumPtr) {
+    static volatile uint32_t buffer[8];
+    Fifo_t fifo = Fifo_Init(buffer, 8);
+    uint32_t checksum = 0;
+
+    double startTime = getTime_sec();
+    for(uint32_t n = 0; n < numVals; n += 4) {
+        Fifo_Put(fifo, n);
+        Fifo_Put(fifo, n + 1);
+        Fifo_Put(fifo, n + 2);
+        Fifo_Put(fifo, n + 3);
+
+        uint32_t numParams = Fifo_getCurrSize(fifo);
+        while(numParams > 0) {
+            checksum += Fifo_Get(fifo);
+            numParams -= 1;
+        }
+    }
+    double time_sec = getTime_sec() - startTime;
+
+    *checksumPtr = checksum;
+    return time_sec;
+}
+
+static double benchCmdParams_Ring(uint32_t numVals, uint32_t * checksumPtr) {
+    static uint32_t buffer[8];
+    RingFifo_t ring = RingFifo_Init(buffer, 8);
+    uint32_t checksum = 0;
+
+    double startTime = getTime_sec();
+    for(uint32_t n = 0; n < numVals; n += 4) {
+        const uint32_t params[4] = { n, n + 1, n + 2, n + 3 };
+        RingFifo_PutBlock(ring, params, 4);
+
+        uint32_t output[8];
+        uint32_t numParams = RingFifo_GetBlock(ring, output, 8);
+        for(uint32_t idx = 0; idx < numParams; idx++) {
+            checksum += output[idx];
+        }
+    }
+    double time_sec = getTime_sec() - startTime;
+
+    *checksumPtr = checksum;
+    return time_sec;
+}
+
+static double benchBulk_Fifo(uint32_t numVals, uint32_t * checksumPtr) {
+    static volatile uint32_t buffer[BULK_LEN + 1];
+    static uint32_t input[BULK_LEN];
+    static uint32_t output[BULK_LEN];
+    Fifo_t fifo = Fifo_Init(buffer, BULK_LEN + 1);
+    uint32_t checksum = 0;
+
+    double startTime = getTime_sec();
+    for(uint32_t n = 0; n < numVals; n += BULK_LEN) {
+        for(uint32_t idx = 0; idx < BULK_LEN; idx++) {
+            input[idx] = n + idx;
+        }
+
+        for(uint32_t idx = 0; idx < BULK_LEN; idx++) {
+            Fifo_Put(fifo, input[idx]);
+        }
+        Fifo_Flush(fifo, output);
+
+        for(uint32_t idx = 0; idx < BULK_LEN; idx++) {
+            checksum += output[idx];
+        }
+    }
+    double time_sec = getTime_sec() - startTime;
+
+    *checksumPtr = checksum;
+    return time_sec;
+}
+
+static double benchBulk_Ring(uint32_t numVals, uint32_t * checksumPtr) {
+    static uint32_t buffer[BULK_LEN];
+    static uint32_t input[BULK_LEN];
+    static uint32_t output[BULK_LEN];
+    RingFifo_t ring = RingFifo_Init(buffer, BULK_LEN);
+    uint32_t checksum = 0;
+
+    double startTime = getTime_sec();
+    for(uint32_t n = 0; n < numVals; n += BULK_LEN) {
+        for(uint32_t idx = 0; idx < BULK_LEN; idx++) {
+            input[idx] = n + idx;
+        }
+
+        RingFifo_PutBlock(ring, input, BULK_LEN);
+        RingFifo_GetBlock(ring, output, BULK_LEN);
+
+        for(uint32_t idx = 0; idx < BULK_LEN; idx++) {
+            checksum += output[idx];
+        }
+    }
+    double time_sec = getTime_sec() - startTime;
+
+    *checksumPtr = checksum;
+    return time_sec;
+}
+
+static double benchFanOut_Fifo(uint32_t numVals, uint32_t * checksumPtr) {
+    static volatile uint32_t bufferA[4];
+    static volatile uint32_t bufferB[4];
+    Fifo_t fifoA = Fifo_Init(bufferA, 4);
+    Fifo_t fifoB = Fifo_Init(bufferB, 4);
+    uint32_t checksum = 0;
+
+    double startTime = getTime_sec();
+    for(uint32_t n = 0; n < numVals; n++) {
+        Fifo_Put(fifoA, n);
+        Fifo_Put(fifoB, n);
+        checksum += Fifo_Get(fifoA);
+        checksum += Fifo_Get(fifoB);
+    }
+    double time_sec = getTime_sec() - startTime;
+
+    *checksumPtr = checksum;
+    return time_sec;
+}
+
+static double benchFanOut_Ring(uint32_t numVals, uint32_t * checksumPtr) {
+    static uint32_t buffer[4];
+    BroadcastFifo_t fifo = BroadcastFifo_Init(buffer, 4, sizeof(uint32_t));
+    BroadcastReader_t readerA = BroadcastFifo_AddReader(fifo);
+    BroadcastReader_t readerB = BroadcastFifo_AddReader(fifo);
+    uint32_t checksum = 0;
+
+    double startTime = getTime_sec();
+    for(uint32_t n = 0; n < numVals; n++) {
+        uint32_t val;
+        BroadcastFifo_Put(fifo, &n);
+        BroadcastFifo_Get(readerA, &val);
+        checksum += val;
+        BroadcastFifo_Get(readerB, &val);
+        checksum += val;
+    }
+    double time_sec = getTime_sec() - startTime;
+
+    *checksumPtr = checksum;
+    return time_sec;
+}
+
+static double getTime_sec(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double) now.tv_sec + ((double) now.tv_nsec * 1e-9);
+}
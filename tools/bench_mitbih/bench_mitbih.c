@@ -0,0 +1,579 @@
+/**
+ * @file
+ * @author  Bryan McElvy
+ * @brief   Host benchmark that replays MIT-BIH Arrhythmia Database records through the DAQ and
+ *          QRS modules, and reports both throughput and beat detection accuracy.
+ *
+ * @details Each record's first signal is read from its `.dat` file (format 212), resampled from
+ *          the record's sampling rate to @ref QRS_SAMP_FREQ, and quantized to 12-bit ADC values.
+ *          The samples then go through the same steps as in the bare-metal `main.c`: conversion
+ *          via DAQ_convertToMilliVolts(), running mean subtraction, DAQ_NotchFilter(), and QRS
+ *          detection in blocks of @ref QRS_NUM_SAMP samples.
+ *
+ *          If the record's `.atr` file is present, the detected beats are matched against the
+ *          reference beat annotations using a 150 [ms] window to calculate the sensitivity (Se)
+ *          and positive predictivity (+P). Otherwise, only the timing results are reported.
+ *          Every record starts from freshly reset filters and a new detector, so the results don't
+ *          depend on which records were replayed before it.
+ *
+ *          Usage: `bench_mitbih [record ...]`, where each record is a path without an extension
+ *          (e.g. `tools/data/mit-bih-arr/101`). If no records are given, every `.hea` file in
+ *          `BENCH_DATA_DIR` is used.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+/******************************************************************************
+SECTIONS
+        Declarations
+        Main Function
+        Record Loading
+        Replay
+        Scoring
+*******************************************************************************/
+
+#include "DAQ.h"
+#include "QRS.h"
+
+#include "arm_math_types.h"
+
+#include <dirent.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef BENCH_DATA_DIR
+#define BENCH_DATA_DIR "tools/data/mit-bih-arr"
+#endif
+
+#define MATCH_WINDOW_SEC   0.150                        ///< max. distance between matched beats
+
+/**
+ * @brief   Delay of a beat in the preprocessed signal y[n] relative to its R peak, in [samples].
+ *
+ * @details This is the sum of each stage's group delay: about 13.5 samples for the bandpass
+ *          filter over the QRS complex's main band (10-15 [Hz]), 2 for the derivative filter, and
+ *          4.5 for the moving average filter. The notch filter's delay is negligible there.
+ */
+#define PIPELINE_DELAY     20
+#define ADC_MAX            0xFFF
+
+/******************************************************************************
+Declarations
+*******************************************************************************/
+
+/// @brief  Signal and annotations of one record, resampled to @ref QRS_SAMP_FREQ.
+typedef struct {
+    char name[64];
+
+    uint16_t * adcSamples;                              ///< 12-bit ADC values
+    uint32_t numSamples;
+
+    uint32_t * refBeats;                                ///< sample nums. of reference beats
+    uint32_t numRefBeats;
+    bool hasAnnotations;
+} Record_t;
+
+/// @brief  Results of replaying one record.
+typedef struct {
+    uint32_t * detBeats;                                ///< sample nums. of detected beats in y[n]
+    uint32_t numDetBeats;
+
+    double * blockLatencies_us;                         ///< time to run QRS detection on a block
+    uint32_t numBlocks;
+    double totalTime_sec;                               ///< time for the entire pipeline
+} Replay_t;
+
+/// @brief  Beat-by-beat comparison of the detected and reference beats.
+typedef struct {
+    uint32_t truePos;
+    uint32_t falseNeg;
+    uint32_t falsePos;
+} Score_t;
+
+static bool loadRecord(const char * path, Record_t * record);
+static bool readSignal(const char * path, Record_t * record);
+static bool readAnnotations(const char * path, uint32_t fs, Record_t * record);
+static bool isBeatCode(uint16_t code);
+static void freeRecord(Record_t * record);
+
+static void replayRecord(const Record_t * record, Replay_t * replay);
+static double getTime_sec(void);
+
+static Score_t scoreRecord(const Record_t * record, const Replay_t * replay);
+static int compareDoubles(const void * a, const void * b);
+static int compareStrings(const void * a, const void * b);
+
+static void printHeader(void);
+static void printResults(const char * name, uint32_t numSamples, double time_sec,
+                         double * latencies, uint32_t numBlocks, const Score_t * score);
+
+/******************************************************************************
+Main Function
+*******************************************************************************/
+
+int main(int argc, char ** argv) {
+    // collect record paths
+    uint32_t numPaths = 0;
+    char ** paths = malloc(sizeof(char *) * ((argc > 1) ? (uint32_t) argc : 256));
+    if(argc > 1) {
+        for(int idx = 1; idx < argc; idx++) {
+            paths[numPaths++] = strdup(argv[idx]);
+        }
+    }
+    else {
+        DIR * dir = opendir(BENCH_DATA_DIR);
+        if(dir == NULL) {
+            fprintf(stderr, "Could not open %s\n", BENCH_DATA_DIR);
+            return EXIT_FAILURE;
+        }
+
+        struct dirent * entry;
+        while(((entry = readdir(dir)) != NULL) && (numPaths < 256)) {
+            size_t len = strlen(entry->d_name);
+            if((len > 4) && (strcmp(&entry->d_name[len - 4], ".hea") == 0)) {
+                char * path = malloc(sizeof(BENCH_DATA_DIR) + len + 1);
+                sprintf(path, "%s/%.*s", BENCH_DATA_DIR, (int) (len - 4), entry->d_name);
+                paths[numPaths++] = path;
+            }
+        }
+        closedir(dir);
+
+        qsort(paths, numPaths, sizeof(char *), compareStrings);
+    }
+
+    if(numPaths == 0) {
+        fprintf(stderr, "No records found.\n");
+        return EXIT_FAILURE;
+    }
+
+    // replay each record, and keep the totals
+    uint32_t totalSamples = 0;
+    double totalTime_sec = 0;
+    double * allLatencies = NULL;
+    uint32_t totalBlocks = 0;
+    Score_t totalScore = { 0 };
+    bool hasAnyAnnotations = false;
+
+    printHeader();
+    for(uint32_t idx = 0; idx < numPaths; idx++) {
+        Record_t record = { 0 };
+        if(loadRecord(paths[idx], &record) == false) {
+            fprintf(stderr, "Skipping %s\n", paths[idx]);
+            continue;
+        }
+
+        Replay_t replay = { 0 };
+        replayRecord(&record, &replay);
+
+        Score_t score = { 0 };
+        if(record.hasAnnotations) {
+            score = scoreRecord(&record, &replay);
+            totalScore.truePos += score.truePos;
+            totalScore.falseNeg += score.falseNeg;
+            totalScore.falsePos += score.falsePos;
+            hasAnyAnnotations = true;
+        }
+
+        allLatencies = realloc(allLatencies, sizeof(double) * (totalBlocks + replay.numBlocks));
+        memcpy(&allLatencies[totalBlocks], replay.blockLatencies_us,
+               sizeof(double) * replay.numBlocks);
+        totalBlocks += replay.numBlocks;
+        totalSamples += record.numSamples;
+        totalTime_sec += replay.totalTime_sec;
+
+        printResults(record.name, record.numSamples, replay.totalTime_sec,
+                     replay.blockLatencies_us, replay.numBlocks,
+                     (record.hasAnnotations) ? &score : NULL);
+
+        free(replay.detBeats);
+        free(replay.blockLatencies_us);
+        freeRecord(&record);
+    }
+
+    printf("\n");
+    printResults("total", totalSamples, totalTime_sec, allLatencies, totalBlocks,
+                 (hasAnyAnnotations) ? &totalScore : NULL);
+
+    for(uint32_t idx = 0; idx < numPaths; idx++) {
+        free(paths[idx]);
+    }
+    free(paths);
+    free(allLatencies);
+
+    return EXIT_SUCCESS;
+}
+
+/******************************************************************************
+Record Loading
+*******************************************************************************/
+
+static bool loadRecord(const char * path, Record_t * record) {
+    const char * name = strrchr(path, '/');
+    snprintf(record->name, sizeof(record->name), "%s", (name != NULL) ? &name[1] : path);
+
+    return readSignal(path, record);
+}
+
+static bool readSignal(const char * path, Record_t * record) {
+    /**
+     * The header's first line is `<name> <num. signals> <fs> <num. samples>`, and the next line
+     * describes the first signal as `<file> <format> <gain>[(<baseline>)][/mV] <bits> <ADC zero>`.
+     * Format 212 packs pairs of 12-bit samples (from consecutive signals) into 3 bytes.
+     */
+    char fileName[512];
+    snprintf(fileName, sizeof(fileName), "%s.hea", path);
+    FILE * file = fopen(fileName, "r");
+    if(file == NULL) {
+        return false;
+    }
+
+    char line[256];
+    uint32_t numSignals = 0, fs = 0, numFrames = 0;
+    char datName[128] = { 0 };
+    uint32_t format = 0, adcZero = 0;
+    double gain = 0, baseline = 0;
+    bool hasBaseline = false;
+
+    bool isValid = false;
+    while(fgets(line, sizeof(line), file) != NULL) {
+        if(line[0] == '#') {
+            continue;
+        }
+        else if(numSignals == 0) {
+            if(sscanf(line, "%*s %u %u %u", &numSignals, &fs, &numFrames) != 3) {
+                break;
+            }
+        }
+        else {
+            char gainStr[64];
+            if(sscanf(line, "%127s %u %63s %*u %u", datName, &format, gainStr, &adcZero) != 4) {
+                break;
+            }
+            char * end;
+            gain = strtod(gainStr, &end);
+            if(*end == '(') {
+                baseline = strtod(&end[1], NULL);
+                hasBaseline = true;
+            }
+            isValid = true;
+            break;
+        }
+    }
+    fclose(file);
+
+    if((isValid == false) || (format != 212) || (gain <= 0) || (fs == 0)) {
+        fprintf(stderr, "%s: only format 212 records are supported\n", path);
+        return false;
+    }
+    baseline = (hasBaseline) ? baseline : adcZero;
+
+    // read first signal
+    const char * dir = strrchr(path, '/');
+    snprintf(fileName, sizeof(fileName), "%.*s%s", (dir != NULL) ? (int) (dir - path + 1) : 0,
+             path, datName);
+    file = fopen(fileName, "rb");
+    if(file == NULL) {
+        return false;
+    }
+
+    float * signal = malloc(sizeof(float) * numFrames);
+    uint32_t numRead = 0;
+    uint64_t sampleIdx = 0;
+    uint8_t bytes[3];
+    while((numRead < numFrames) && (fread(bytes, 1, 3, file) == 3)) {
+        int32_t pair[2] = { ((bytes[1] & 0x0F) << 8) | bytes[0],
+                            ((bytes[1] & 0xF0) << 4) | bytes[2] };
+        for(uint8_t k = 0; k < 2; k++, sampleIdx++) {
+            if((sampleIdx % numSignals) == 0) {
+                int32_t sample = (pair[k] & 0x800) ? (pair[k] - 0x1000) : pair[k];
+                if(numRead < numFrames) {
+                    signal[numRead++] = (float) ((sample - baseline) / gain);               // [mV]
+                }
+            }
+        }
+    }
+    fclose(file);
+
+    // resample via linear interpolation, then quantize as the ADC would
+    record->numSamples = (uint32_t) (((uint64_t) numRead * QRS_SAMP_FREQ) / fs);
+    record->adcSamples = malloc(sizeof(uint16_t) * record->numSamples);
+    for(uint32_t n = 0; n < record->numSamples; n++) {
+        double t = ((double) n * fs) / QRS_SAMP_FREQ;
+        uint32_t k = (uint32_t) t;
+        double frac = t - k;
+        double mV = (k + 1 < numRead) ? ((signal[k] * (1 - frac)) + (signal[k + 1] * frac))
+                                      : signal[numRead - 1];
+
+        long code = lround(((mV - DAQ_LOOKUP_MIN) / (DAQ_LOOKUP_MAX - DAQ_LOOKUP_MIN)) * ADC_MAX);
+        record->adcSamples[n] = (uint16_t) ((code < 0) ? 0 : ((code > ADC_MAX) ? ADC_MAX : code));
+    }
+    free(signal);
+
+    snprintf(fileName, sizeof(fileName), "%s.atr", path);
+    record->hasAnnotations = readAnnotations(fileName, fs, record);
+
+    return true;
+}
+
+static bool readAnnotations(const char * path, uint32_t fs, Record_t * record) {
+    /**
+     * Each annotation is a little-endian 16-bit word with a 6-bit code and a 10-bit time
+     * difference. A few special codes are followed by extra data instead of marking an event.
+     */
+    enum { SKIP = 59, NUM = 60, SUB = 61, CHN = 62, AUX = 63 };
+
+    FILE * file = fopen(path, "rb");
+    if(file == NULL) {
+        return false;
+    }
+
+    uint32_t capacity = 1024;
+    record->refBeats = malloc(sizeof(uint32_t) * capacity);
+    record->numRefBeats = 0;
+
+    uint64_t time = 0;
+    uint8_t bytes[4];
+    while(fread(bytes, 1, 2, file) == 2) {
+        uint16_t word = bytes[0] | (bytes[1] << 8);
+        uint16_t code = word >> 10;
+        uint16_t diff = word & 0x3FF;
+
+        if(word == 0) {               // end of file
+            break;
+        }
+        else if(code == SKIP) {
+            if(fread(bytes, 1, 4, file) != 4) {
+                break;
+            }
+            // PDP-11 long: high word first
+            int32_t skip = (int32_t) (((uint32_t) (bytes[0] | (bytes[1] << 8)) << 16) |
+                                      (uint32_t) (bytes[2] | (bytes[3] << 8)));
+            time += skip;
+        }
+        else if(code == AUX) {
+            fseek(file, (diff + 1) & ~1, SEEK_CUR);
+        }
+        else if((code == NUM) || (code == SUB) || (code == CHN)) {
+            continue;
+        }
+        else {
+            time += diff;
+            if(isBeatCode(code)) {
+                if(record->numRefBeats == capacity) {
+                    capacity *= 2;
+                    record->refBeats = realloc(record->refBeats, sizeof(uint32_t) * capacity);
+                }
+                record->refBeats[record->numRefBeats++] =
+                    (uint32_t) llround(((double) time * QRS_SAMP_FREQ) / fs);
+            }
+        }
+    }
+    fclose(file);
+
+    return true;
+}
+
+static bool isBeatCode(uint16_t code) {
+    // same as `isqrs()` from the WFDB library
+    switch(code) {
+        case 1:                                         // N
+        case 2:                                         // L
+        case 3:                                         // R
+        case 4:                                         // a
+        case 5:                                         // V
+        case 6:                                         // F
+        case 7:                                         // J
+        case 8:                                         // A
+        case 9:                                         // S
+        case 10:                                        // E
+        case 11:                                        // j
+        case 12:                                        // /
+        case 13:                                        // Q
+        case 25:                                        // B
+        case 30:                                        // ?
+        case 34:                                        // e
+        case 35:                                        // n
+        case 38:                                        // f
+        case 41:                                        // r
+            return true;
+        default:
+            return false;
+    }
+}
+
+static void freeRecord(Record_t * record) {
+    free(record->adcSamples);
+    free(record->refBeats);
+    return;
+}
+
+/******************************************************************************
+Replay
+*******************************************************************************/
+
+static void replayRecord(const Record_t * record, Replay_t * replay) {
+    /**
+     * The DAQ filters are reset and a new detector is used for each record, so that no filter or
+     * decision state carries over from the previous one.
+     */
+    static QrsDetectorStruct_t detectorStruct;
+    static float32_t buffer[QRS_NUM_SAMP];
+    static uint32_t beatSampleNums[QRS_MAX_BEATS_PER_BLOCK];
+
+    DAQ_resetFilters();
+    QrsDetector_t detector = QRS_DetectorInit(&detectorStruct);
+
+    uint32_t maxBlocks = (record->numSamples / QRS_NUM_SAMP) + 1;
+    replay->blockLatencies_us = malloc(sizeof(double) * maxBlocks);
+    replay->detBeats = malloc(sizeof(uint32_t) * maxBlocks * QRS_MAX_BEATS_PER_BLOCK);
+    replay->numBlocks = 0;
+    replay->numDetBeats = 0;
+
+    float32_t sum = 0;
+    uint32_t N = 0;
+    uint16_t bufferIdx = 0;
+
+    double startTime = getTime_sec();
+    for(uint32_t n = 0; n < record->numSamples; n++) {
+        // same steps as `DAQ_Handler()` and `Processing_Handler()` in `main.c`
+        float32_t sample = DAQ_convertToMilliVolts(record->adcSamples[n]);
+
+        sum += sample;
+        N += 1;
+        sample -= sum / ((float32_t) N);
+
+        buffer[bufferIdx++] = DAQ_NotchFilter(sample);
+
+        if(bufferIdx == QRS_NUM_SAMP) {
+            double blockStartTime = getTime_sec();
+
+            uint16_t numBeats;
+            QRS_DetectorPreprocess(detector, buffer, buffer);
+            QRS_DetectorFindBeats(detector, buffer, beatSampleNums, &numBeats);
+
+            replay->blockLatencies_us[replay->numBlocks++] =
+                (getTime_sec() - blockStartTime) * 1E6;
+
+            memcpy(&replay->detBeats[replay->numDetBeats], beatSampleNums,
+                   sizeof(uint32_t) * numBeats);
+            replay->numDetBeats += numBeats;
+            bufferIdx = 0;
+        }
+    }
+    replay->totalTime_sec = getTime_sec() - startTime;
+
+    return;
+}
+
+static double getTime_sec(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + (now.tv_nsec * 1E-9);
+}
+
+/******************************************************************************
+Scoring
+*******************************************************************************/
+
+static Score_t scoreRecord(const Record_t * record, const Replay_t * replay) {
+    /**
+     * The detected beats are located in the preprocessed signal, so they lag the annotations by
+     * the delay of the filters. This delay is known from the filters (see @ref PIPELINE_DELAY),
+     * so it is the same for every record instead of being fitted to the annotations.
+     *
+     * Only the part of the record that was actually processed (i.e. complete blocks, after the
+     * detector's 2 [s] calibration period) is scored.
+     */
+    Score_t score = { 0 };
+    const int32_t matchWindow = (int32_t) (MATCH_WINDOW_SEC * QRS_SAMP_FREQ);
+
+    const uint32_t * ref = record->refBeats;
+    const uint32_t * det = replay->detBeats;
+    uint32_t numRef = record->numRefBeats;
+    uint32_t numDet = replay->numDetBeats;
+
+    // match beats within the scored range
+    uint32_t startSample = QRS_SAMP_FREQ * 2;
+    uint32_t endSample = replay->numBlocks * QRS_NUM_SAMP;
+
+    uint32_t d = 0;
+    for(uint32_t r = 0; r < numRef; r++) {
+        int32_t refTime = (int32_t) ref[r] + PIPELINE_DELAY;
+        if((refTime < (int32_t) startSample) || (refTime >= (int32_t) endSample)) {
+            continue;
+        }
+
+        // detected beats that are too early to match are false positives
+        while((d < numDet) && ((int32_t) det[d] < (refTime - matchWindow))) {
+            score.falsePos += (det[d] >= startSample) ? 1 : 0;
+            d++;
+        }
+
+        if((d < numDet) && (abs((int32_t) det[d] - refTime) <= matchWindow)) {
+            score.truePos += 1;
+            d++;
+        }
+        else {
+            score.falseNeg += 1;
+        }
+    }
+    for(; d < numDet; d++) {
+        score.falsePos += ((det[d] >= startSample) && (det[d] < endSample)) ? 1 : 0;
+    }
+
+    return score;
+}
+
+static int compareDoubles(const void * a, const void * b) {
+    double x = *((const double *) a);
+    double y = *((const double *) b);
+    return (x > y) - (x < y);
+}
+
+static int compareStrings(const void * a, const void * b) {
+    return strcmp(*((char * const *) a), *((char * const *) b));
+}
+
+static void printHeader(void) {
+    printf("QRS_NUM_SAMP = %u, fs = %u [Hz], delay = %u [samples]\n\n", (unsigned) QRS_NUM_SAMP,
+           (unsigned) QRS_SAMP_FREQ, (unsigned) PIPELINE_DELAY);
+    printf("%-8s %10s %12s | %9s %9s %9s %9s | %6s %6s %6s %6s %7s\n", "record", "samples",
+           "samples/s", "p50 [us]", "p90 [us]", "p99 [us]", "max [us]", "TP", "FN", "FP",
+           "Se [%]", "+P [%]");
+    return;
+}
+
+static void printResults(const char * name, uint32_t numSamples, double time_sec,
+                         double * latencies, uint32_t numBlocks, const Score_t * score) {
+    double percentiles[4] = { 0 };
+    if(numBlocks > 0) {
+        qsort(latencies, numBlocks, sizeof(double), compareDoubles);
+        percentiles[0] = latencies[(numBlocks * 50) / 100];
+        percentiles[1] = latencies[(numBlocks * 90) / 100];
+        percentiles[2] = latencies[(numBlocks * 99) / 100];
+        percentiles[3] = latencies[numBlocks - 1];
+    }
+
+    printf("%-8s %10u %12.4g | %9.1f %9.1f %9.1f %9.1f |", name, numSamples,
+           (time_sec > 0) ? (numSamples / time_sec) : 0.0, percentiles[0], percentiles[1],
+           percentiles[2], percentiles[3]);
+
+    if(score != NULL) {
+        uint32_t numRef = score->truePos + score->falseNeg;
+        uint32_t numDet = score->truePos + score->falsePos;
+        printf(" %6u %6u %6u %6.2f %7.2f", score->truePos, score->falseNeg, score->falsePos,
+               (numRef > 0) ? (100.0 * score->truePos / numRef) : 0.0,
+               (numDet > 0) ? (100.0 * score->truePos / numDet) : 0.0);
+        printf("\n");
+    }
+    else {
+        printf(" (no reference annotations)\n");
+    }
+
+    return;
+}
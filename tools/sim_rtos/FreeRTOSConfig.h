@@ -0,0 +1,92 @@
+/**
+ * @file
+ * @author  Bryan McElvy
+ * @brief   FreeRTOS configuration for the host build of `main_rtos.c` (POSIX/Linux port).
+ *
+ * @details This mirrors `external/FreeRTOS/FreeRTOSConfig.h` wherever the setting affects how the
+ *          application behaves (priorities, notifications, static allocation, run-time stats).
+ *          The differences are:
+ *
+ *          - The tick rate is 10 [kHz] instead of 1 [kHz], so that the simulated ADC interrupt
+ *            can be paced evenly at up to 50x real time (see `sim_rtos.c`).
+ *          - Ticks are 32-bit, and there are no Cortex-M interrupt priority settings.
+ *          - The idle task's stack must be large enough to be a `pthread` stack.
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#include <stdint.h>
+
+#define configUSE_PREEMPTION                      1
+#define configTICK_RATE_HZ                        ((TickType_t) 10000)
+#define configMAX_PRIORITIES                      (8)
+#define configMINIMAL_STACK_SIZE                  ((unsigned short) 8192)
+#define configMAX_TASK_NAME_LEN                   (16)
+#define configIDLE_SHOULD_YIELD                   1
+#define configQUEUE_REGISTRY_SIZE                 0
+#define configUSE_APPLICATION_TASK_TAG            0
+#define configUSE_COUNTING_SEMAPHORES             0
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION   0
+#define configUSE_TICKLESS_IDLE                   0
+#define configUSE_16_BIT_TICKS                    0
+#define configTICK_TYPE_WIDTH_IN_BITS             TICK_TYPE_WIDTH_32_BITS
+#define configUSE_TASK_NOTIFICATIONS              1
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES     3
+#define configUSE_MUTEXES                         1
+#define configUSE_RECURSIVE_MUTEXES               0
+#define configUSE_QUEUE_SETS                      0
+#define configUSE_TIME_SLICING                    0
+#define configUSE_NEWLIB_REENTRANT                0
+#define configENABLE_BACKWARD_COMPATIBILITY       0
+#define configNUM_THREAD_LOCAL_STORAGE_POINTERS   5
+#define configMESSAGE_BUFFER_LENGTH_TYPE          size_t
+
+/* Memory allocation related definitions. */
+#define configSUPPORT_STATIC_ALLOCATION           1
+#define configSUPPORT_DYNAMIC_ALLOCATION          0
+#define configTOTAL_HEAP_SIZE                     ((size_t) 0)
+
+/* Hook function related definitions. */
+#define configUSE_IDLE_HOOK                       0
+#define configUSE_TICK_HOOK                       1
+#define configCHECK_FOR_STACK_OVERFLOW            2
+#define configUSE_MALLOC_FAILED_HOOK              0
+#define configUSE_DAEMON_TASK_STARTUP_HOOK        0
+#define configUSE_SB_COMPLETED_CALLBACK           0
+
+/* Run time and task stats gathering related definitions. */
+#define configGENERATE_RUN_TIME_STATS             1
+#define configUSE_TRACE_FACILITY                  1
+#define configUSE_STATS_FORMATTING_FUNCTIONS      0
+
+/* Run time stats clock (host clock, in 80 [MHz] cycles); defined in main_rtos.c. */
+void vConfigureTimerForRunTimeStats(void);
+uint32_t ulGetRunTimeCounterValue(void);
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()  vConfigureTimerForRunTimeStats()
+#define portGET_RUN_TIME_COUNTER_VALUE()          ulGetRunTimeCounterValue()
+
+/* Co-routine and software timer definitions. */
+#define configUSE_CO_ROUTINES                     0
+#define configMAX_CO_ROUTINE_PRIORITIES           1
+#define configUSE_TIMERS                          0
+
+/* Optional functions. */
+#define INCLUDE_vTaskPrioritySet                  1
+#define INCLUDE_vTaskDelete                       0
+#define INCLUDE_vTaskSuspend                      1
+#define INCLUDE_xResumeFromISR                    1
+#define INCLUDE_vTaskDelayUntil                   1
+#define INCLUDE_vTaskDelay                        1
+#define INCLUDE_xTaskGetSchedulerState            1
+#define INCLUDE_xTaskGetCurrentTaskHandle         1
+#define INCLUDE_xTaskResumeFromISR                1
+
+/* Failed kernel assertions end the simulation; defined in sim_drivers.c. */
+void vAssertCalled(const char * fileName, unsigned long lineNum);
+#define configASSERT(x)                                                                            \
+    if((x) == 0) {                                                                                 \
+        vAssertCalled(__FILE__, __LINE__);                                                         \
+    }
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,55 @@
+/**
+ * @file
+ * @author  Bryan McElvy
+ * @brief   Interface between the parts of the host simulation of `main_rtos.c`.
+ *
+ * @details `sim_drivers.c` and `sim_lcd.c` replace the device drivers that `main_rtos.c` and its
+ *          modules use, and `sim_rtos.c` uses the functions below to drive them.
+ */
+
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/******************************************************************************
+Simulated Interrupts/ADC (sim_drivers.c)
+*******************************************************************************/
+
+/**
+ * @brief               Set the value that the next ADC_readSample() call returns.
+ * @param[in] sample    12-bit sample in range `[0x000, 0xFFF]`.
+ */
+void Sim_setAdcSample(uint16_t sample);
+
+/**
+ * @brief               Call an interrupt's handler, if it has been enabled via ISR_Enable()
+ *                      and interrupts are enabled globally.
+ *
+ * @param[in] vectorNum Vector number of the interrupt.
+ * @param[out] true     The handler was called.
+ * @param[out] false    The interrupt is disabled.
+ */
+bool Sim_raiseInterrupt(uint8_t vectorNum);
+
+/******************************************************************************
+Simulated LCD (sim_lcd.c)
+*******************************************************************************/
+
+/**
+ * @brief               Create the file that backs the simulated ILI9341's framebuffer.
+ *
+ * @details             The file is a binary PPM image (320 x 240, landscape) that is memory-mapped,
+ *                      so it shows the display's current contents while the simulation runs.
+ *
+ * @param[in] fileName  Path to the output file. It is overwritten if it exists.
+ * @param[out] true     The framebuffer was created.
+ * @param[out] false    The file couldn't be created.
+ */
+bool SimLcd_Init(const char * fileName);
+
+/// @brief  Write the framebuffer's current contents to its file.
+void SimLcd_Flush(void);
+
+#endif               // SIM_H
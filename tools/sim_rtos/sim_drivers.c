@@ -0,0 +1,431 @@
+/**
+ * @file
+ * @author  Bryan McElvy
+ * @brief   Host versions of the device drivers used by `main_rtos.c` and its modules.
+ *
+ * @details Each driver keeps the same interface as in `src/drivers`, so the application and
+ *          middleware modules link against these without changes.
+ *
+ *          - `ADC`: returns the sample set via Sim_setAdcSample().
+ *          - `GPIO`, `PLL`: only keep track of their state.
+ *          - `ISR`: interrupts are raised via Sim_raiseInterrupt() instead of the NVIC.
+ *          - `Timer`: the counter value comes from the host's monotonic clock, in 80 [MHz] cycles.
+ *          - `UART`: writes go straight to `stdout`, so the TX buffer is never used.
+ *
+ *          Failed assertions (including kernel assertions via `configASSERT()`) end the
+ *          simulation with `EXIT_FAILURE`.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+/******************************************************************************
+SECTIONS
+        Assertions
+        ADC
+        GPIO
+        ISR
+        PLL
+        Timer
+        UART
+*******************************************************************************/
+
+#include "sim.h"
+
+#include "ADC.h"
+#include "GPIO.h"
+#include "ISR.h"
+#include "PLL.h"
+#include "Timer.h"
+#include "UART.h"
+
+#include "NewAssert.h"
+
+#include "tm4c123gh6pm.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/******************************************************************************
+Assertions
+*******************************************************************************/
+
+void assert(bool condition) {
+    if(condition == false) {
+        fflush(stdout);
+        fprintf(stderr, "sim: assertion failed\n");
+        exit(EXIT_FAILURE);
+    }
+    return;
+}
+
+void vAssertCalled(const char * fileName, unsigned long lineNum) {
+    fflush(stdout);
+    fprintf(stderr, "sim: kernel assertion failed at %s:%lu\n", fileName, lineNum);
+    exit(EXIT_FAILURE);
+}
+
+/******************************************************************************
+ADC
+*******************************************************************************/
+
+static uint16_t adcSample = 0;
+
+void ADC_Init(void) {
+    return;
+}
+
+uint16_t ADC_readSample(void) {
+    return adcSample;
+}
+
+void ADC_acknowledgeInterrupt(void) {
+    return;
+}
+
+void Sim_setAdcSample(uint16_t sample) {
+    assert(sample <= 0xFFF);
+    adcSample = sample;
+    return;
+}
+
+/******************************************************************************
+GPIO
+*******************************************************************************/
+
+typedef struct GpioPortStruct_t {
+    uint32_t data;
+    bool isInit;
+} GpioPortStruct_t;
+
+static GpioPortStruct_t gpioPorts[6] = { 0 };
+
+GpioPort_t GPIO_InitPort(GPIO_PortName_t portName) {
+    GpioPort_t gpioPort = &gpioPorts[portName];
+    gpioPort->isInit = true;
+    return gpioPort;
+}
+
+bool GPIO_isPortInit(GpioPort_t gpioPort) {
+    return gpioPort->isInit;
+}
+
+void GPIO_configDirection(GpioPort_t gpioPort, GpioPin_t pinMask, gpioDir_t direction) {
+    return;
+}
+
+void GPIO_EnableDigital(GpioPort_t gpioPort, GpioPin_t pinMask) {
+    return;
+}
+
+void GPIO_DisableDigital(GpioPort_t gpioPort, GpioPin_t pinMask) {
+    return;
+}
+
+volatile uint32_t * GPIO_getDataRegister(GpioPort_t gpioPort) {
+    return &gpioPort->data;
+}
+
+uint8_t GPIO_ReadPins(GpioPort_t gpioPort, GpioPin_t pinMask) {
+    return (uint8_t) (gpioPort->data & pinMask);
+}
+
+void GPIO_WriteHigh(GpioPort_t gpioPort, GpioPin_t pinMask) {
+    gpioPort->data |= pinMask;
+    return;
+}
+
+void GPIO_WriteLow(GpioPort_t gpioPort, GpioPin_t pinMask) {
+    gpioPort->data &= ~(pinMask);
+    return;
+}
+
+void GPIO_Toggle(GpioPort_t gpioPort, GpioPin_t pinMask) {
+    gpioPort->data ^= pinMask;
+    return;
+}
+
+/******************************************************************************
+ISR
+*******************************************************************************/
+
+#define VECTOR_TABLE_SIZE 155
+
+void ADC0_SS3_Handler(void);               // `Daq_Handler()` in `main_rtos.c`
+
+static bool interruptsAreEnabled = true;
+static bool isEnabled[VECTOR_TABLE_SIZE] = { false };
+static ISR_t vectorTable[VECTOR_TABLE_SIZE] = {
+    [INT_ADC0SS3] = ADC0_SS3_Handler,
+};
+
+void ISR_GlobalDisable(void) {
+    interruptsAreEnabled = false;
+    return;
+}
+
+void ISR_GlobalEnable(void) {
+    interruptsAreEnabled = true;
+    return;
+}
+
+void ISR_InitNewTableInRam(void) {
+    return;
+}
+
+void ISR_addToIntTable(ISR_t isr, const uint8_t vectorNum) {
+    assert(vectorNum < VECTOR_TABLE_SIZE);
+    vectorTable[vectorNum] = isr;
+    return;
+}
+
+void ISR_setPriority(const uint8_t vectorNum, const uint8_t priority) {
+    assert(vectorNum < VECTOR_TABLE_SIZE);
+    assert(priority <= 7);
+    return;
+}
+
+void ISR_Enable(const uint8_t vectorNum) {
+    assert(vectorNum < VECTOR_TABLE_SIZE);
+    isEnabled[vectorNum] = true;
+    return;
+}
+
+void ISR_Disable(const uint8_t vectorNum) {
+    assert(vectorNum < VECTOR_TABLE_SIZE);
+    isEnabled[vectorNum] = false;
+    return;
+}
+
+void ISR_triggerInterrupt(const uint8_t vectorNum) {
+    Sim_raiseInterrupt(vectorNum);
+    return;
+}
+
+bool Sim_raiseInterrupt(uint8_t vectorNum) {
+    assert(vectorNum < VECTOR_TABLE_SIZE);
+
+    bool isRaised = interruptsAreEnabled && isEnabled[vectorNum] && (vectorTable[vectorNum] != 0);
+    if(isRaised) {
+        vectorTable[vectorNum]();
+    }
+    return isRaised;
+}
+
+/******************************************************************************
+PLL
+*******************************************************************************/
+
+void PLL_Init(void) {
+    return;
+}
+
+uint32_t PLL_getBusFreq_Hz(void) {
+    return PLL_BUS_FREQ_HZ;
+}
+
+/******************************************************************************
+Timer
+*******************************************************************************/
+
+typedef struct TimerStruct_t {
+    timerName_t name;
+    bool isInit;
+    bool isCounting;
+} TimerStruct_t;
+
+static TimerStruct_t timers[6] = {
+    { TIMER0, false, false }, { TIMER1, false, false }, { TIMER2, false, false },
+    { TIMER3, false, false }, { TIMER4, false, false }, { TIMER5, false, false },
+};
+
+Timer_t Timer_Init(timerName_t timerName) {
+    Timer_t timer = &timers[timerName];
+    timer->isInit = true;
+    timer->isCounting = false;
+    return timer;
+}
+
+void Timer_Deinit(Timer_t timer) {
+    timer->isInit = false;
+    timer->isCounting = false;
+    return;
+}
+
+timerName_t Timer_getName(Timer_t timer) {
+    assert(timer->isInit);
+    return timer->name;
+}
+
+bool Timer_isInit(Timer_t timer) {
+    return timer->isInit;
+}
+
+void Timer_setMode(Timer_t timer, timerMode_t timerMode, timerDirection_t timerDirection) {
+    assert(timer->isInit);
+    timer->isCounting = false;
+    return;
+}
+
+void Timer_enableAdcTrigger(Timer_t timer) {
+    return;
+}
+
+void Timer_disableAdcTrigger(Timer_t timer) {
+    return;
+}
+
+void Timer_enableInterruptOnTimeout(Timer_t timer) {
+    return;
+}
+
+void Timer_disableInterruptOnTimeout(Timer_t timer) {
+    return;
+}
+
+void Timer_clearInterruptFlag(Timer_t timer) {
+    return;
+}
+
+void Timer_setInterval_ms(Timer_t timer, uint32_t time_ms) {
+    assert(timer->isInit);
+    assert((time_ms > 0) && (time_ms <= 53000));
+    timer->isCounting = false;
+    return;
+}
+
+void Timer_setReloadValue(Timer_t timer, uint32_t reloadValue) {
+    assert(timer->isInit);
+    timer->isCounting = false;
+    return;
+}
+
+uint32_t Timer_getCurrentValue(Timer_t timer) {
+    assert(timer->isInit);
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    uint64_t time_ns = ((uint64_t) now.tv_sec * 1000000000) + (uint64_t) now.tv_nsec;
+    return (uint32_t) ((time_ns * 2) / 25);               // 80 [MHz] = 2 cycles per 25 [ns]
+}
+
+void Timer_Start(Timer_t timer) {
+    assert(timer->isInit);
+    timer->isCounting = true;
+    return;
+}
+
+void Timer_Stop(Timer_t timer) {
+    assert(timer->isInit);
+    timer->isCounting = false;
+    return;
+}
+
+bool Timer_isCounting(Timer_t timer) {
+    return timer->isCounting;
+}
+
+void Timer_Wait1ms(Timer_t timer, uint32_t time_ms) {
+    assert(timer->isInit);
+    return;               // the simulated LCD doesn't need any delays
+}
+
+/******************************************************************************
+UART
+*******************************************************************************/
+
+typedef struct UartStruct_t {
+    bool isInit;
+} UartStruct_t;
+
+static UartStruct_t uarts[8] = { 0 };
+
+Uart_t UART_Init(GpioPort_t port, uartNum_t uartNum) {
+    Uart_t uart = &uarts[uartNum];
+    uart->isInit = true;
+    return uart;
+}
+
+bool UART_isInit(Uart_t uart) {
+    return uart->isInit;
+}
+
+unsigned char UART_ReadChar(Uart_t uart) {
+    return 0;
+}
+
+void UART_setBaudRate(Uart_t uart, uint32_t baudRate) {
+    assert(uart->isInit);
+
+    UartBaudDivisor_t divisor;
+    assert(UART_calcBaudDivisor(PLL_getBusFreq_Hz(), baudRate, &divisor));
+    return;
+}
+
+void UART_WriteChar(Uart_t uart, unsigned char inputChar) {
+    assert(uart->isInit);
+    putchar(inputChar);
+    return;
+}
+
+void UART_WriteStr(Uart_t uart, void * inputStr) {
+    assert(uart->isInit);
+    fputs((const char *) inputStr, stdout);
+    return;
+}
+
+void UART_WriteBytes(Uart_t uart, const uint8_t bytes[], uint32_t N) {
+    assert(uart->isInit);
+    fwrite(bytes, 1, N, stdout);
+    return;
+}
+
+void UART_WriteInt(Uart_t uart, int32_t n) {
+    assert(uart->isInit);
+    printf("%d", n);
+    return;
+}
+
+void UART_WriteFloat(Uart_t uart, double n, uint8_t numDecimals) {
+    assert(uart->isInit);
+
+    // truncate instead of rounding, like the UART driver
+    if(n < 0) {
+        putchar('-');
+        n *= -1;
+    }
+
+    int32_t b = (int32_t) n;
+    printf("%d", b);
+
+    if(numDecimals > 0) {
+        putchar('.');
+        for(uint8_t count = 0; count < numDecimals; count++) {
+            n = (n - b) * 10;
+            b = (int32_t) n;
+            putchar('0' + b);
+        }
+    }
+    return;
+}
+
+void UART_EnableTxBuffer(Uart_t uart, uint8_t buffer[], uint32_t N) {
+    assert(uart->isInit);
+    assert((N > 0) && ((N & (N - 1)) == 0));
+    return;
+}
+
+void UART_handleTxInterrupt(Uart_t uart) {
+    return;
+}
+
+void UART_Flush(Uart_t uart) {
+    fflush(stdout);
+    return;
+}
+
+uint32_t UART_getNumDropped(Uart_t uart) {
+    return 0;
+}
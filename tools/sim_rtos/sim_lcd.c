@@ -0,0 +1,398 @@
+/**
+ * @file
+ * @author  Bryan McElvy
+ * @brief   Host version of the SPI driver that simulates the ILI9341 LCD driver on the bus.
+ *
+ * @details The bytes that the ILI9341 module writes via SPI_WriteCmd(), SPI_WriteData() and the
+ *          burst functions (e.g. SPI_WriteRepeat16()) are decoded the same way the real display
+ *          controller would decode them, so the LCD and ILI9341 modules run unchanged. Frames wider
+ *          than 8 bits are decoded as their two bytes, MSB first, as the controller receives them.
+ *          Only the commands that affect the picture are handled:
+ *
+ *          Command          | Effect
+ *          -----------------|------------------------------------------------------------------
+ *          `CASET`/`PASET`  | set the column/page (i.e. row) address window
+ *          `RAMWR`          | write pixels into the window, column by column within each page
+ *          `PIXSET`         | 16-bit (2 transfers/pixel) or 18-bit (3 transfers/pixel) color
+ *          `MADCTL`         | flip/exchange the addresses, and set the color order (`BGR`)
+ *          `DINVON/DINVOFF` | invert the displayed colors
+ *          `VSCRDEF`        | define the fixed and scrolling areas (in rows)
+ *          `VSCRSADD`       | start scrolling, with the given row at the top of the scrolling area
+ *          `NORON`          | stop scrolling
+ *
+ *          The display memory is 240 columns x 320 rows. It is shown in a memory-mapped PPM file
+ *          in landscape orientation, as on the device: row 0 is on the right and column 0 is at the
+ *          bottom, so the LCD module's `x` axis (rows, flipped via `MADCTL`) points right and its
+ *          `y` axis (columns) points up. Like most ILI9341 modules, the panel is wired as BGR.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+/******************************************************************************
+SECTIONS
+        Declarations
+        Framebuffer
+        SPI Driver
+        Command Decoding
+*******************************************************************************/
+
+#include "sim.h"
+
+#include "ILI9341.h"
+#include "PLL.h"
+#include "SPI.h"
+
+#include "NewAssert.h"
+
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/******************************************************************************
+Declarations
+*******************************************************************************/
+
+#define NUM_COLS       ILI9341_NUM_COLS                   ///< 240
+#define NUM_ROWS       ILI9341_NUM_ROWS                   ///< 320
+
+#define IMAGE_WIDTH    NUM_ROWS
+#define IMAGE_HEIGHT   NUM_COLS
+#define PPM_HEADER     "P6\n320 240\n255\n"
+
+enum MADCTL_BITS {
+    MADCTL_MY = 0x80,                                     ///< flip row (page) addresses
+    MADCTL_MX = 0x40,                                     ///< flip column addresses
+    MADCTL_MV = 0x20,                                     ///< exchange rows and columns
+    MADCTL_BGR = 0x08,                                    ///< BGR color order
+};
+
+typedef struct SpiStruct_t {
+    uint8_t dataSize;
+    bool isInit;
+} SpiStruct_t;
+
+static SpiStruct_t spiStruct = { 8, false };
+
+static struct {
+    uint32_t memory[NUM_ROWS][NUM_COLS];                  ///< 18-bit RGB (6 bits each) per pixel
+
+    uint8_t cmd;                                          ///< most recent command
+    uint8_t params[6];
+    uint8_t numParams;                                    ///< num. parameters received for `cmd`
+
+    uint16_t colStart, colEnd, col;                       ///< column address window and pointer
+    uint16_t rowStart, rowEnd, row;                       ///< page (row) address window and pointer
+    uint8_t pixelBytes[3];
+    uint8_t numPixelBytes;                                ///< num. bytes received for next pixel
+
+    uint8_t madctl;
+    bool is18Bit;
+    bool isInverted;
+
+    uint16_t topFixedRows, numScrollRows;                 ///< vertical scrolling definition
+    uint16_t scrollStart;                                 ///< row shown at top of scrolling area
+    bool isScrolling;
+
+    uint8_t * image;                                      ///< memory-mapped PPM file
+    size_t imageSize;
+} lcd = { .colEnd = NUM_COLS - 1, .rowEnd = NUM_ROWS - 1, .numScrollRows = NUM_ROWS };
+
+static void decodeCmd(uint8_t cmd);
+static void decodeData(uint8_t data);
+static void decodeFrame(Spi_t spi, uint16_t frame);
+static void writePixel(void);
+static void drawPixel(uint16_t row, uint16_t col);
+static void drawAll(void);
+
+/******************************************************************************
+Framebuffer
+*******************************************************************************/
+
+bool SimLcd_Init(const char * fileName) {
+    int fd = open(fileName, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if(fd < 0) {
+        return false;
+    }
+
+    lcd.imageSize = strlen(PPM_HEADER) + (IMAGE_WIDTH * IMAGE_HEIGHT * 3);
+    if(ftruncate(fd, (off_t) lcd.imageSize) != 0) {
+        close(fd);
+        return false;
+    }
+
+    void * image = mmap(NULL, lcd.imageSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if(image == MAP_FAILED) {
+        return false;
+    }
+
+    lcd.image = image;
+    memcpy(lcd.image, PPM_HEADER, strlen(PPM_HEADER));
+    drawAll();
+    return true;
+}
+
+void SimLcd_Flush(void) {
+    if(lcd.image != NULL) {
+        msync(lcd.image, lcd.imageSize, MS_SYNC);
+    }
+    return;
+}
+
+static void drawPixel(uint16_t row, uint16_t col) {
+    if(lcd.image == NULL) {
+        return;
+    }
+
+    uint32_t rgb = lcd.memory[row][col];
+    rgb = (lcd.isInverted) ? ~rgb : rgb;
+
+    // find the line of the panel that shows this row of memory
+    uint16_t line = row;
+    uint16_t scrollEnd = lcd.topFixedRows + lcd.numScrollRows;
+    if(lcd.isScrolling && (row >= lcd.topFixedRows) && (row < scrollEnd)) {
+        uint32_t offset = (row + lcd.numScrollRows - lcd.scrollStart) % lcd.numScrollRows;
+        line = (uint16_t) (lcd.topFixedRows + offset);
+    }
+
+    uint8_t red = (uint8_t) (((rgb >> 12) & 0x3F) << 2);
+    uint8_t green = (uint8_t) (((rgb >> 6) & 0x3F) << 2);
+    uint8_t blue = (uint8_t) ((rgb & 0x3F) << 2);
+    if((lcd.madctl & MADCTL_BGR) == 0) {
+        uint8_t temp = red;
+        red = blue;
+        blue = temp;
+    }
+
+    // landscape: lines go right to left, and columns go bottom to top
+    size_t pixelIdx = ((size_t) (IMAGE_HEIGHT - 1 - col) * IMAGE_WIDTH) + (IMAGE_WIDTH - 1 - line);
+    uint8_t * pixel = &lcd.image[strlen(PPM_HEADER) + (pixelIdx * 3)];
+    pixel[0] = red;
+    pixel[1] = green;
+    pixel[2] = blue;
+    return;
+}
+
+static void drawAll(void) {
+    for(uint16_t row = 0; row < NUM_ROWS; row++) {
+        for(uint16_t col = 0; col < NUM_COLS; col++) {
+            drawPixel(row, col);
+        }
+    }
+    return;
+}
+
+/******************************************************************************
+SPI Driver
+*******************************************************************************/
+
+Spi_t SPI_Init(GpioPort_t gpioPort, GpioPin_t dcPin, SsiNum_t ssiNum) {
+    spiStruct.isInit = true;
+    return &spiStruct;
+}
+
+bool SPI_isInit(Spi_t spi) {
+    return spi->isInit;
+}
+
+void SPI_configClock(Spi_t spi, SpiClockPhase_t clockPhase, SpiClockPolarity_t clockPolarity) {
+    return;
+}
+
+void SPI_setDataSize(Spi_t spi, uint8_t dataSize) {
+    spi->dataSize = dataSize;
+    return;
+}
+
+void SPI_setBitRate(Spi_t spi, uint32_t bitRate) {
+    SpiClockDivisor_t divisor;
+    assert(SPI_calcClockDivisor(PLL_getBusFreq_Hz(), bitRate, &divisor));
+    return;
+}
+
+void SPI_Enable(Spi_t spi) {
+    return;
+}
+
+void SPI_Disable(Spi_t spi) {
+    return;
+}
+
+uint16_t SPI_Read(Spi_t spi) {
+    return 0;
+}
+
+void SPI_WriteCmd(Spi_t spi, uint16_t cmd) {
+    decodeCmd((uint8_t) cmd);
+    return;
+}
+
+void SPI_WriteData(Spi_t spi, uint16_t data) {
+    decodeFrame(spi, data);
+    return;
+}
+
+void SPI_WriteBuffer(Spi_t spi, const uint8_t data[], uint32_t len) {
+    for(uint32_t idx = 0; idx < len; idx++) {
+        decodeFrame(spi, data[idx]);
+    }
+    return;
+}
+
+void SPI_WriteBuffer16(Spi_t spi, const uint16_t data[], uint32_t len) {
+    for(uint32_t idx = 0; idx < len; idx++) {
+        decodeData((uint8_t) (data[idx] >> 8));
+        decodeData((uint8_t) data[idx]);
+    }
+    return;
+}
+
+void SPI_WriteRepeat16(Spi_t spi, uint16_t value, uint32_t count) {
+    for(uint32_t n = 0; n < count; n++) {
+        decodeData((uint8_t) (value >> 8));
+        decodeData((uint8_t) value);
+    }
+    return;
+}
+
+/// @brief  Decode a data frame of the current data size.
+static void decodeFrame(Spi_t spi, uint16_t frame) {
+    if(spi->dataSize > 8) {
+        decodeData((uint8_t) (frame >> 8));
+    }
+    decodeData((uint8_t) frame);
+    return;
+}
+
+/******************************************************************************
+Command Decoding
+*******************************************************************************/
+
+static void decodeCmd(uint8_t cmd) {
+    lcd.cmd = cmd;
+    lcd.numParams = 0;
+
+    switch(cmd) {
+        case RAMWR:
+            lcd.col = lcd.colStart;
+            lcd.row = lcd.rowStart;
+            lcd.numPixelBytes = 0;
+            break;
+        case DINVON:
+        case DINVOFF:
+            lcd.isInverted = (cmd == DINVON);
+            drawAll();
+            break;
+        case NORON:
+            if(lcd.isScrolling) {
+                lcd.isScrolling = false;
+                drawAll();
+            }
+            break;
+        default:
+            break;
+    }
+    return;
+}
+
+static void decodeData(uint8_t data) {
+    switch(lcd.cmd) {
+        case CASET:
+        case PASET:
+            lcd.params[lcd.numParams++] = data;
+            if(lcd.numParams == 4) {
+                uint16_t start = (uint16_t) ((lcd.params[0] << 8) | lcd.params[1]);
+                uint16_t end = (uint16_t) ((lcd.params[2] << 8) | lcd.params[3]);
+                if(lcd.cmd == CASET) {
+                    lcd.colStart = start;
+                    lcd.colEnd = end;
+                }
+                else {
+                    lcd.rowStart = start;
+                    lcd.rowEnd = end;
+                }
+                lcd.numParams = 0;
+            }
+            break;
+        case VSCRDEF:
+            lcd.params[lcd.numParams++] = data;
+            if(lcd.numParams == 6) {
+                lcd.topFixedRows = (uint16_t) ((lcd.params[0] << 8) | lcd.params[1]);
+                lcd.numScrollRows = (uint16_t) ((lcd.params[2] << 8) | lcd.params[3]);
+                lcd.numParams = 0;
+            }
+            break;
+        case VSCRSADD:
+            lcd.params[lcd.numParams++] = data;
+            if(lcd.numParams == 2) {
+                lcd.scrollStart = (uint16_t) ((lcd.params[0] << 8) | lcd.params[1]);
+                lcd.isScrolling = true;
+                lcd.numParams = 0;
+                drawAll();
+            }
+            break;
+        case RAMWR:
+            lcd.pixelBytes[lcd.numPixelBytes++] = data;
+            if(lcd.numPixelBytes == ((lcd.is18Bit) ? 3 : 2)) {
+                writePixel();
+                lcd.numPixelBytes = 0;
+            }
+            break;
+        case PIXSET:
+            lcd.is18Bit = (data == COLORDEPTH_18BIT);
+            break;
+        case MADCTL:
+            lcd.madctl = data;
+            drawAll();
+            break;
+        default:
+            break;
+    }
+    return;
+}
+
+static void writePixel(void) {
+    // convert to 18-bit RGB, as stored by the display controller
+    uint32_t red, green, blue;
+    if(lcd.is18Bit) {
+        red = lcd.pixelBytes[0] >> 2;
+        green = lcd.pixelBytes[1] >> 2;
+        blue = lcd.pixelBytes[2] >> 2;
+    }
+    else {
+        uint16_t rgb565 = (uint16_t) ((lcd.pixelBytes[0] << 8) | lcd.pixelBytes[1]);
+        red = ((rgb565 >> 11) & 0x1F) << 1;
+        green = (rgb565 >> 5) & 0x3F;
+        blue = (rgb565 & 0x1F) << 1;
+    }
+
+    // map the address pointer onto display memory
+    uint16_t col = lcd.col;
+    uint16_t row = lcd.row;
+    if(lcd.madctl & MADCTL_MV) {
+        uint16_t temp = col;
+        col = row;
+        row = temp;
+    }
+    col = (lcd.madctl & MADCTL_MX) ? (NUM_COLS - 1 - col) : col;
+    row = (lcd.madctl & MADCTL_MY) ? (NUM_ROWS - 1 - row) : row;
+
+    if((col < NUM_COLS) && (row < NUM_ROWS)) {
+        lcd.memory[row][col] = (red << 12) | (green << 6) | blue;
+        drawPixel(row, col);
+    }
+
+    // advance the address pointer within the window
+    if(lcd.col < lcd.colEnd) {
+        lcd.col += 1;
+    }
+    else {
+        lcd.col = lcd.colStart;
+        lcd.row = (lcd.row < lcd.rowEnd) ? (lcd.row + 1) : lcd.rowStart;
+    }
+    return;
+}
@@ -0,0 +1,371 @@
+/**
+ * @file
+ * @author  Bryan McElvy
+ * @brief   Runs `main_rtos.c` on the FreeRTOS POSIX port, with ADC samples replayed from a file.
+ *
+ * @details The firmware's `main()` is compiled as `RTOS_main()` and called after the simulation
+ *          is set up. Before that, a task with the highest priority is created to stand in for
+ *          the DAQ timer and ADC. It sets the next sample via Sim_setAdcSample() and then raises
+ *          the ADC interrupt, so `Daq_Handler()` runs the same way it does on the device.
+ *
+ *          The interrupt is raised every `1 / (200 * speed)` seconds, rounded to whole kernel
+ *          ticks. A speed of up to 50x can be paced evenly with the simulation's 10 [kHz] tick.
+ *          If the tasks can't keep up, `Daq_Handler()` or the processing task fails an assertion
+ *          and the simulation exits with `EXIT_FAILURE`, so the highest speed that exits
+ *          successfully is the amount of headroom the application has on the host.
+ *
+ *          The LCD is written to a memory-mapped PPM image (see `sim_lcd.c`), and the serial
+ *          output goes to `stdout`. The `ADC (sim)` task wakes up every tick, so its CPU load in
+ *          the run-time stats is mostly the host's overhead, not the application's.
+ *
+ *          Usage: `sim_rtos [-s speed] [-n repeats] [-o image.ppm] [-r Hz] [-m] <input>`
+ *
+ *          - `<input>`: a MIT-BIH record (path without extension, format 212, first signal),
+ *            or a `.csv` file with `index,value` or `value` rows
+ *            (e.g. `tools/JDS6600/ecg_waveform.csv`).
+ *          - `-s`: speed relative to real time (default 1).
+ *          - `-n`: number of times to replay the input (default 1).
+ *          - `-o`: LCD image file (default `sim_lcd.ppm`).
+ *          - `-r`: sampling rate of a `.csv` input in [Hz] (default 200).
+ *          - `-m`: the `.csv` values are in [mV] (e.g. from `tools/data/dataset_csv_gen.py`)
+ *            instead of 12-bit ADC codes.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+/******************************************************************************
+SECTIONS
+        Declarations
+        Main Function
+        Input Files
+        ADC Task
+*******************************************************************************/
+
+#include "sim.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "DAQ.h"
+#include "QRS.h"
+
+#include "tm4c123gh6pm.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/******************************************************************************
+Declarations
+*******************************************************************************/
+
+#define ADC_MAX              0xFFF
+#define DEFAULT_IMAGE_FILE   "sim_lcd.ppm"
+
+int RTOS_main(void);               // `main()` in `main_rtos.c`
+
+/// @brief  Input signal, before resampling.
+typedef struct {
+    double * values;               ///< [mV] or ADC codes
+    uint32_t numValues;
+    double fs;                     ///< sampling rate [Hz]
+    bool isMilliVolts;
+} Signal_t;
+
+static struct {
+    uint16_t * adcSamples;         ///< input, resampled to @ref QRS_SAMP_FREQ and quantized
+    uint32_t numSamples;
+    uint32_t numRepeats;
+    TickType_t ticksPerSample;
+} Sim = { 0 };
+
+static StaticTask_t AdcTaskBuffer;
+static StackType_t AdcStack[configMINIMAL_STACK_SIZE];
+
+static bool readCsv(const char * path, Signal_t * signal);
+static bool readMitBih(const char * path, Signal_t * signal);
+static void quantizeSignal(const Signal_t * signal);
+
+static void AdcTask(void * params);
+static double getTime_sec(void);
+
+/******************************************************************************
+Main Function
+*******************************************************************************/
+
+int main(int argc, char ** argv) {
+    double speed = 1;
+    const char * imageFile = DEFAULT_IMAGE_FILE;
+    Signal_t signal = { .fs = QRS_SAMP_FREQ };
+    Sim.numRepeats = 1;
+
+    int opt;
+    while((opt = getopt(argc, argv, "s:n:o:r:m")) != -1) {
+        switch(opt) {
+            case 's':
+                speed = strtod(optarg, NULL);
+                break;
+            case 'n':
+                Sim.numRepeats = (uint32_t) strtoul(optarg, NULL, 10);
+                break;
+            case 'o':
+                imageFile = optarg;
+                break;
+            case 'r':
+                signal.fs = strtod(optarg, NULL);
+                break;
+            case 'm':
+                signal.isMilliVolts = true;
+                break;
+            default:
+                fprintf(stderr, "Usage: %s [-s speed] [-n repeats] [-o image.ppm] [-r Hz] [-m] "
+                                "<record or .csv>\n",
+                        argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if(optind >= argc) {
+        fprintf(stderr, "No input given.\n");
+        return EXIT_FAILURE;
+    }
+
+    // the interrupt can't be raised more often than once per tick
+    const double maxSpeed = (double) configTICK_RATE_HZ / QRS_SAMP_FREQ;
+    if((speed <= 0) || (speed > maxSpeed) || (signal.fs <= 0) || (Sim.numRepeats == 0)) {
+        fprintf(stderr, "Speed must be in (0, %g], and the rate and repeats must be positive.\n",
+                maxSpeed);
+        return EXIT_FAILURE;
+    }
+    Sim.ticksPerSample = (TickType_t) lround(configTICK_RATE_HZ / (QRS_SAMP_FREQ * speed));
+
+    // load input
+    const char * path = argv[optind];
+    size_t len = strlen(path);
+    bool isCsv = (len > 4) && (strcmp(&path[len - 4], ".csv") == 0);
+    bool isLoaded = (isCsv) ? readCsv(path, &signal) : readMitBih(path, &signal);
+    if((isLoaded == false) || (signal.numValues == 0)) {
+        fprintf(stderr, "Could not read %s\n", path);
+        return EXIT_FAILURE;
+    }
+    quantizeSignal(&signal);
+    free(signal.values);
+
+    // set up the simulated peripherals
+    if(SimLcd_Init(imageFile) == false) {
+        fprintf(stderr, "Could not create %s\n", imageFile);
+        return EXIT_FAILURE;
+    }
+    atexit(SimLcd_Flush);
+    setvbuf(stdout, NULL, _IOLBF, 0);
+
+    xTaskCreateStatic(AdcTask, "ADC (sim)", configMINIMAL_STACK_SIZE, NULL,
+                      configMAX_PRIORITIES - 1, AdcStack, &AdcTaskBuffer);
+
+    printf("sim: %u samples x %u at %gx real time\n", Sim.numSamples, Sim.numRepeats, speed);
+    return RTOS_main();
+}
+
+/******************************************************************************
+Input Files
+*******************************************************************************/
+
+static bool readCsv(const char * path, Signal_t * signal) {
+    FILE * file = fopen(path, "r");
+    if(file == NULL) {
+        return false;
+    }
+
+    uint32_t capacity = 1024;
+    signal->values = malloc(sizeof(double) * capacity);
+    signal->numValues = 0;
+
+    char line[256];
+    while(fgets(line, sizeof(line), file) != NULL) {
+        // rows are either `index,value` or `value`; anything else (e.g. a header) is skipped
+        double index, value;
+        bool hasComma = (strchr(line, ',') != NULL);
+        bool isValid = (hasComma) ? (sscanf(line, "%lf,%lf", &index, &value) == 2)
+                                  : (sscanf(line, "%lf", &value) == 1);
+        if(isValid == false) {
+            continue;
+        }
+
+        if(signal->numValues == capacity) {
+            capacity *= 2;
+            signal->values = realloc(signal->values, sizeof(double) * capacity);
+        }
+        signal->values[signal->numValues++] = value;
+    }
+    fclose(file);
+
+    return true;
+}
+
+static bool readMitBih(const char * path, Signal_t * signal) {
+    /**
+     * This is the same as `readSignal()` in `bench_mitbih.c`. The header's first line is
+     * `<name> <num. signals> <fs> <num. samples>`, and the next line describes the first signal as
+     * `<file> <format> <gain>[(<baseline>)][/mV] <bits> <ADC zero>`. Format 212 packs pairs of
+     * 12-bit samples (from consecutive signals) into 3 bytes.
+     */
+    char fileName[512];
+    snprintf(fileName, sizeof(fileName), "%s.hea", path);
+    FILE * file = fopen(fileName, "r");
+    if(file == NULL) {
+        return false;
+    }
+
+    char line[256];
+    uint32_t numSignals = 0, fs = 0, numFrames = 0;
+    char datName[128] = { 0 };
+    uint32_t format = 0, adcZero = 0;
+    double gain = 0, baseline = 0;
+    bool hasBaseline = false;
+
+    bool isValid = false;
+    while(fgets(line, sizeof(line), file) != NULL) {
+        if(line[0] == '#') {
+            continue;
+        }
+        else if(numSignals == 0) {
+            if(sscanf(line, "%*s %u %u %u", &numSignals, &fs, &numFrames) != 3) {
+                break;
+            }
+        }
+        else {
+            char gainStr[64];
+            if(sscanf(line, "%127s %u %63s %*u %u", datName, &format, gainStr, &adcZero) != 4) {
+                break;
+            }
+            char * end;
+            gain = strtod(gainStr, &end);
+            if(*end == '(') {
+                baseline = strtod(&end[1], NULL);
+                hasBaseline = true;
+            }
+            isValid = true;
+            break;
+        }
+    }
+    fclose(file);
+
+    if((isValid == false) || (format != 212) || (gain <= 0) || (fs == 0)) {
+        fprintf(stderr, "%s: only format 212 records are supported\n", path);
+        return false;
+    }
+    baseline = (hasBaseline) ? baseline : adcZero;
+
+    // read first signal
+    const char * dir = strrchr(path, '/');
+    snprintf(fileName, sizeof(fileName), "%.*s%s", (dir != NULL) ? (int) (dir - path + 1) : 0,
+             path, datName);
+    file = fopen(fileName, "rb");
+    if(file == NULL) {
+        return false;
+    }
+
+    signal->values = malloc(sizeof(double) * numFrames);
+    signal->numValues = 0;
+    signal->fs = fs;
+    signal->isMilliVolts = true;
+
+    uint64_t sampleIdx = 0;
+    uint8_t bytes[3];
+    while((signal->numValues < numFrames) && (fread(bytes, 1, 3, file) == 3)) {
+        int32_t pair[2] = { ((bytes[1] & 0x0F) << 8) | bytes[0],
+                            ((bytes[1] & 0xF0) << 4) | bytes[2] };
+        for(uint8_t k = 0; k < 2; k++, sampleIdx++) {
+            if(((sampleIdx % numSignals) == 0) && (signal->numValues < numFrames)) {
+                int32_t sample = (pair[k] & 0x800) ? (pair[k] - 0x1000) : pair[k];
+                signal->values[signal->numValues++] = (sample - baseline) / gain; // [mV]
+            }
+        }
+    }
+    fclose(file);
+
+    return true;
+}
+
+static void quantizeSignal(const Signal_t * signal) {
+    // resample via linear interpolation, then quantize as the ADC would
+    Sim.numSamples = (uint32_t) (((double) signal->numValues * QRS_SAMP_FREQ) / signal->fs);
+    Sim.numSamples = (Sim.numSamples > 0) ? Sim.numSamples : 1;
+    Sim.adcSamples = malloc(sizeof(uint16_t) * Sim.numSamples);
+
+    for(uint32_t n = 0; n < Sim.numSamples; n++) {
+        double t = (n * signal->fs) / QRS_SAMP_FREQ;
+        uint32_t k = (uint32_t) t;
+        double frac = t - k;
+        double value = (k + 1 < signal->numValues)
+                           ? ((signal->values[k] * (1 - frac)) + (signal->values[k + 1] * frac))
+                           : signal->values[signal->numValues - 1];
+
+        long code = (signal->isMilliVolts)
+                        ? lround(((value - DAQ_LOOKUP_MIN) / (DAQ_LOOKUP_MAX - DAQ_LOOKUP_MIN)) *
+                                 ADC_MAX)
+                        : lround(value);
+        Sim.adcSamples[n] = (uint16_t) ((code < 0) ? 0 : ((code > ADC_MAX) ? ADC_MAX : code));
+    }
+    return;
+}
+
+/******************************************************************************
+ADC Task
+*******************************************************************************/
+
+static void AdcTask(void * params) {
+    const uint64_t totalSamples = (uint64_t) Sim.numSamples * Sim.numRepeats;
+    uint64_t sampleNum = 0;
+    uint32_t maxBurst = 0;
+    uint32_t numMissed = 0;
+
+    double startTime = getTime_sec();
+    TickType_t lastWakeTime = xTaskGetTickCount();
+    TickType_t ticksUntilNext = Sim.ticksPerSample;
+
+    uint32_t burst = 0;
+    while(sampleNum < totalSamples) {
+        /**
+         * If the host was too busy to run this task on time, `xTaskDelayUntil()` returns without
+         * blocking until it has caught up, so the late samples are sent back-to-back (like a DAQ
+         * timer that has kept running). Those make up a burst.
+         */
+        BaseType_t wasDelayed = xTaskDelayUntil(&lastWakeTime, 1);
+        burst = (wasDelayed) ? 0 : burst;
+
+        ticksUntilNext -= 1;
+        if(ticksUntilNext > 0) {
+            continue;
+        }
+        ticksUntilNext = Sim.ticksPerSample;
+
+        Sim_setAdcSample(Sim.adcSamples[sampleNum % Sim.numSamples]);
+        numMissed += (Sim_raiseInterrupt(INT_ADC0SS3)) ? 0 : 1;
+        sampleNum += 1;
+
+        burst += 1;
+        maxBurst = (burst > maxBurst) ? burst : maxBurst;
+    }
+    double time_sec = getTime_sec() - startTime;
+
+    // let the tasks finish with the last samples
+    vTaskDelay(pdMS_TO_TICKS(100));
+
+    double inputTime_sec = (double) totalSamples / QRS_SAMP_FREQ;
+    printf("sim: %llu samples (%.1f s) in %.1f s (%.2fx real time), max. burst %u, %u missed\n",
+           (unsigned long long) totalSamples, inputTime_sec, time_sec, inputTime_sec / time_sec,
+           maxBurst, numMissed);
+    exit((numMissed == 0) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+static double getTime_sec(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double) now.tv_sec + ((double) now.tv_nsec * 1e-9);
+}
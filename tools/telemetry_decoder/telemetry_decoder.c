@@ -0,0 +1,610 @@
+/**
+ * @file
+ * @author  Bryan McElvy
+ * @brief   Host tool that decodes a recording of the telemetry stream into CSV or WFDB files.
+ *
+ * @details The input is the raw byte stream from the UART, e.g. recorded via
+ *          `stty -F /dev/ttyACM0 115200 raw && cat /dev/ttyACM0 > recording.bin`. It is split at
+ *          each zero byte, and each piece is decoded via Telemetry_DecodeFrame(). Pieces that
+ *          aren't valid frames but look like text (i.e. the @ref debug module's output) are
+ *          copied to `stderr`; anything else is counted as a bad frame. Log records (i.e. the
+ *          Debug module's output with `DEBUG_DEFERRED`) are formatted via the message table in
+ *          @ref Debug_msgs.h and also written to `stderr`.
+ *
+ *          The samples of each signal are placed by their sample number, so the signals line up
+ *          even if messages were lost. Missing samples are left empty (CSV) or marked as invalid
+ *          (WFDB).
+ *
+ *          Format | Output
+ *          -------|------------------------------------------------------------------------
+ *          `csv`  | `<record>.csv` with one row per sample, or `stdout` if no record name is given
+ *          `wfdb` | `<record>.hea`/`.dat` (format 16, one signal per stream) and `<record>.qrs`
+ *
+ *          Usage: `telemetry_decoder [-f csv|wfdb] [-o record] [input file]`. The input defaults
+ *          to `stdin`. A summary (incl. lost messages per type) is written to `stderr`.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+/******************************************************************************
+SECTIONS
+        Declarations
+        Main Function
+        Decoding
+        Log Records
+        CSV Output
+        WFDB Output
+*******************************************************************************/
+
+#include "DAQ.h"
+#include "Debug_msgs.h"
+#include "QRS.h"
+#include "Telemetry.h"
+
+#include <ctype.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define ADC_MAX            0xFFF
+#define ADC_BITS           12
+#define ADC_GAIN           (ADC_MAX / (DAQ_LOOKUP_MAX - DAQ_LOOKUP_MIN))   ///< [adu/mV]
+#define ADC_BASELINE       ((ADC_MAX + 1) / 2)                             ///< ADC code for 0 [mV]
+#define FILTERED_GAIN      1000                                            ///< [adu/mV], i.e. [uV]
+#define WFDB_MAX_VALUE     30000                                           ///< integrated signal
+#define WFDB_INVALID       (-32768)
+#define MAX_CHUNK_SIZE     1024                                            ///< longer = bad frame
+
+/******************************************************************************
+Declarations
+*******************************************************************************/
+
+enum SIGNALS {
+    SIGNAL_RAW,
+    SIGNAL_FILTERED,
+    SIGNAL_INTEGRATED,
+    NUM_SIGNALS
+};
+
+static const char * const SIGNAL_NAMES[NUM_SIGNALS] = { "raw", "filtered_mV", "integrated" };
+
+/// @brief  Everything decoded from a recording.
+typedef struct {
+    double * signals[NUM_SIGNALS];                      ///< by sample num.; `NAN` if missing
+    double * heartRates;                                ///< by sample num.; `NAN` if not updated
+    bool * isBeat;                                      ///< by sample num.
+    uint32_t numSamples;                                ///< highest sample num. + 1
+    uint32_t capacity;
+
+    uint32_t numMsgs[TELEMETRY_NUM_MSG_TYPES + 1];      ///< num. of valid messages, by type
+    uint32_t numLost[TELEMETRY_NUM_MSG_TYPES + 1];      ///< num. of skipped seq. nums., by type
+    uint16_t nextSeq[TELEMETRY_NUM_MSG_TYPES + 1];      ///< expected seq. num., by type
+    uint32_t numLogRecords;
+    uint32_t numBadFrames;
+    uint32_t numTextBytes;
+} Recording_t;
+
+static void decodeStream(FILE * input, Recording_t * recording);
+static void handleChunk(const uint8_t chunk[], uint16_t chunkSize, bool isComplete,
+                        Recording_t * recording);
+static bool handleMsg(const uint8_t msg[], uint16_t msgSize, Recording_t * recording);
+static bool printLogRecord(const uint8_t record[], uint16_t recordSize);
+static void reserveSamples(Recording_t * recording, uint32_t numSamples);
+static uint32_t readLittleEndian(const uint8_t bytes[], uint8_t N);
+static float bitsToFloat(uint32_t bits);
+static void freeRecording(Recording_t * recording);
+
+static bool writeCsv(const char * name, const Recording_t * recording);
+
+static bool writeWfdb(const char * name, const Recording_t * recording);
+static bool writeAnnotations(const char * name, const Recording_t * recording);
+static void writeWord(FILE * file, uint16_t word);
+
+/******************************************************************************
+Main Function
+*******************************************************************************/
+
+int main(int argc, char ** argv) {
+    const char * format = "csv";
+    const char * name = NULL;
+
+    int opt;
+    while((opt = getopt(argc, argv, "f:o:")) != -1) {
+        switch(opt) {
+            case 'f':
+                format = optarg;
+                break;
+            case 'o':
+                name = optarg;
+                break;
+            default:
+                fprintf(stderr, "Usage: %s [-f csv|wfdb] [-o record] [input file]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    bool isCsv = (strcmp(format, "csv") == 0);
+    if((isCsv == false) && ((strcmp(format, "wfdb") != 0) || (name == NULL))) {
+        fprintf(stderr, "The format must be `csv` or `wfdb`, and `wfdb` needs a record name.\n");
+        return EXIT_FAILURE;
+    }
+
+    FILE * input = stdin;
+    if(optind < argc) {
+        input = fopen(argv[optind], "rb");
+        if(input == NULL) {
+            fprintf(stderr, "Could not open %s\n", argv[optind]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    Recording_t recording = { 0 };
+    decodeStream(input, &recording);
+    if(input != stdin) {
+        fclose(input);
+    }
+
+    // summary
+    static const char * const MSG_NAMES[TELEMETRY_NUM_MSG_TYPES + 1] = {
+        "", "raw", "filtered", "integrated", "beat", "heart rate"
+    };
+    fprintf(stderr, "\n%-12s%10s%10s\n", "message", "received", "lost");
+    for(uint8_t type = 1; type <= TELEMETRY_NUM_MSG_TYPES; type++) {
+        fprintf(stderr, "%-12s%10u%10u\n", MSG_NAMES[type], recording.numMsgs[type],
+                recording.numLost[type]);
+    }
+    fprintf(stderr, "%u samples, %u log records, %u bad frames, %u bytes of text\n",
+            recording.numSamples, recording.numLogRecords, recording.numBadFrames,
+            recording.numTextBytes);
+
+    bool isWritten = (isCsv) ? writeCsv(name, &recording) : writeWfdb(name, &recording);
+    freeRecording(&recording);
+    if(isWritten == false) {
+        fprintf(stderr, "Could not write the output file(s).\n");
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/******************************************************************************
+Decoding
+*******************************************************************************/
+
+static void decodeStream(FILE * input, Recording_t * recording) {
+    uint8_t chunk[MAX_CHUNK_SIZE];
+    uint16_t chunkSize = 0;
+    bool isOverlong = false;
+
+    int byte;
+    while((byte = fgetc(input)) != EOF) {
+        if(byte != 0) {
+            if(chunkSize < sizeof(chunk)) {
+                chunk[chunkSize++] = (uint8_t) byte;
+            }
+            else {
+                isOverlong = true;
+            }
+        }
+        else {
+            if(isOverlong) {
+                recording->numBadFrames += 1;
+            }
+            else if(chunkSize > 0) {
+                handleChunk(chunk, chunkSize, true, recording);
+            }
+            chunkSize = 0;
+            isOverlong = false;
+        }
+    }
+
+    // a frame that was cut off at the end of the recording is ignored, but text isn't
+    if((chunkSize > 0) && (isOverlong == false)) {
+        handleChunk(chunk, chunkSize, false, recording);
+    }
+    return;
+}
+
+static void handleChunk(const uint8_t chunk[], uint16_t chunkSize, bool isComplete,
+                        Recording_t * recording) {
+    uint8_t msg[MAX_CHUNK_SIZE];
+    uint16_t msgSize;
+    if(Telemetry_DecodeFrame(chunk, chunkSize, msg, &msgSize)) {
+        if(handleMsg(msg, msgSize, recording)) {
+            return;
+        }
+    }
+
+    bool isText = true;
+    for(uint16_t idx = 0; (idx < chunkSize) && isText; idx++) {
+        isText = isprint(chunk[idx]) || (chunk[idx] == '\r') || (chunk[idx] == '\n');
+    }
+
+    if(isText) {
+        fwrite(chunk, 1, chunkSize, stderr);
+        recording->numTextBytes += chunkSize;
+    }
+    else if(isComplete) {
+        recording->numBadFrames += 1;
+    }
+    return;
+}
+
+/// @brief  Store the contents of a message. Returns `false` if its type or size is invalid.
+static bool handleMsg(const uint8_t msg[], uint16_t msgSize, Recording_t * recording) {
+    if(msg[0] & TELEMETRY_LOG_FLAG) {
+        bool isValid = printLogRecord(msg, msgSize);
+        recording->numLogRecords += isValid ? 1 : 0;
+        return isValid;
+    }
+
+    uint8_t type = msg[0];
+    uint16_t seq = (uint16_t) readLittleEndian(&msg[1], 2);
+    const uint8_t * body = &msg[TELEMETRY_HEADER_SIZE];
+    uint16_t bodySize = msgSize - TELEMETRY_HEADER_SIZE;
+
+    switch(type) {
+        case TELEMETRY_MSG_RAW:
+        case TELEMETRY_MSG_FILTERED:
+        case TELEMETRY_MSG_INTEGRATED: {
+            if(bodySize < TELEMETRY_SAMPLE_HEADER_SIZE) {
+                return false;
+            }
+            uint32_t firstSampleNum = readLittleEndian(&body[0], 4);
+            uint8_t count = body[4];
+            uint8_t sampleSize = (type == TELEMETRY_MSG_RAW) ? sizeof(uint16_t) : sizeof(float);
+            if(bodySize != (TELEMETRY_SAMPLE_HEADER_SIZE + (count * sampleSize))) {
+                return false;
+            }
+
+            reserveSamples(recording, firstSampleNum + count);
+            double * signal = recording->signals[type - TELEMETRY_MSG_RAW];
+            for(uint8_t idx = 0; idx < count; idx++) {
+                uint32_t bits = readLittleEndian(&body[5 + (idx * sampleSize)], sampleSize);
+                signal[firstSampleNum + idx] =
+                    (type == TELEMETRY_MSG_RAW) ? (double) bits : (double) bitsToFloat(bits);
+            }
+            break;
+        }
+        case TELEMETRY_MSG_BEAT: {
+            if(bodySize != 4) {
+                return false;
+            }
+            uint32_t sampleNum = readLittleEndian(&body[0], 4);
+            reserveSamples(recording, sampleNum + 1);
+            recording->isBeat[sampleNum] = true;
+            break;
+        }
+        case TELEMETRY_MSG_HEART_RATE: {
+            if(bodySize != 8) {
+                return false;
+            }
+            uint32_t sampleNum = readLittleEndian(&body[0], 4);
+            reserveSamples(recording, sampleNum + 1);
+            recording->heartRates[sampleNum] = bitsToFloat(readLittleEndian(&body[4], 4));
+            break;
+        }
+        default:
+            return false;
+    }
+
+    // the first message of each type sets the expected seq. num.
+    if(recording->numMsgs[type] > 0) {
+        recording->numLost[type] += (uint16_t) (seq - recording->nextSeq[type]);
+    }
+    recording->nextSeq[type] = seq + 1;
+    recording->numMsgs[type] += 1;
+    return true;
+}
+
+static void reserveSamples(Recording_t * recording, uint32_t numSamples) {
+    if(numSamples > recording->capacity) {
+        uint32_t capacity = (recording->capacity > 0) ? recording->capacity : 1024;
+        while(capacity < numSamples) {
+            capacity *= 2;
+        }
+
+        for(uint8_t sig = 0; sig < NUM_SIGNALS; sig++) {
+            recording->signals[sig] = realloc(recording->signals[sig], sizeof(double) * capacity);
+        }
+        recording->heartRates = realloc(recording->heartRates, sizeof(double) * capacity);
+        recording->isBeat = realloc(recording->isBeat, sizeof(bool) * capacity);
+
+        for(uint32_t n = recording->capacity; n < capacity; n++) {
+            for(uint8_t sig = 0; sig < NUM_SIGNALS; sig++) {
+                recording->signals[sig][n] = NAN;
+            }
+            recording->heartRates[n] = NAN;
+            recording->isBeat[n] = false;
+        }
+        recording->capacity = capacity;
+    }
+
+    if(numSamples > recording->numSamples) {
+        recording->numSamples = numSamples;
+    }
+    return;
+}
+
+static uint32_t readLittleEndian(const uint8_t bytes[], uint8_t N) {
+    uint32_t value = 0;
+    for(uint8_t idx = 0; idx < N; idx++) {
+        value |= (uint32_t) bytes[idx] << (8 * idx);
+    }
+    return value;
+}
+
+static float bitsToFloat(uint32_t bits) {
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static void freeRecording(Recording_t * recording) {
+    for(uint8_t sig = 0; sig < NUM_SIGNALS; sig++) {
+        free(recording->signals[sig]);
+    }
+    free(recording->heartRates);
+    free(recording->isBeat);
+    return;
+}
+
+/******************************************************************************
+Log Records
+*******************************************************************************/
+
+#define DEBUG_MSG_ENTRY(id, argTypes, format) { argTypes, format },
+
+static const struct {
+    const char * argTypes;
+    const char * format;
+} LOG_MSGS[] = { DEBUG_MSG_TABLE(DEBUG_MSG_ENTRY) };
+
+#define NUM_LOG_MSGS       (sizeof(LOG_MSGS) / sizeof(LOG_MSGS[0]))
+
+/**
+ * @brief   Format a log record and write it to `stderr`.
+ *
+ * @details Each conversion in the message's format string is passed to `snprintf()` on its own,
+ *          along with the next argument from the record. Returns `false` (without writing
+ *          anything) if the ID is unknown or the arguments don't match the message.
+ */
+static bool printLogRecord(const uint8_t record[], uint16_t recordSize) {
+    uint8_t msgId = record[0] & ~TELEMETRY_LOG_FLAG;
+    if(msgId >= NUM_LOG_MSGS) {
+        return false;
+    }
+
+    const char * argTypes = LOG_MSGS[msgId].argTypes;
+    const char * format = LOG_MSGS[msgId].format;
+
+    char text[512] = "";
+    size_t length = 0;
+    uint16_t idx = 1;
+    while((*format != '\0') && (length < (sizeof(text) - 1))) {
+        if((format[0] != '%') || (format[1] == '%')) {
+            text[length++] = *format;
+            format += (format[0] == '%') ? 2 : 1;
+            continue;
+        }
+
+        // copy the conversion (e.g. `%.1f`) so it can be used with a single argument
+        char spec[16];
+        size_t specLength = strcspn(format + 1, "sudf") + 2;
+        if((specLength >= sizeof(spec)) || (*argTypes == '\0')) {
+            return false;
+        }
+        memcpy(spec, format, specLength);
+        spec[specLength] = '\0';
+        format += specLength;
+
+        char * output = &text[length];
+        size_t outputSize = sizeof(text) - length;
+        switch(*argTypes++) {
+            case 's': {
+                uint8_t strLength = (idx < recordSize) ? record[idx] : 0;
+                if((idx + 1 + strLength) > recordSize) {
+                    return false;
+                }
+                char str[256];
+                memcpy(str, &record[idx + 1], strLength);
+                str[strLength] = '\0';
+                snprintf(output, outputSize, spec, str);
+                idx += 1 + strLength;
+                break;
+            }
+            case 'u':
+                if((idx + 4) > recordSize) {
+                    return false;
+                }
+                snprintf(output, outputSize, spec, readLittleEndian(&record[idx], 4));
+                idx += 4;
+                break;
+            case 'f':
+                if((idx + 4) > recordSize) {
+                    return false;
+                }
+                snprintf(output, outputSize, spec, bitsToFloat(readLittleEndian(&record[idx], 4)));
+                idx += 4;
+                break;
+            default:
+                return false;
+        }
+        length += strlen(output);
+    }
+
+    if((*argTypes != '\0') || (idx != recordSize)) {
+        return false;
+    }
+
+    text[length] = '\0';
+    fputs(text, stderr);
+    return true;
+}
+
+/******************************************************************************
+CSV Output
+*******************************************************************************/
+
+static bool writeCsv(const char * name, const Recording_t * recording) {
+    FILE * file = stdout;
+    if(name != NULL) {
+        char fileName[512];
+        snprintf(fileName, sizeof(fileName), "%s.csv", name);
+        file = fopen(fileName, "w");
+        if(file == NULL) {
+            return false;
+        }
+    }
+
+    fprintf(file, "sample,%s,%s,%s,beat,heart_rate_bpm\n", SIGNAL_NAMES[SIGNAL_RAW],
+            SIGNAL_NAMES[SIGNAL_FILTERED], SIGNAL_NAMES[SIGNAL_INTEGRATED]);
+
+    for(uint32_t n = 0; n < recording->numSamples; n++) {
+        fprintf(file, "%u", n);
+        for(uint8_t sig = 0; sig < NUM_SIGNALS; sig++) {
+            double value = recording->signals[sig][n];
+            if(isnan(value)) {
+                fprintf(file, ",");
+            }
+            else {
+                fprintf(file, (sig == SIGNAL_RAW) ? ",%.0f" : ",%.6g", value);
+            }
+        }
+
+        fprintf(file, ",%d", recording->isBeat[n] ? 1 : 0);
+        if(isnan(recording->heartRates[n])) {
+            fprintf(file, ",\n");
+        }
+        else {
+            fprintf(file, ",%.1f\n", recording->heartRates[n]);
+        }
+    }
+
+    if(file != stdout) {
+        fclose(file);
+    }
+    return true;
+}
+
+/******************************************************************************
+WFDB Output
+*******************************************************************************/
+
+static bool writeWfdb(const char * name, const Recording_t * recording) {
+    /**
+     * Each sample is stored as a 16-bit integer (format 16), i.e. `baseline + (value * gain)`.
+     * The raw signal keeps its ADC codes, the filtered signal is stored in [uV], and the
+     * integrated signal (which has no physical unit) is scaled by the power of 10 that uses most
+     * of the 16-bit range.
+     */
+    double maxIntegrated = 0;
+    for(uint32_t n = 0; n < recording->numSamples; n++) {
+        double value = fabs(recording->signals[SIGNAL_INTEGRATED][n]);
+        maxIntegrated = (value > maxIntegrated) ? value : maxIntegrated;
+    }
+
+    const double gains[NUM_SIGNALS] = {
+        1, FILTERED_GAIN,
+        (maxIntegrated > 0) ? pow(10, floor(log10(WFDB_MAX_VALUE / maxIntegrated))) : 1
+    };
+
+    char fileName[512];
+    snprintf(fileName, sizeof(fileName), "%s.dat", name);
+    FILE * file = fopen(fileName, "wb");
+    if(file == NULL) {
+        return false;
+    }
+
+    int16_t firstValues[NUM_SIGNALS] = { 0 };
+    uint16_t checksums[NUM_SIGNALS] = { 0 };
+    for(uint32_t n = 0; n < recording->numSamples; n++) {
+        for(uint8_t sig = 0; sig < NUM_SIGNALS; sig++) {
+            double value = recording->signals[sig][n];
+            int32_t stored = WFDB_INVALID;
+            if(isnan(value) == false) {
+                stored = (int32_t) lround(value * gains[sig]);
+                stored = (stored < (WFDB_INVALID + 1)) ? (WFDB_INVALID + 1) : stored;
+                stored = (stored > INT16_MAX) ? INT16_MAX : stored;
+            }
+
+            if(n == 0) {
+                firstValues[sig] = (int16_t) stored;
+            }
+            checksums[sig] += (uint16_t) stored;
+            writeWord(file, (uint16_t) stored);
+        }
+    }
+    fclose(file);
+
+    // the raw signal's gain converts ADC codes to [mV]
+    snprintf(fileName, sizeof(fileName), "%s.hea", name);
+    file = fopen(fileName, "w");
+    if(file == NULL) {
+        return false;
+    }
+
+    const char * baseName = strrchr(name, '/');
+    baseName = (baseName != NULL) ? (baseName + 1) : name;
+    fprintf(file, "%s %d %u %u\n", baseName, NUM_SIGNALS, QRS_SAMP_FREQ, recording->numSamples);
+    fprintf(file, "%s.dat 16 %.4f(%d)/mV %d %d %d %d 0 %s\n", baseName, ADC_GAIN, ADC_BASELINE,
+            ADC_BITS, ADC_BASELINE, firstValues[SIGNAL_RAW], (int16_t) checksums[SIGNAL_RAW],
+            SIGNAL_NAMES[SIGNAL_RAW]);
+    fprintf(file, "%s.dat 16 %d(0)/mV 16 0 %d %d 0 %s\n", baseName, FILTERED_GAIN,
+            firstValues[SIGNAL_FILTERED], (int16_t) checksums[SIGNAL_FILTERED],
+            SIGNAL_NAMES[SIGNAL_FILTERED]);
+    fprintf(file, "%s.dat 16 %g(0)/NU 16 0 %d %d 0 %s\n", baseName, gains[SIGNAL_INTEGRATED],
+            firstValues[SIGNAL_INTEGRATED], (int16_t) checksums[SIGNAL_INTEGRATED],
+            SIGNAL_NAMES[SIGNAL_INTEGRATED]);
+    fprintf(file, "# beats (in the integrated signal) are in %s.qrs\n", baseName);
+    fclose(file);
+
+    return writeAnnotations(name, recording);
+}
+
+static bool writeAnnotations(const char * name, const Recording_t * recording) {
+    /**
+     * Same format as the `.atr` files read by `bench_mitbih`: each annotation is a 16-bit word
+     * with a 6-bit code and a 10-bit time difference. Longer differences need a `SKIP` first.
+     */
+    enum { NORMAL = 1, SKIP = 59, MAX_DIFF = 0x3FF };
+
+    char fileName[512];
+    snprintf(fileName, sizeof(fileName), "%s.qrs", name);
+    FILE * file = fopen(fileName, "wb");
+    if(file == NULL) {
+        return false;
+    }
+
+    uint32_t prevSampleNum = 0;
+    for(uint32_t n = 0; n < recording->numSamples; n++) {
+        if(recording->isBeat[n] == false) {
+            continue;
+        }
+
+        uint32_t diff = n - prevSampleNum;
+        if(diff > MAX_DIFF) {
+            // PDP-11 long: high word first
+            writeWord(file, SKIP << 10);
+            writeWord(file, (uint16_t) (diff >> 16));
+            writeWord(file, (uint16_t) diff);
+            diff = 0;
+        }
+        writeWord(file, (uint16_t) ((NORMAL << 10) | diff));
+        prevSampleNum = n;
+    }
+    writeWord(file, 0);               // end of file
+    fclose(file);
+
+    return true;
+}
+
+static void writeWord(FILE * file, uint16_t word) {
+    uint8_t bytes[2] = { (uint8_t) word, (uint8_t) (word >> 8) };
+    fwrite(bytes, 1, sizeof(bytes), file);
+    return;
+}